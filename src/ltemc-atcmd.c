@@ -27,6 +27,7 @@
 
 #define SRCFILE "ATC"                           // create SRCFILE (3 char) MACRO for lq-diagnostics ASSERT
 #include <stdarg.h>
+#include <inttypes.h>
 #include "ltemc-internal.h"
 
 #define _DEBUG 0                                // set to non-zero value for PRINTF debugging output, 
@@ -46,16 +47,72 @@
 
 #define MIN(x, y) (((x) < (y)) ? (x) : (y))
 #define MAX(X, Y) (((X) > (Y)) ? (X) : (Y))
-extern ltemDevice_t g_lqLTEM;
-
 
 
 /* Static Function Declarations
 ------------------------------------------------------------------------------------------------- */
 static resultCode_t S__readResult();
+static void S__scanFinalResult(uint16_t scanFrom);
+static uint16_t S__dataModeTriggerPartial();
+static cmdParseRslt_t S__streamLines();
+static void S__recordMetrics();
+static bool S__tryInvokeV(const char *cmdTemplate, va_list ap, bool isDescriptor);
+static bool S__tryLock();
+static void S__invokeReuseLockV(const char *cmdTemplate, va_list ap, bool isDescriptor);
+static uint16_t S__buildCmdStr(char *cmdStr, uint16_t cmdStrSz, const char *cmdTemplate, va_list ap, bool isDescriptor);
+static uint16_t S__formatCmd(char *dest, uint16_t destSz, const char *cmdTemplate, va_list ap);
+static void S__invokeQueued();
+static void S__chainTx(const char *data, uint16_t dataSz);
+static bool S__takeResultLine(const char *phrase);
+static void S__batchAddV(atcmdBatch_t *batch, uint8_t keyParams, const char *cmdTemplate, va_list ap);
+static void S__batchSend(atcmdBatch_t *batch);
+static char *S__batchSplitCmd(char *cmd);
+static resultCode_t S__applySettingV(bool reuseLock, uint8_t keyParams, const char *cmdTemplate, va_list ap);
+static uint16_t S__settingKeySz(const char *setting, uint16_t settingSz, uint8_t keyParams);
+static void S__shadowSetting(const char *setting, uint8_t keyParams, bool applied);
+static uint16_t S__retryCode(resultCode_t rslt);
+static uint16_t S__retryJitter(uint16_t range);
 static void S__rxParseForUrc();
 
 
+/* Command descriptor templates, indexed by atcmdCmd_t
+ */
+static const char * const s_atcmdTemplates[atcmdCmd_cnt] =
+{
+    "AT+QIRD=" ATCMD_INT "," ATCMD_INT,                                         // atcmdCmd_qird
+    "AT+QSSLRECV=" ATCMD_INT "," ATCMD_INT,                                     // atcmdCmd_qsslrecv
+    "AT+QISEND=" ATCMD_INT "," ATCMD_INT,                                       // atcmdCmd_qisend
+    "AT+QMTPUB=" ATCMD_INT "," ATCMD_INT "," ATCMD_INT ",0,\"" ATCMD_STR "\"," ATCMD_INT,   // atcmdCmd_qmtpub
+    "AT+QHTTPREAD=" ATCMD_INT,                                                  // atcmdCmd_qhttpread
+    "AT+QFREAD=" ATCMD_INT "," ATCMD_INT,                                       // atcmdCmd_qfread
+    "AT+QFWRITE=" ATCMD_INT "," ATCMD_INT,                                      // atcmdCmd_qfwrite
+    "AT+QFSEEK=" ATCMD_INT "," ATCMD_INT "," ATCMD_INT,                         // atcmdCmd_qfseek
+    "AT+QFCLOSE=" ATCMD_INT                                                     // atcmdCmd_qfclose
+};
+
+
+/* Verbs with individual metrics, indexed by atcmdVerb_t
+ */
+static const char * const s_atcmdVerbs[atcmdVerb_cnt] =
+{
+    "", "QIOPEN", "QICLOSE", "QISEND", "QIRD", "QSSLOPEN", "QSSLSEND", "QSSLRECV", 
+    "QMTOPEN", "QMTCONN", "QMTSUB", "QMTPUB", "QHTTPURL", "QHTTPGET", "QHTTPPOST", "QHTTPREAD"
+};
+
+
+/* Default retry policies, indexed by atcmdRetryClass_t. Copied to each device by ATCMD_create(), replaced by the application 
+ * with atcmd_setRetryPolicy().
+ */
+static const atcmdRetryPolicy_t s_retryPolicyDefaults[atcmdRetryClass_cnt] =
+{
+    { 1, 0, 0, 0, 0, { 0 } },                                                    // none
+    { 4, 2000, 16000, PERIOD_FROM_SECONDS(90), 2, { 3, 4 } },                   // attach: CME 3/4 (operation not allowed/supported) while attaching
+    { 3, 1000, 8000, PERIOD_FROM_SECONDS(120), 3, { 563, 565, 566 } },          // scktOpen: socket id in use, DNS parse, connect failed
+    { 4, 250, 2000, PERIOD_FROM_SECONDS(10), 1, { resultCode__tooManyRequests } },   // scktSend: SEND FAIL (BGx send buffer full)
+    { 3, 2000, 16000, PERIOD_FROM_SECONDS(150), 2, { 2, 3 } }                   // mqttOpen: failed to open network, failed to activate PDP
+};
+
+
 #pragma region Public Functions
 /*-----------------------------------------------------------------------------------------------*/
 
@@ -64,32 +121,39 @@ static void S__rxParseForUrc();
  */
 void atcmd_reset(bool releaseLock)
 {
-    /* clearing req/resp buffers now for debug clarity, future likely just insert '\0' */
+    /* buffers are cleared by terminating at [0], writers (invoke/response pop/error capture) maintain the terminator */
 
    // dataMode is not reset/cleared here, static S__resetDataMode is invoked after result
  
     // request side of action
     if (releaseLock)
-        g_lqLTEM.atcmd->isOpenLocked = false;                       // reset current lock
-
-    memset(g_lqLTEM.atcmd->cmdStr, 0, atcmd__cmdBufferSz);
-    memset(g_lqLTEM.atcmd->rawResponse, 0, atcmd__respBufferSz);
-    memset(g_lqLTEM.atcmd->errorDetail, 0, ltem__errorDetailSz);
-    g_lqLTEM.atcmd->resultCode = 0;
-    g_lqLTEM.atcmd->invokedAt = 0;
-    g_lqLTEM.atcmd->retValue = 0;
-    g_lqLTEM.atcmd->execDuration = 0;
-
-    // command side
-    g_lqLTEM.iop->txBffr = &g_lqLTEM.atcmd->cmdStr;                 // IOP pointer to current "talker"
-    g_lqLTEM.iop->txPending = 0;
+        g_lqLTEM->atcmd->isOpenLocked = false;                       // reset current lock
+
+    g_lqLTEM->atcmd->cmdStr[0] = '\0';
+    g_lqLTEM->atcmd->rawResponse[0] = '\0';
+    g_lqLTEM->atcmd->rawResponseLen = 0;
+    g_lqLTEM->atcmd->parseIndx = 0;
+    memset(g_lqLTEM->atcmd->finalMatchLen, 0, sizeof(g_lqLTEM->atcmd->finalMatchLen));
+    g_lqLTEM->atcmd->finalRslt = atcmdFinalRslt_none;
+    g_lqLTEM->atcmd->finalRsltAt = 0;
+    g_lqLTEM->atcmd->preambleFound = false;
+    g_lqLTEM->atcmd->errorDetail[0] = '\0';
+    g_lqLTEM->atcmd->resultCode = 0;
+    g_lqLTEM->atcmd->invokedAt = 0;
+    g_lqLTEM->atcmd->retValue = 0;
+    g_lqLTEM->atcmd->execDuration = 0;
 
     // response side
-    g_lqLTEM.atcmd->response = g_lqLTEM.atcmd->rawResponse;         // reset data component of response to full-response
+    g_lqLTEM->atcmd->response = g_lqLTEM->atcmd->rawResponse;         // reset data component of response to full-response
+
+    g_lqLTEM->atcmd->lineRecvCB = NULL;
+    g_lqLTEM->atcmd->lineCntxt = NULL;
+    g_lqLTEM->atcmd->lineScanIndx = 0;
+    g_lqLTEM->atcmd->lineContinues = false;
 
     // restore defaults
-    g_lqLTEM.atcmd->timeout = atcmd__defaultTimeout;
-    g_lqLTEM.atcmd->responseParserFunc = ATCMD_okResponseParser;
+    g_lqLTEM->atcmd->timeout = atcmd__defaultTimeout;
+    g_lqLTEM->atcmd->responseParserFunc = ATCMD_okResponseParser;
 }
 
 
@@ -101,21 +165,31 @@ void atcmd_configDataMode(uint16_t contextKey, const char* trigger, dataRxHndlr_
     ASSERT(strlen(trigger) > 0);                                        // verify 3rd party setup (stream)
     ASSERT(rxDataHndlr != NULL);                                          // 
 
-    memset(&g_lqLTEM.atcmd->dataMode, 0, sizeof(dataMode_t));
+    memset(&g_lqLTEM->atcmd->dataMode, 0, sizeof(dataMode_t));
 
-    g_lqLTEM.atcmd->dataMode.contextKey = contextKey;
-    memcpy(g_lqLTEM.atcmd->dataMode.trigger, trigger, strlen(trigger));
-    g_lqLTEM.atcmd->dataMode.dataHndlr = rxDataHndlr;
-    g_lqLTEM.atcmd->dataMode.txDataLoc = dataLoc;
-    g_lqLTEM.atcmd->dataMode.txDataSz = dataSz;
-    g_lqLTEM.atcmd->dataMode.applRecvDataCB = applRecvDataCB;
-    g_lqLTEM.atcmd->dataMode.skipParser = skipParser;
+    g_lqLTEM->atcmd->dataMode.contextKey = contextKey;
+    memcpy(g_lqLTEM->atcmd->dataMode.trigger, trigger, strlen(trigger));
+    g_lqLTEM->atcmd->dataMode.dataHndlr = rxDataHndlr;
+    g_lqLTEM->atcmd->dataMode.txDataLoc = dataLoc;
+    g_lqLTEM->atcmd->dataMode.txDataSz = dataSz;
+    g_lqLTEM->atcmd->dataMode.applRecvDataCB = applRecvDataCB;
+    g_lqLTEM->atcmd->dataMode.skipParser = skipParser;
 }
 
 
 void atcmd_configDataModeEot(uint8_t eotChar)
 {
-    g_lqLTEM.iop->txEot = (char)eotChar;
+    g_lqLTEM->iop->txEot = (char)eotChar;
+}
+
+
+/**
+ *	@brief Set a block sent ahead of the dataMode TX data, set following atcmd_configDataMode().
+ */
+void atcmd_configDataModePrefix(const char *prefix, uint16_t prefixSz)
+{
+    g_lqLTEM->atcmd->dataMode.txPrefixLoc = prefix;
+    g_lqLTEM->atcmd->dataMode.txPrefixSz = (prefix != NULL) ? prefixSz : 0;
 }
 
 
@@ -124,29 +198,44 @@ void atcmd_configDataModeEot(uint8_t eotChar)
  */
 bool atcmd_tryInvoke(const char *cmdTemplate, ...)
 {
-    if (g_lqLTEM.atcmd->isOpenLocked)
-        return false;
+    va_list ap;
+
+    va_start(ap, cmdTemplate);
+    bool invoked = S__tryInvokeV(cmdTemplate, ap, false);
+    va_end(ap);
+    return invoked;
+}
 
-    atcmd_reset(true);                                                  // clear atCmd control
-    g_lqLTEM.atcmd->autoLock = atcmd__setLockModeAuto;                  // set automatic lock control mode
 
-    //char *cmdStr = g_lqLTEM.atcmd->cmdStr;
+/**
+ *	@brief Invokes a precompiled (descriptor) BGx AT command using default option values (automatic locking).
+ */
+bool atcmd_tryInvokeCmd(atcmdCmd_t cmd, ...)
+{
+    ASSERT(cmd < atcmdCmd_cnt);
     va_list ap;
 
-    va_start(ap, cmdTemplate);
-    vsnprintf(g_lqLTEM.atcmd->cmdStr, sizeof(g_lqLTEM.atcmd->cmdStr), cmdTemplate, ap);
-    strcat(g_lqLTEM.atcmd->cmdStr, "\r");
+    va_start(ap, cmd);
+    bool invoked = S__tryInvokeV(s_atcmdTemplates[cmd], ap, true);
+    va_end(ap);
+    return invoked;
+}
 
-    if (!ATCMD_awaitLock(g_lqLTEM.atcmd->timeout))          // attempt to acquire new atCmd lock for this instance
-        return false;
 
-    g_lqLTEM.atcmd->invokedAt = pMillis();
+/**
+ *	@brief Invokes a BGx AT command (automatic locking) and returns without waiting, completion is checked with atcmd_poll().
+ */
+bool atcmd_invokeAsync(uint32_t timeoutMS, cmdResponseParser_func cmdResponseParser, const char *cmdTemplate, ...)
+{
+    va_list ap;
 
-    // TEMPORARY
-    memcpy(g_lqLTEM.atcmd->CMDMIRROR, g_lqLTEM.atcmd->cmdStr, strlen(g_lqLTEM.atcmd->cmdStr));
+    va_start(ap, cmdTemplate);
+    bool invoked = S__tryInvokeV(cmdTemplate, ap, false);
+    va_end(ap);
 
-    IOP_startTx(g_lqLTEM.atcmd->cmdStr, strlen(g_lqLTEM.atcmd->cmdStr));
-    return true;
+    if (invoked)
+        atcmd_setOptions(timeoutMS, cmdResponseParser);
+    return invoked;
 }
 
 
@@ -155,24 +244,25 @@ bool atcmd_tryInvoke(const char *cmdTemplate, ...)
  */
 void atcmd_invokeReuseLock(const char *cmdTemplate, ...)
 {
-    ASSERT(g_lqLTEM.atcmd->isOpenLocked);    // function assumes re-use of existing lock
-
-    atcmd_reset(false);                                                         // clear out properties WITHOUT lock release
-    g_lqLTEM.atcmd->autoLock = atcmd__setLockModeManual;
-
-    char *cmdStr = g_lqLTEM.atcmd->cmdStr;
     va_list ap;
 
     va_start(ap, cmdTemplate);
-    vsnprintf(cmdStr, sizeof(g_lqLTEM.atcmd->cmdStr), cmdTemplate, ap);
-    strcat(g_lqLTEM.atcmd->cmdStr, "\r");
+    S__invokeReuseLockV(cmdTemplate, ap, false);
+    va_end(ap);
+}
 
-    g_lqLTEM.atcmd->invokedAt = pMillis();
 
-    // TEMPORARY
-    memcpy(g_lqLTEM.atcmd->CMDMIRROR, g_lqLTEM.atcmd->cmdStr, atcmd__cmdBufferSz);
+/**
+ *	@brief Invokes a precompiled (descriptor) BGx AT command without acquiring a lock, using previously set setOptions() values.
+ */
+void atcmd_invokeReuseLockCmd(atcmdCmd_t cmd, ...)
+{
+    ASSERT(cmd < atcmdCmd_cnt);
+    va_list ap;
 
-    IOP_startTx(g_lqLTEM.atcmd->cmdStr, strlen(g_lqLTEM.atcmd->cmdStr));
+    va_start(ap, cmd);
+    S__invokeReuseLockV(s_atcmdTemplates[cmd], ap, true);
+    va_end(ap);
 }
 
 
@@ -181,8 +271,209 @@ void atcmd_invokeReuseLock(const char *cmdTemplate, ...)
  */
 void atcmd_close()
 {
-    g_lqLTEM.atcmd->isOpenLocked = false;
-    g_lqLTEM.atcmd->execDuration = pMillis() - g_lqLTEM.atcmd->invokedAt;
+    g_lqLTEM->atcmd->isOpenLocked = false;
+    g_lqLTEM->atcmd->execDuration = pMillis() - g_lqLTEM->atcmd->invokedAt;
+}
+
+
+/**
+ *	@brief Queues a BGx AT command for pipelined execution.
+ */
+void atcmd_enqueue(cmdResponseParser_func responseParser, uint32_t timeoutMS, atcmdCompletion_func completionCB, const char *cmdTemplate, ...)
+{
+    uint8_t nextHead = (g_lqLTEM->atcmd->queueHead + 1) % atcmd__queueSz;
+    while (nextHead == g_lqLTEM->atcmd->queueTail)                                  // queue full, service until a slot frees
+    {
+        ASSERT(!g_lqLTEM->atcmd->queueServicing);                                   // can't wait on queue from a completion callback
+        ATCMD_serviceQueue();
+        pYield();
+    }
+
+    if (g_lqLTEM->atcmd->queueHead == g_lqLTEM->atcmd->queueTail && !g_lqLTEM->atcmd->queueActive)
+        g_lqLTEM->atcmd->queueResult = resultCode__success;                         // queue was idle, new queue run
+
+    atcmdQueueEntry_t *entry = &g_lqLTEM->atcmd->queue[g_lqLTEM->atcmd->queueHead];
+    char cmdStr[atcmd__queueCmdSz + 1];                                             // 1 char over entry: a full build is truncated
+    va_list ap;
+
+    va_start(ap, cmdTemplate);
+    uint16_t cmdLen = S__buildCmdStr(cmdStr, sizeof(cmdStr), cmdTemplate, ap, false);
+    va_end(ap);
+    ASSERT(cmdLen > 1 && cmdLen < sizeof(entry->cmdStr));                           // queued commands are short, longer use atcmd_tryInvoke()
+    memcpy(entry->cmdStr, cmdStr, cmdLen + 1);
+
+    entry->responseParserFunc = (responseParser != NULL) ? responseParser : ATCMD_okResponseParser;
+    entry->timeout = (timeoutMS != atcmd__noTimeoutChange) ? timeoutMS : atcmd__defaultTimeout;
+    entry->completionCB = completionCB;
+    g_lqLTEM->atcmd->queueHead = nextHead;
+
+    ATCMD_serviceQueue();                                                           // send now if command interface is idle
+}
+
+
+/**
+ *	@brief Waits for all queued AT commands to complete.
+ */
+resultCode_t atcmd_awaitQueue()
+{
+    while (g_lqLTEM->atcmd->queueActive || g_lqLTEM->atcmd->queueHead != g_lqLTEM->atcmd->queueTail)
+    {
+        ATCMD_serviceQueue();
+        pYield();                                                                   // give back control momentarily before next loop pass
+    }
+    return g_lqLTEM->atcmd->queueResult;
+}
+
+
+/**
+ *	@brief Initializes an AT command batch.
+ */
+void atcmd_batchInit(atcmdBatch_t *batch, uint32_t timeoutMS)
+{
+    memset(batch, 0, sizeof(atcmdBatch_t));
+    batch->timeout = (timeoutMS != atcmd__noTimeoutChange) ? timeoutMS : atcmd__defaultTimeout;
+    batch->resultCode = resultCode__success;
+}
+
+
+/**
+ *	@brief Adds a command to an AT command batch, sending the batch line first if the command will not join it.
+ */
+void atcmd_batchAdd(atcmdBatch_t *batch, const char *cmdTemplate, ...)
+{
+    va_list ap;
+
+    va_start(ap, cmdTemplate);
+    S__batchAddV(batch, 0, cmdTemplate, ap);
+    va_end(ap);
+}
+
+
+/**
+ *	@brief Adds a modem setting command to an AT command batch, skipped if the setting value is already in effect.
+ */
+void atcmd_batchAddSetting(atcmdBatch_t *batch, uint8_t keyParams, const char *cmdTemplate, ...)
+{
+    ASSERT(keyParams > 0);
+    va_list ap;
+
+    va_start(ap, cmdTemplate);
+    S__batchAddV(batch, keyParams, cmdTemplate, ap);
+    va_end(ap);
+}
+
+
+/**
+ *	@brief Sends any commands remaining in an AT command batch and returns the batch result.
+ */
+resultCode_t atcmd_batchExec(atcmdBatch_t *batch)
+{
+    S__batchSend(batch);
+    return batch->resultCode;
+}
+
+
+/**
+ *	@brief Replaces the retry policy for a command class.
+ */
+void atcmd_setRetryPolicy(atcmdRetryClass_t retryClass, const atcmdRetryPolicy_t *policy)
+{
+    ASSERT(retryClass < atcmdRetryClass_cnt && policy->retryCodesCnt <= atcmd__retryCodesMax);
+    memcpy(&g_lqLTEM->atcmd->retryPolicies[retryClass], policy, sizeof(atcmdRetryPolicy_t));
+}
+
+
+/**
+ *	@brief Returns the retry policy in effect for a command class.
+ */
+const atcmdRetryPolicy_t *atcmd_getRetryPolicy(atcmdRetryClass_t retryClass)
+{
+    ASSERT(retryClass < atcmdRetryClass_cnt);
+    return &g_lqLTEM->atcmd->retryPolicies[retryClass];
+}
+
+
+/**
+ *	@brief Starts retry tracking for a command sequence.
+ */
+void atcmd_retryInit(atcmdRetry_t *retry, atcmdRetryClass_t retryClass)
+{
+    ASSERT(retryClass < atcmdRetryClass_cnt);
+    memset(retry, 0, sizeof(atcmdRetry_t));
+    retry->retryClass = retryClass;
+    retry->backoffMS = g_lqLTEM->atcmd->retryPolicies[retryClass].backoffMS;
+    retry->startedAt = pMillis();
+}
+
+
+/**
+ *	@brief Evaluates a completed attempt against the class retry policy, waits out the backoff if the attempt is to be retried.
+ */
+bool atcmd_retryAgain(atcmdRetry_t *retry, resultCode_t rslt)
+{
+    const atcmdRetryPolicy_t *policy = &g_lqLTEM->atcmd->retryPolicies[retry->retryClass];
+
+    retry->attempt++;
+    retry->lastCode = S__retryCode(rslt);
+    if (retry->lastCode == 0 || retry->attempt >= policy->maxAttempts || LTEM_isCancelled())
+        return false;
+
+    bool transient = false;
+    for (uint8_t i = 0; i < policy->retryCodesCnt; i++)
+    {
+        if (policy->retryCodes[i] == retry->lastCode)
+        {
+            transient = true;
+            break;
+        }
+    }
+    if (!transient)
+        return false;
+
+    uint32_t backoff = retry->backoffMS / 2 + S__retryJitter(retry->backoffMS / 2);        // equal jitter: half fixed, half random
+    if (pMillis() - retry->startedAt + backoff >= policy->deadlineMS)
+        return false;
+    retry->backoffMS = MIN((uint32_t)retry->backoffMS * 2, policy->backoffMaxMS);
+
+    PRINTF(dbgColor__warn, "Retry(%d) code=%d backoff=%" PRIu32 "\r", retry->attempt, retry->lastCode, backoff);
+    g_lqLTEM->metrics.lastFailed = true;                                                // next completion of the verb is counted as a retry
+
+    uint32_t waitStart = pMillis();
+    while (!pElapsed(waitStart, backoff))
+    {
+        if (LTEM_isCancelled())
+            return false;
+        pYield();                                                                       // give application time for non-comm tasks
+    }
+    return true;
+}
+
+
+/**
+ *	@brief Applies a modem setting (automatic locking), skipping the BGx write if the setting value is already in effect.
+ */
+resultCode_t atcmd_applySetting(uint8_t keyParams, const char *cmdTemplate, ...)
+{
+    va_list ap;
+
+    va_start(ap, cmdTemplate);
+    resultCode_t rslt = S__applySettingV(false, keyParams, cmdTemplate, ap);
+    va_end(ap);
+    return rslt;
+}
+
+
+/**
+ *	@brief Applies a modem setting within an existing lock, skipping the BGx write if the setting value is already in effect.
+ */
+resultCode_t atcmd_applySettingReuseLock(uint8_t keyParams, const char *cmdTemplate, ...)
+{
+    va_list ap;
+
+    va_start(ap, cmdTemplate);
+    resultCode_t rslt = S__applySettingV(true, keyParams, cmdTemplate, ap);
+    va_end(ap);
+    return rslt;
 }
 
 
@@ -191,54 +482,98 @@ void atcmd_close()
 //  */
 // void atcmd_sendCmdData(const char *data, uint16_t dataSz)
 // {
-//     ASSERT(g_lqLTEM.atcmd->isOpenLocked);                       // verify inside command sequence
+//     ASSERT(g_lqLTEM->atcmd->isOpenLocked);                       // verify inside command sequence
 
-//     if (g_lqLTEM.atcmd->invokedAt == 0)
-//         g_lqLTEM.atcmd->invokedAt = pMillis();
+//     if (g_lqLTEM->atcmd->invokedAt == 0)
+//         g_lqLTEM->atcmd->invokedAt = pMillis();
 
 //     IOP_startTx(data, dataSz);
 
-//     while (g_lqLTEM.iop->txPending > 0)
+//     while (g_lqLTEM->iop->txPending > 0)
 //     {
 //         pDelay(1);
-//         ASSERT(pMillis() - g_lqLTEM.atcmd->invokedAt < PERIOD_FROM_SECONDS(120));
+//         ASSERT(pMillis() - g_lqLTEM->atcmd->invokedAt < PERIOD_FROM_SECONDS(120));
 //     }
 //     atcmd_reset(false);                                         // restore atcmd as TX buffer source
 // }
 
 
+/**
+ *	@brief Sets options for the invoked AT command.
+ */
+void atcmd_setOptions(uint32_t timeoutMS, cmdResponseParser_func cmdResponseParser)
+{
+    if (timeoutMS != atcmd__noTimeoutChange)
+    {
+        g_lqLTEM->atcmd->timeout = timeoutMS;
+    }
+    if (cmdResponseParser)                                          // caller can use atcmd__useDefaultOKCompletionParser
+        g_lqLTEM->atcmd->responseParserFunc = cmdResponseParser;
+    else
+        g_lqLTEM->atcmd->responseParserFunc = ATCMD_okResponseParser;
+}
+
+
+/**
+ *	@brief Sets line streaming mode for the invoked AT command, response lines are delivered to lineRecvCB as received.
+ */
+void atcmd_setLineStreaming(atcmdLineRecv_func lineRecvCB, void *lineCntxt)
+{
+    g_lqLTEM->atcmd->lineRecvCB = lineRecvCB;
+    g_lqLTEM->atcmd->lineCntxt = lineCntxt;
+    g_lqLTEM->atcmd->lineScanIndx = 0;
+    g_lqLTEM->atcmd->lineContinues = false;
+}
+
+
 /**
  *	@brief Waits for atcmd result, periodically checking recv buffer for valid response until timeout.
  */
 resultCode_t atcmd_awaitResult()
 {
-    resultCode_t rslt = resultCode__unknown;                                        // resultCode_t result;
-    do
+    resultCode_t rslt;
+    while ((rslt = atcmd_poll()) == resultCode__unknown)
     {
-        rslt = S__readResult();
-        if (g_lqLTEM.cancellationRequest)                                           // test for cancellation (RTOS or IRQ)
-        {
-            g_lqLTEM.atcmd->resultCode = resultCode__cancelled;
-            break;
-        }
-        pYield();                                                                   // give back control momentarily before next loop pass
-    } while (rslt == resultCode__unknown);
+        uint32_t elapsed = pMillis() - g_lqLTEM->atcmd->invokedAt;
+        IOP_awaitRx((elapsed < g_lqLTEM->atcmd->timeout) ? g_lqLTEM->atcmd->timeout - elapsed : 1);     // sleep until RX or timeout, poll detects timeout
+    }
+    return rslt;
+}
+
+
+/**
+ *	@brief Performs one non-blocking step of atcmd result processing: checks recv buffer for a valid response or timeout.
+ */
+resultCode_t atcmd_poll()
+{
+    resultCode_t rslt = S__readResult();
+    if (LTEM_isCancelled())                                                         // test for cancellation (global or request token: RTOS or IRQ)
+    {
+        g_lqLTEM->atcmd->resultCode = resultCode__cancelled;
+        if (g_lqLTEM->atcmd->autoLock)                                              // command is abandoned, release automatic lock
+            atcmd_close();                                                          // manual lock (invokeReuseLock) holder releases with atcmd_close()
+    }
+    else if (rslt == resultCode__unknown)                                           // still pending
+    {
+        return resultCode__unknown;
+    }
 
     #if _DEBUG == 0                                                                 // debug for debris in rxBffr
-    ASSERT_W(cbffr_getOccupied(g_lqLTEM.iop->rxBffr) == 0, "RxBffr Dirty");
+    ASSERT_W(cbffr_getOccupied(g_lqLTEM->iop->rxBffr) == 0, "RxBffr Dirty");
     #else
-    if (cbffr_getOccupied(g_lqLTEM.iop->rxBffr) > 0)
+    if (cbffr_getOccupied(g_lqLTEM->iop->rxBffr) > 0)
     {
         char dbg[81] = {0};
-        cbffr_pop(g_lqLTEM.iop->rxBffr, dbg, 80);
+        cbffr_pop(g_lqLTEM->iop->rxBffr, dbg, 80);
         PRINTF(dbgColor__yellow, "*!* %s", dbg);
     }
     #endif
 
-    g_lqLTEM.atcmd->timeout = atcmd__defaultTimeout;
-    g_lqLTEM.atcmd->responseParserFunc = ATCMD_okResponseParser;
+    g_lqLTEM->atcmd->timeout = atcmd__defaultTimeout;
+    g_lqLTEM->atcmd->responseParserFunc = ATCMD_okResponseParser;
+    g_lqLTEM->atcmd->lineRecvCB = NULL;
 
-    return g_lqLTEM.atcmd->resultCode;
+    return g_lqLTEM->atcmd->resultCode;
 }
 
 
@@ -247,16 +582,7 @@ resultCode_t atcmd_awaitResult()
  */
 resultCode_t atcmd_awaitResultWithOptions(uint32_t timeoutMS, cmdResponseParser_func cmdResponseParser)
 {
-    // set options
-    if (timeoutMS != atcmd__noTimeoutChange)
-    {
-        g_lqLTEM.atcmd->timeout = timeoutMS;
-    }
-    if (cmdResponseParser)                                          // caller can use atcmd__useDefaultOKCompletionParser
-        g_lqLTEM.atcmd->responseParserFunc = cmdResponseParser;
-    else
-        g_lqLTEM.atcmd->responseParserFunc = ATCMD_okResponseParser;
-
+    atcmd_setOptions(timeoutMS, cmdResponseParser);
     return atcmd_awaitResult();
 }
 
@@ -266,7 +592,7 @@ resultCode_t atcmd_awaitResultWithOptions(uint32_t timeoutMS, cmdResponseParser_
  */
 resultCode_t atcmd_getResult()
 {
-    return g_lqLTEM.atcmd->resultCode;
+    return g_lqLTEM->atcmd->resultCode;
 }
 
 
@@ -275,7 +601,7 @@ resultCode_t atcmd_getResult()
  */
 bool atcmd_getPreambleFound()
 {
-    return g_lqLTEM.atcmd->preambleFound;
+    return g_lqLTEM->atcmd->preambleFound;
 }
 
 
@@ -284,8 +610,8 @@ bool atcmd_getPreambleFound()
  */
 char* atcmd_getRawResponse()
 {
-    ASSERT(g_lqLTEM.atcmd->rawResponse != NULL);
-    return g_lqLTEM.atcmd->rawResponse;
+    ASSERT(g_lqLTEM->atcmd->rawResponse != NULL);
+    return g_lqLTEM->atcmd->rawResponse;
 }
 
 
@@ -295,8 +621,8 @@ char* atcmd_getRawResponse()
  */
 char *atcmd_getResponse()
 {
-    ASSERT(g_lqLTEM.atcmd->response != NULL);
-    return g_lqLTEM.atcmd->response;
+    ASSERT(g_lqLTEM->atcmd->response != NULL);
+    return g_lqLTEM->atcmd->response;
 }
 
 
@@ -305,7 +631,7 @@ char *atcmd_getResponse()
  */
 int32_t atcmd_getValue()
 {
-    return g_lqLTEM.atcmd->retValue;
+    return g_lqLTEM->atcmd->retValue;
 }
 
 
@@ -314,7 +640,7 @@ int32_t atcmd_getValue()
  */
 uint32_t atcmd_getDuration()
 {
-    return g_lqLTEM.atcmd->execDuration;
+    return g_lqLTEM->atcmd->execDuration;
 }
 
 
@@ -323,7 +649,7 @@ uint32_t atcmd_getDuration()
  */
 cmdParseRslt_t atcmd_getParserResult()
 {
-    return g_lqLTEM.atcmd->parserResult;
+    return g_lqLTEM->atcmd->parserResult;
 }
 
 
@@ -332,7 +658,7 @@ cmdParseRslt_t atcmd_getParserResult()
  */
 char *atcmd_getErrorDetail()
 {
-    return &g_lqLTEM.atcmd->errorDetail;
+    return &g_lqLTEM->atcmd->errorDetail;
 }
 
 
@@ -342,9 +668,9 @@ char *atcmd_getErrorDetail()
  */
 uint16_t atcmd_getErrorDetailCode()
 {
-    if (g_lqLTEM.atcmd->errorDetail[1] == 'C' && g_lqLTEM.atcmd->errorDetail[2] == 'M')
+    if (g_lqLTEM->atcmd->errorDetail[0] == '+' && g_lqLTEM->atcmd->errorDetail[1] == 'C' && g_lqLTEM->atcmd->errorDetail[2] == 'M')
     {
-        return strtol(g_lqLTEM.atcmd->errorDetail + 12, NULL, 10);
+        return strtol(g_lqLTEM->atcmd->errorDetail + 12, NULL, 10);
     }
     else
         return 999;
@@ -356,7 +682,7 @@ uint16_t atcmd_getErrorDetailCode()
  */
 void atcmd_exitTextMode()
 {
-    char ctrlZ[] = { 0x1A };
+    static char ctrlZ[] = { 0x1A };                                     // TX is not copied, must outlive call
     IOP_startTx(ctrlZ, sizeof(ctrlZ));
 }
 
@@ -374,9 +700,9 @@ void atcmd_exitDataMode()
  */
 void atcmd_exitTransparentMode()
 {
-    lDelay(1000);
+    pDelay(1000);
     IOP_startTx("+++", 3);         // send +++, gaurded by 1 second of quiet
-    lDelay(1000);
+    pDelay(1000);
 }
 
 
@@ -388,6 +714,20 @@ void atcmd_exitTransparentMode()
 /*-----------------------------------------------------------------------------------------------*/
 
 
+/**
+ *  @brief Initialize the AT command subsystem of the device being created.
+ */
+void ATCMD_create()
+{
+    g_lqLTEM->atcmd = calloc(1, sizeof(atcmd_t));
+    ASSERT(g_lqLTEM->atcmd != NULL);
+    atcmd_reset(true);
+
+    memcpy(g_lqLTEM->atcmd->retryPolicies, s_retryPolicyDefaults, sizeof(s_retryPolicyDefaults));
+    g_lqLTEM->atcmd->retryJitterSeed = (uint32_t)(uintptr_t)g_lqLTEM;                      // devices' backoff jitter diverges
+}
+
+
 /**
  *  @brief Awaits exclusive access to QBG module command interface.
 */
@@ -397,13 +737,11 @@ bool ATCMD_awaitLock(uint16_t timeoutMS)
                                                                     
     while (pMillis() - waitStart < timeoutMS)           // cannot set lock while... 
     {                                                       // can set new lock if...
-        if (!g_lqLTEM.atcmd->isOpenLocked)                  // !not existing lock
-        {
-            g_lqLTEM.atcmd->isOpenLocked = true;            // acquired new lock
+        if (S__tryLock())
             return true;
-        }
         pYield();                                           // call back to platform yield() in case there is work there that can be done
-        ltem_eventMgr();                                    // process any new receives prior to starting cmd invoke
+        if (LTEM_isAccessOwner())                           // another task's request holds access, its awaits service RX
+            ltem_eventMgr();                                // process any new receives prior to starting cmd invoke
     }
     return false;                                           // timed out waiting for lock
 }
@@ -414,7 +752,476 @@ bool ATCMD_awaitLock(uint16_t timeoutMS)
  */
 bool ATCMD_isLockActive()
 {
-    return g_lqLTEM.atcmd->isOpenLocked;
+    return g_lqLTEM->atcmd->isOpenLocked;
+}
+
+
+/**
+ *	@brief Service the pipelined command queue: complete the in-flight queued command and send the next.
+ */
+void ATCMD_serviceQueue()
+{
+    if (g_lqLTEM->atcmd->queueServicing)                                                    // S__readResult() calls ltem_eventMgr()
+        return;
+    g_lqLTEM->atcmd->queueServicing = true;
+
+    if (g_lqLTEM->atcmd->queueActive)
+    {
+        resultCode_t rslt = S__readResult();
+        if (rslt != resultCode__unknown)                                                    // final result received (or timeout)
+        {
+            atcmdCompletion_func completionCB = g_lqLTEM->atcmd->queue[g_lqLTEM->atcmd->queueTail].completionCB;
+            g_lqLTEM->atcmd->queueTail = (g_lqLTEM->atcmd->queueTail + 1) % atcmd__queueSz;
+            g_lqLTEM->atcmd->queueActive = false;
+            g_lqLTEM->atcmd->isOpenLocked = false;
+
+            if (rslt != resultCode__success && g_lqLTEM->atcmd->queueResult == resultCode__success)
+                g_lqLTEM->atcmd->queueResult = rslt;
+
+            if (completionCB != NULL)
+                completionCB(rslt, g_lqLTEM->atcmd->response);
+        }
+    }
+
+    if (!g_lqLTEM->atcmd->queueActive &&                                                    // pipeline: send next queued command immediately
+        g_lqLTEM->atcmd->queueHead != g_lqLTEM->atcmd->queueTail && 
+        !g_lqLTEM->atcmd->isOpenLocked)
+    {
+        g_lqLTEM->atcmd->isOpenLocked = true;                                               // queue holds lock until drained
+        S__invokeQueued();
+    }
+    g_lqLTEM->atcmd->queueServicing = false;
+}
+
+
+/**
+ *	@brief Send the command at the queue tail, queue holds the command lock.
+ */
+static void S__invokeQueued()
+{
+    atcmdQueueEntry_t *entry = &g_lqLTEM->atcmd->queue[g_lqLTEM->atcmd->queueTail];
+
+    atcmd_reset(false);                                                                     // clear atCmd control, lock held by queue
+    g_lqLTEM->atcmd->autoLock = atcmd__setLockModeManual;                                   // queue servicing releases lock
+    strcpy(g_lqLTEM->atcmd->cmdStr, entry->cmdStr);                                         // TX is not copied, send from atcmd storage
+    g_lqLTEM->atcmd->responseParserFunc = entry->responseParserFunc;
+    g_lqLTEM->atcmd->timeout = entry->timeout;
+    g_lqLTEM->atcmd->queueActive = true;
+    g_lqLTEM->atcmd->invokedAt = pMillis();
+
+    PRINTF(dbgColor__white, "atcmdQ> %s\r", g_lqLTEM->atcmd->cmdStr);
+    IOP_startTx(g_lqLTEM->atcmd->cmdStr, strlen(g_lqLTEM->atcmd->cmdStr));
+}
+
+
+/**
+ *	@brief Queue a TX block sent ahead of a following IOP_startTx(), starts TX if the TX queue is full.
+ */
+static void S__chainTx(const char *data, uint16_t dataSz)
+{
+    if (dataSz > 0 && !IOP_enqueueTx(data, dataSz))
+        IOP_startTx(data, dataSz);                                                          // blocks until queued, sending frees slots
+}
+
+
+/**
+ *	@brief Consume a received result line containing phrase (data mode), RX chars through the line end are skipped.
+ *  @return True if phrase and its line end are in the RX buffer.
+ */
+static bool S__takeResultLine(const char *phrase)
+{
+    int16_t phraseIndx = cbffr_find(g_lqLTEM->iop->rxBffr, phrase, 0, 0, false);
+    if (!CBFFR_FOUND(phraseIndx))
+        return false;
+
+    int16_t eolIndx = cbffr_find(g_lqLTEM->iop->rxBffr, "\r\n", phraseIndx, 0, false);
+    if (!CBFFR_FOUND(eolIndx))                                                              // line end not received yet
+        return false;
+    cbffr_skipTail(g_lqLTEM->iop->rxBffr, eolIndx + 2);
+    return true;
+}
+
+
+/**
+ *	@brief Send a batch's joined command line and record the first failed command.
+ *  @details BGx stops a command line at the first failed command and reports only ERROR/+CME ERROR. To attribute the failure, 
+ *           the line's commands are resent individually; commands preceding the failure are settings and are reapplied unchanged.
+ */
+static void S__batchSend(atcmdBatch_t *batch)
+{
+    if (batch->lineCmdCnt == 0)
+        return;
+
+    uint8_t failedCmd = batch->cmdCnt - batch->lineCmdCnt + 1;                              // ordinal of line's first command
+    resultCode_t rslt = resultCode__conflict;
+
+    if (atcmd_tryInvoke("%s", batch->cmdLine))
+        rslt = atcmd_awaitResultWithOptions(batch->timeout * batch->lineCmdCnt, NULL);
+
+    bool resendCmds = (rslt == resultCode__cmError && batch->lineCmdCnt > 1);
+    char *cmd = batch->cmdLine;
+    for (uint8_t i = 0; i < batch->lineCmdCnt; i++)                                         // resend if attributing failure, update shadowed settings
+    {
+        char *nextCmd = S__batchSplitCmd(cmd);
+        char *setting = (i == 0) ? cmd + 2 : cmd;                                           // 1st has AT, others joined as +<cmd>
+        if (resendCmds)
+        {
+            rslt = resultCode__conflict;
+            if (atcmd_tryInvoke("AT%s", setting))
+                rslt = atcmd_awaitResultWithOptions(batch->timeout, NULL);
+        }
+        S__shadowSetting(setting, batch->lineKeyParams[i], rslt == resultCode__success);
+        if (resendCmds && rslt != resultCode__success)                                      // BGx did not apply commands following failure
+        {
+            failedCmd += i;
+            break;
+        }
+        cmd = nextCmd;
+    }
+
+    if (rslt != resultCode__success && batch->resultCode == resultCode__success)
+    {
+        PRINTF(dbgColor__warn, "atcmdBatch cmd %d failed=%d\r", failedCmd, rslt);
+        batch->resultCode = rslt;
+        batch->failedCmd = failedCmd;
+    }
+    batch->cmdLine[0] = '\0';
+    batch->lineLen = 0;
+    batch->lineCmdCnt = 0;
+}
+
+
+/**
+ *	@brief Adds a command to a batch line, sending the line first if the command will not join it.
+ *  @param keyParams [in] Shadowed setting key parameter count, 0 if command is not a shadowed setting.
+ */
+static void S__batchAddV(atcmdBatch_t *batch, uint8_t keyParams, const char *cmdTemplate, va_list ap)
+{
+    uint16_t appendAt;
+    uint16_t cmdLen;
+    bool joinable;
+    va_list apCopy;
+
+    while (true)
+    {
+        appendAt = batch->lineLen + (batch->lineCmdCnt > 0 ? 1 : 0);                       // room for ; separator
+        if (batch->lineCmdCnt == atcmd__batchCmdMax || 
+            (batch->lineCmdCnt > 0 && appendAt + sizeof("AT+X\r") >= sizeof(batch->cmdLine)))
+        {
+            S__batchSend(batch);                                                            // line full
+            continue;
+        }
+
+        va_copy(apCopy, ap);
+        cmdLen = S__buildCmdStr(batch->cmdLine + appendAt, sizeof(batch->cmdLine) - appendAt, cmdTemplate, apCopy, false);
+        va_end(apCopy);
+
+        joinable = memcmp(batch->cmdLine + appendAt, "AT+", 3) == 0;                       // extended commands join, basic (ATE0) are sent alone
+        if (batch->lineCmdCnt == 0 || (joinable && cmdLen < sizeof(batch->cmdLine) - appendAt - 1))
+            break;
+
+        batch->cmdLine[batch->lineLen] = '\0';                                              // drop from line, send line then start new with cmd
+        S__batchSend(batch);
+    }
+    ASSERT(cmdLen < sizeof(batch->cmdLine) - 1);                                            // single command fits (not truncated)
+    batch->cmdCnt++;
+
+    if (keyParams > 0)                                                                      // shadowed setting: skip if already in effect
+    {
+        const char *setting = batch->cmdLine + appendAt + 2;                                // shadow excludes AT prefix and \r
+        uint16_t settingSz = cmdLen - 3;
+        if (LTEM_shadowIsCurrent(setting, S__settingKeySz(setting, settingSz, keyParams), setting, settingSz))
+        {
+            batch->cmdLine[batch->lineLen] = '\0';
+            return;
+        }
+    }
+
+    batch->lineLen = appendAt + cmdLen - 1;                                                 // drop \r, appended at send
+    if (batch->lineCmdCnt > 0)                                                              // join as ;+<cmd>
+    {
+        batch->cmdLine[appendAt - 1] = ';';
+        memmove(batch->cmdLine + appendAt, batch->cmdLine + appendAt + 2, cmdLen - 3);
+        batch->lineLen -= 2;
+    }
+    batch->cmdLine[batch->lineLen] = '\0';
+    batch->lineKeyParams[batch->lineCmdCnt++] = keyParams;
+
+    if (!joinable)
+        S__batchSend(batch);
+}
+
+
+/**
+ *	@brief Terminate a batch line command at its ; separator (quoted strings skipped).
+ *  @return Pointer to the next command, or to the line's \0 terminator if cmd is the last.
+ */
+static char *S__batchSplitCmd(char *cmd)
+{
+    bool quoted = false;
+    for (; *cmd != '\0'; cmd++)
+    {
+        if (*cmd == '"')
+            quoted = !quoted;
+        else if (*cmd == ';' && !quoted)
+        {
+            *cmd = '\0';
+            return cmd + 1;
+        }
+    }
+    return cmd;
+}
+
+
+/**
+ *	@brief Apply a modem setting command, skipped if the shadow shows the setting value is already in effect.
+ *  @details Shadow key is the command through keyParams parameters (ex: +QHTTPCFG="sslctxid"), value is the full command.
+ */
+static resultCode_t S__applySettingV(bool reuseLock, uint8_t keyParams, const char *cmdTemplate, va_list ap)
+{
+    ASSERT(keyParams > 0);
+    char cmd[atcmd__queueCmdSz + 1];                                                        // 1 char over limit: a full build is truncated
+
+    uint16_t cmdLen = S__buildCmdStr(cmd, sizeof(cmd), cmdTemplate, ap, false);
+    ASSERT(cmdLen > 3 && cmdLen < sizeof(cmd) - 1);                                         // settings commands are short
+    cmd[--cmdLen] = '\0';                                                                   // \r appended again at invoke
+
+    const char *setting = cmd + 2;                                                          // shadow excludes AT prefix, batch lines join as +<cmd>
+    uint16_t settingSz = cmdLen - 2;
+    uint16_t keySz = S__settingKeySz(setting, settingSz, keyParams);
+    if (LTEM_shadowIsCurrent(setting, keySz, setting, settingSz))
+        return resultCode__success;
+
+    resultCode_t rslt = resultCode__conflict;
+    if (reuseLock)
+    {
+        atcmd_invokeReuseLock("%s", cmd);
+        rslt = atcmd_awaitResult();
+    }
+    else if (atcmd_tryInvoke("%s", cmd))
+        rslt = atcmd_awaitResult();
+    else
+        return rslt;
+
+    S__shadowSetting(setting, keyParams, rslt == resultCode__success);
+    return rslt;
+}
+
+
+/**
+ *	@brief Length of a setting's shadow key: the command through its first keyParams parameters.
+ */
+static uint16_t S__settingKeySz(const char *setting, uint16_t settingSz, uint8_t keyParams)
+{
+    bool quoted = false;
+    uint16_t i = 0;
+
+    while (i < settingSz && setting[i] != '=')
+        i++;
+    for (i++; i < settingSz; i++)
+    {
+        if (setting[i] == '"')
+            quoted = !quoted;
+        else if (setting[i] == ',' && !quoted && --keyParams == 0)
+            return i;
+    }
+    return settingSz;
+}
+
+
+/**
+ *	@brief Update the shadow for an applied (or failed, value now unknown) setting, setting is \0 terminated.
+ */
+static void S__shadowSetting(const char *setting, uint8_t keyParams, bool applied)
+{
+    if (keyParams == 0)
+        return;
+
+    uint16_t settingSz = strlen(setting);
+    LTEM_shadowUpdate(setting, S__settingKeySz(setting, settingSz, keyParams), applied ? setting : NULL, settingSz);
+}
+
+
+/**
+ *	@brief Acquire command lock (auto lock mode) and send formatted command.
+ */
+static bool S__tryInvokeV(const char *cmdTemplate, va_list ap, bool isDescriptor)
+{
+    if (!S__tryLock())                                                  // lock held before atCmd control and cmdStr are touched
+        return false;
+
+    atcmd_reset(false);                                                 // clear atCmd control, keeping new lock
+    g_lqLTEM->atcmd->autoLock = atcmd__setLockModeAuto;                  // set automatic lock control mode
+
+    uint16_t cmdLen = S__buildCmdStr(g_lqLTEM->atcmd->cmdStr, sizeof(g_lqLTEM->atcmd->cmdStr), cmdTemplate, ap, isDescriptor);
+
+    g_lqLTEM->atcmd->invokedAt = pMillis();
+
+    #ifdef LTEMC_CMDMIRROR
+    strcpy(g_lqLTEM->atcmd->CMDMIRROR, g_lqLTEM->atcmd->cmdStr);
+    #endif
+
+    IOP_startTx(g_lqLTEM->atcmd->cmdStr, cmdLen);
+    return true;
+}
+
+
+/**
+ *	@brief Take the command lock if not held and the caller holds modem access (or no request does, see ltem_acquire()), 
+ *         test-and-set is atomic for multi-task callers.
+ *  @return True if the lock was acquired.
+ */
+static bool S__tryLock()
+{
+    LTEM_critical(true);
+    bool acquired = !g_lqLTEM->atcmd->isOpenLocked && LTEM_isAccessOwner();
+    if (acquired)
+        g_lqLTEM->atcmd->isOpenLocked = true;
+    LTEM_critical(false);
+    return acquired;
+}
+
+
+/**
+ *	@brief Send formatted command, reusing the held command lock (manual lock mode).
+ */
+static void S__invokeReuseLockV(const char *cmdTemplate, va_list ap, bool isDescriptor)
+{
+    ASSERT(g_lqLTEM->atcmd->isOpenLocked);    // function assumes re-use of existing lock
+
+    atcmd_reset(false);                                                         // clear out properties WITHOUT lock release
+    g_lqLTEM->atcmd->autoLock = atcmd__setLockModeManual;
+
+    uint16_t cmdLen = S__buildCmdStr(g_lqLTEM->atcmd->cmdStr, sizeof(g_lqLTEM->atcmd->cmdStr), cmdTemplate, ap, isDescriptor);
+
+    g_lqLTEM->atcmd->invokedAt = pMillis();
+
+    #ifdef LTEMC_CMDMIRROR
+    strcpy(g_lqLTEM->atcmd->CMDMIRROR, g_lqLTEM->atcmd->cmdStr);
+    #endif
+
+    IOP_startTx(g_lqLTEM->atcmd->cmdStr, cmdLen);
+}
+
+
+/**
+ *	@brief Format command template into cmdStr and append the \r command terminator.
+ *  @details Descriptor templates (and all templates with LTEMC_NO_PRINTF) use the atcmd formatter, otherwise vsnprintf().
+ *  @return Length of the command, including terminator.
+ */
+static uint16_t S__buildCmdStr(char *cmdStr, uint16_t cmdStrSz, const char *cmdTemplate, va_list ap, bool isDescriptor)
+{
+    int cmdLen;
+
+    #ifdef LTEMC_NO_PRINTF
+    isDescriptor = true;
+    #endif
+
+    if (isDescriptor)
+        cmdLen = S__formatCmd(cmdStr, cmdStrSz - 1, cmdTemplate, ap);           // leave room for \r
+    else
+        cmdLen = vsnprintf(cmdStr, cmdStrSz - 1, cmdTemplate, ap);
+
+    cmdLen = MIN(MAX(cmdLen, 0), cmdStrSz - 2);                                 // vsnprintf() returns untruncated length
+    cmdStr[cmdLen++] = '\r';
+    cmdStr[cmdLen] = '\0';
+    return cmdLen;
+}
+
+
+/**
+ *	@brief Lightweight command formatter: descriptor slots (ATCMD_INT/ATCMD_STR) and the printf subset used by LTEmC templates.
+ *  @param dest [out] Destination buffer, result is \0 terminated.
+ *  @param destSz [in] Size of the destination buffer.
+ *  @return Number of chars written, excluding \0.
+ */
+static uint16_t S__formatCmd(char *dest, uint16_t destSz, const char *cmdTemplate, va_list ap)
+{
+    char numBffr[12];                                                           // fits -2147483648
+    uint16_t len = 0;
+
+    for (const char *tmpl = cmdTemplate; *tmpl != '\0'; tmpl++)
+    {
+        const char *emit = NULL;                                                // string argument or formatted number
+        uint32_t intVal = 0;
+        bool isNegative = false;
+        uint8_t base = 0;                                                       // 0 = not a number
+
+        if (*tmpl == atcmd__slotInt)
+        {
+            int32_t argVal = va_arg(ap, int);
+            isNegative = argVal < 0;
+            intVal = isNegative ? -(uint32_t)argVal : (uint32_t)argVal;
+            base = 10;
+        }
+        else if (*tmpl == atcmd__slotStr)
+        {
+            emit = va_arg(ap, const char *);
+        }
+        else if (*tmpl == '%' && tmpl[1] != '\0')
+        {
+            bool isLong = (*++tmpl == 'l');
+            if (isLong && tmpl[1] != '\0')
+                tmpl++;
+
+            switch (*tmpl)
+            {
+                case 'd':
+                case 'i':
+                {
+                    int32_t argVal = isLong ? (int32_t)va_arg(ap, long) : va_arg(ap, int);
+                    isNegative = argVal < 0;
+                    intVal = isNegative ? -(uint32_t)argVal : (uint32_t)argVal;
+                    base = 10;
+                    break;
+                }
+                case 'u':
+                case 'X':
+                    intVal = isLong ? (uint32_t)va_arg(ap, unsigned long) : va_arg(ap, unsigned int);
+                    base = (*tmpl == 'u') ? 10 : 16;
+                    break;
+                case 's':
+                    emit = va_arg(ap, const char *);
+                    break;
+                case 'c':
+                    numBffr[0] = (char)va_arg(ap, int);
+                    numBffr[1] = '\0';
+                    emit = numBffr;
+                    break;
+                default:                                                        // %% and unsupported conversions emit as literal
+                    numBffr[0] = *tmpl;
+                    numBffr[1] = '\0';
+                    emit = numBffr;
+                    break;
+            }
+        }
+        else
+        {
+            if (len < destSz - 1)
+                dest[len++] = *tmpl;
+            continue;
+        }
+
+        if (base)                                                               // number: emit digits right to left into numBffr
+        {
+            char *digit = numBffr + sizeof(numBffr) - 1;
+            *digit = '\0';
+            do
+            {
+                *--digit = "0123456789ABCDEF"[intVal % base];
+                intVal /= base;
+            } while (intVal);
+            if (isNegative)
+                *--digit = '-';
+            emit = digit;
+        }
+        while (emit != NULL && *emit != '\0' && len < destSz - 1)
+        {
+            dest[len++] = *emit++;
+        }
+    }
+    dest[len] = '\0';
+    return len;
 }
 
 
@@ -423,95 +1230,120 @@ bool ATCMD_isLockActive()
  */
 static resultCode_t S__readResult()
 {
-    g_lqLTEM.atcmd->parserResult = cmdParseRslt_pending;
-    g_lqLTEM.atcmd->resultCode = 0;
+    g_lqLTEM->atcmd->parserResult = cmdParseRslt_pending;
+    g_lqLTEM->atcmd->resultCode = 0;
     uint16_t peekedLen;
     
-    ltem_eventMgr();                                                                        // check for URC events preceeding cmd response
+    ltem_eventMgr();                                                                        // background work, URC events are queued until command completes
 
-    if (cbffr_getOccupied(g_lqLTEM.iop->rxBffr) > 0)
+    if (g_lqLTEM->atcmd->lineRecvCB != NULL)                                                     // line streaming, response lines go to callback
+    {
+        g_lqLTEM->atcmd->parserResult = S__streamLines();
+    }
+    else if (cbffr_getOccupied(g_lqLTEM->iop->rxBffr) > 0)
     {
         // chk for current command services a stream and there is a recv handler registered
-        if (g_lqLTEM.atcmd->dataMode.dataHndlr != NULL)
+        if (g_lqLTEM->atcmd->dataMode.dataHndlr != NULL)
         {
             // looking for streamPrefix phrase 
-            if (CBFFR_FOUND(cbffr_find(g_lqLTEM.iop->rxBffr, g_lqLTEM.atcmd->dataMode.trigger, 0, 0, true)))
+            if (CBFFR_FOUND(cbffr_find(g_lqLTEM->iop->rxBffr, g_lqLTEM->atcmd->dataMode.trigger, 0, 0, true)))
             {
-                PRINTF(dbgColor__white, "%s:dataMode>\r", g_lqLTEM.atcmd->streamPrefix);                // entered stream data mode
-                resultCode_t dataRslt = (*g_lqLTEM.atcmd->dataMode.dataHndlr)();
-                if (dataRslt == resultCode__success)
+                PRINTF(dbgColor__white, "%s:dataMode>\r", g_lqLTEM->atcmd->dataMode.trigger);                // entered stream data mode
+                bool isRxData = g_lqLTEM->atcmd->dataMode.dataHndlr != atcmd_stdTxDataHndlr;         // RX handler reads data from rxBffr
+                IOP_setTrafficProfile(iopTrafficProfile_data);
+                if (isRxData)
+                    IOP_beginRxDataXfer();                                                              // data is not URC lines
+                resultCode_t dataRslt = (*g_lqLTEM->atcmd->dataMode.dataHndlr)();
+                if (isRxData)
+                    IOP_endRxDataXfer();
+                IOP_setTrafficProfile(iopTrafficProfile_command);
+                if (dataRslt != resultCode__success)                                                    // handler failure completes the command
+                {
+                    g_lqLTEM->atcmd->parserResult = cmdParseRslt_error | ((dataRslt == resultCode__cmError) ? cmdParseRslt_moduleError : 0);
+                    g_lqLTEM->atcmd->resultCode = dataRslt;
+                }
+                else if (g_lqLTEM->atcmd->dataMode.skipParser)
                 {
-                    if (dataRslt != resultCode__success)
-                    {
-                        g_lqLTEM.atcmd->parserResult = cmdParseRslt_error;
-                        g_lqLTEM.atcmd->resultCode = dataRslt;
-                    }
-                    else if (g_lqLTEM.atcmd->dataMode.skipParser)
-                    {
-                        g_lqLTEM.atcmd->parserResult = cmdParseRslt_success;
-                        g_lqLTEM.atcmd->resultCode = dataRslt;
-                    }
+                    g_lqLTEM->atcmd->parserResult = cmdParseRslt_success;
+                    g_lqLTEM->atcmd->resultCode = dataRslt;
                 }
                 PRINTF(dbgColor__white, "Exit dataMode rslt=%d\r", dataRslt);
-                memset(&g_lqLTEM.atcmd->dataMode, 0, sizeof(dataMode_t));                               // done with dataMode settings
+                memset(&g_lqLTEM->atcmd->dataMode, 0, sizeof(dataMode_t));                               // done with dataMode settings
             }
         }
 
-        uint8_t respLen = strlen(g_lqLTEM.atcmd->rawResponse);                                          // response so far
-        uint8_t popSz = MIN(atcmd__respBufferSz - respLen, cbffr_getOccupied(g_lqLTEM.iop->rxBffr));    
+        uint16_t respLen = g_lqLTEM->atcmd->rawResponseLen;                                              // response so far
+        uint16_t popSz = MIN(atcmd__respBufferSz - respLen, cbffr_getOccupied(g_lqLTEM->iop->rxBffr));    
+        if (g_lqLTEM->atcmd->dataMode.dataHndlr != NULL)                                                 // data mode pending, hold a partially received trigger
+            popSz -= MIN(popSz, S__dataModeTriggerPartial());
         ASSERT((respLen + popSz) < atcmd__respBufferSz);                                                // ensure don't overflow 
 
-        if (g_lqLTEM.atcmd->parserResult == cmdParseRslt_pending)
+        if (g_lqLTEM->atcmd->parserResult == cmdParseRslt_pending)
         {
-            cbffr_pop(g_lqLTEM.iop->rxBffr, g_lqLTEM.atcmd->rawResponse + respLen,  popSz);             // pop new into response buffer for parsing
+            cbffr_pop(g_lqLTEM->iop->rxBffr, g_lqLTEM->atcmd->rawResponse + respLen,  popSz);     // pop new into response buffer for parsing
+            g_lqLTEM->atcmd->rawResponseLen = respLen + popSz;
+            g_lqLTEM->atcmd->rawResponse[g_lqLTEM->atcmd->rawResponseLen] = '\0';
+            S__scanFinalResult(respLen);                                                                // match final result codes in new chars only
             /* - */
-            g_lqLTEM.atcmd->parserResult = (*g_lqLTEM.atcmd->responseParserFunc)();                     /* *** parse for command response *** */
+            g_lqLTEM->atcmd->parserResult = (*g_lqLTEM->atcmd->responseParserFunc)();                     /* *** parse for command response *** */
             /* - */
-            PRINTF(dbgColor__gray, "prsr=%d \r", g_lqLTEM.atcmd->parserResult);
+            PRINTF(dbgColor__gray, "prsr=%d \r", g_lqLTEM->atcmd->parserResult);
         }
     }
 
-    if (g_lqLTEM.atcmd->parserResult & cmdParseRslt_error)                                      // check error bit
+    if (g_lqLTEM->atcmd->parserResult & cmdParseRslt_error)                                      // check error bit
     {
-        if (g_lqLTEM.atcmd->parserResult & cmdParseRslt_moduleError)                            // BGx ERROR or CME/CMS
-            g_lqLTEM.atcmd->resultCode = resultCode__cmError;
+        if (g_lqLTEM->atcmd->parserResult & cmdParseRslt_moduleError)                            // BGx ERROR or CME/CMS
+            g_lqLTEM->atcmd->resultCode = resultCode__cmError;
 
-        else if (g_lqLTEM.atcmd->parserResult & cmdParseRslt_countShort)                        // did not find expected tokens
-            g_lqLTEM.atcmd->resultCode = resultCode__notFound;
+        else if (g_lqLTEM->atcmd->parserResult & cmdParseRslt_countShort)                        // did not find expected tokens
+            g_lqLTEM->atcmd->resultCode = resultCode__notFound;
 
-        else
-            g_lqLTEM.atcmd->resultCode = resultCode__internalError;                             // covering the unknown
+        else if (g_lqLTEM->atcmd->resultCode == 0)                                              // not reported by data mode handler
+            g_lqLTEM->atcmd->resultCode = resultCode__internalError;                             // covering the unknown
 
+        g_lqLTEM->atcmd->execDuration = pMillis() - g_lqLTEM->atcmd->invokedAt;
         atcmd_close();                                                                          // close action to release action lock on any error
     }
 
-    if (g_lqLTEM.atcmd->parserResult == cmdParseRslt_pending)                                   // still pending, check for timeout error
+    if (g_lqLTEM->atcmd->parserResult == cmdParseRslt_pending)                                   // still pending, check for timeout error
     {
-        if (pElapsed(g_lqLTEM.atcmd->invokedAt, g_lqLTEM.atcmd->timeout))
+        if (pElapsed(g_lqLTEM->atcmd->invokedAt, g_lqLTEM->atcmd->timeout))
         {
-            g_lqLTEM.atcmd->resultCode = resultCode__timeout;
-            g_lqLTEM.atcmd->isOpenLocked = false;                                               // close action to release action lock
-            g_lqLTEM.atcmd->execDuration = pMillis() - g_lqLTEM.atcmd->invokedAt;
+            g_lqLTEM->atcmd->resultCode = resultCode__timeout;
+            g_lqLTEM->atcmd->isOpenLocked = false;                                               // close action to release action lock
+            g_lqLTEM->atcmd->execDuration = pMillis() - g_lqLTEM->atcmd->invokedAt;
 
             if (ltem_getDeviceState() != deviceState_appReady)                                  // if action timed-out, verify not a device wide failure
                 ltem_notifyApp(appEvent_fault_hardLogic, "LTEm Not AppReady");
             else if (!SC16IS7xx_isAvailable())
                 ltem_notifyApp(appEvent_fault_softLogic, "LTEm SPI Fault");                     // UART bridge SPI not initialized correctly, IRQ not enabled
 
+            S__recordMetrics();
             return resultCode__timeout;
         }
         return resultCode__unknown;
     }
 
-    if (g_lqLTEM.atcmd->parserResult & cmdParseRslt_success)                                // success bit: parser completed with success (may have excessRecv warning)
+    if (g_lqLTEM->atcmd->parserResult & cmdParseRslt_success)                                // success bit: parser completed with success (may have excessRecv warning)
     {
-        if (g_lqLTEM.atcmd->autoLock)                                                       // if the individual cmd is controlling lock state
-            g_lqLTEM.atcmd->isOpenLocked = false;                                           // equivalent to atcmd_close()
-        g_lqLTEM.atcmd->execDuration = pMillis() - g_lqLTEM.atcmd->invokedAt;
-        g_lqLTEM.atcmd->resultCode = resultCode__success;
-        g_lqLTEM.metrics.cmdInvokes++;
+        if (g_lqLTEM->atcmd->autoLock)                                                       // if the individual cmd is controlling lock state
+            g_lqLTEM->atcmd->isOpenLocked = false;                                           // equivalent to atcmd_close()
+        g_lqLTEM->atcmd->execDuration = pMillis() - g_lqLTEM->atcmd->invokedAt;
+        g_lqLTEM->atcmd->resultCode = resultCode__success;
+        g_lqLTEM->metrics.cmdInvokes++;
     }
-    return g_lqLTEM.atcmd->resultCode;
+    S__recordMetrics();
+    return g_lqLTEM->atcmd->resultCode;
+}
+
+
+/**
+ *	@brief Returns the AT command verb name for a metrics verb, "" for atcmdVerb_other.
+ */
+const char *atcmd_getVerbName(atcmdVerb_t verb)
+{
+    return (verb < atcmdVerb_cnt) ? s_atcmdVerbs[verb] : "";
 }
 
 
@@ -549,21 +1381,45 @@ cmdParseRslt_t ATCMD_okResponseParser()
  */
 resultCode_t atcmd_stdTxDataHndlr()
 {
-    IOP_startTx(g_lqLTEM.atcmd->dataMode.txDataLoc, g_lqLTEM.atcmd->dataMode.txDataSz);
+    dataMode_t *dataMode = &g_lqLTEM->atcmd->dataMode;
+
+    if (dataMode->txPrefixSz > 0)                                                       // prefix, data and EOT are chained TX descriptors (not copied)
+        S__chainTx(dataMode->txPrefixLoc, dataMode->txPrefixSz);
+    if (g_lqLTEM->iop->txEot != 0)
+    {
+        S__chainTx(dataMode->txDataLoc, dataMode->txDataSz);
+        IOP_startTx(&g_lqLTEM->iop->txEot, 1);                                           // EOT queued behind data, sent from IOP storage
+    }
+    else
+        IOP_startTx(dataMode->txDataLoc, dataMode->txDataSz);
 
     uint32_t startTime = pMillis();
+    resultCode_t rslt = resultCode__timeout;
 
-    while (pMillis() - startTime < g_lqLTEM.atcmd->timeout)
+    uint32_t elapsed;
+    while ((elapsed = pMillis() - startTime) < g_lqLTEM->atcmd->timeout)
     {
-        uint16_t trlrIndx = cbffr_find(g_lqLTEM.iop->rxBffr, "OK", 0, 0, true);
-        if(CBFFR_FOUND(trlrIndx))
+        if (S__takeResultLine("OK"))                                                     // OK or SEND OK
+        {
+            rslt = resultCode__success;
+            break;
+        }
+        if (S__takeResultLine("SEND FAIL"))                                              // BGx send buffer full, retried per scktSend policy
+        {
+            g_lqLTEM->atcmd->finalRslt = atcmdFinalRslt_sendFail;
+            rslt = resultCode__cmError;
+            break;
+        }
+        if (S__takeResultLine("ERROR"))                                                  // ERROR or +CME ERROR: <err>
         {
-            cbffr_skipTail(g_lqLTEM.iop->rxBffr, OK_COMPLETED_LENGTH);                  // OK + line-end
-            return resultCode__success;
+            g_lqLTEM->atcmd->finalRslt = atcmdFinalRslt_error;
+            rslt = resultCode__cmError;
+            break;
         }
-        pDelay(1);
+        IOP_awaitRx(g_lqLTEM->atcmd->timeout - elapsed);                                 // sleep until RX or timeout
     }
-    return resultCode__timeout;
+    g_lqLTEM->iop->txEot = 0;                                                            // EOT is single use
+    return rslt;
 }
 
 
@@ -581,18 +1437,25 @@ cmdParseRslt_t atcmd_stdResponseParser(const char *pPreamble, bool preambleReqd,
     uint8_t preambleLen = strlen(pPreamble);
     uint8_t reqdPreambleLen = preambleReqd ? preambleLen : 0;
     uint8_t finaleLen = strlen(pFinale);
-    uint16_t responseLen = strlen(g_lqLTEM.atcmd->rawResponse);
+    uint16_t responseLen = g_lqLTEM->atcmd->rawResponseLen;
+
+    /* Search cursor: chars before parseIndx were searched on a prior pass, a pattern can only be found 
+     * in new chars or straddling into them. Final result codes (error) are matched as chars are received.
+     */
+    uint16_t parseIndx = g_lqLTEM->atcmd->parseIndx;
 
     // always look for error, short-circuit result if CME/CMS
-    char *pErrorLoctn;
-    if ((pErrorLoctn = strstr(g_lqLTEM.atcmd->rawResponse, "+CM")) || (pErrorLoctn = strstr(g_lqLTEM.atcmd->rawResponse, "ERROR")))
+    if (g_lqLTEM->atcmd->finalRslt >= atcmdFinalRslt_firstError)
     {
-        for (size_t i = 0; i < ltem__errorDetailSz; i++)                                // copy raw chars: unknown incoming format, stop at line end
+        char *pErrorLoctn = g_lqLTEM->atcmd->rawResponse + g_lqLTEM->atcmd->finalRsltAt;
+        size_t i = 0;
+        for (; i < ltem__errorDetailSz; i++)                                            // copy raw chars: unknown incoming format, stop at line end
         {
-            if ((pErrorLoctn[i] == '\r' || pErrorLoctn[i] == '\n'))
+            if ((pErrorLoctn[i] == '\r' || pErrorLoctn[i] == '\n' || pErrorLoctn[i] == '\0'))
                 break;;
-            g_lqLTEM.atcmd->errorDetail[i] = pErrorLoctn[i];
+            g_lqLTEM->atcmd->errorDetail[i] = pErrorLoctn[i];
         }
+        g_lqLTEM->atcmd->errorDetail[i] = '\0';
         return cmdParseRslt_error | cmdParseRslt_moduleError;
     }
 
@@ -605,20 +1468,31 @@ cmdParseRslt_t atcmd_stdResponseParser(const char *pPreamble, bool preambleReqd,
      * Search response for preamble, finale, token count (tokensReqd/valueIndx) 
     */
     
-    while (g_lqLTEM.atcmd->response[0] == '\r' || g_lqLTEM.atcmd->response[0] == '\n')
+    while (g_lqLTEM->atcmd->response[0] == '\r' || g_lqLTEM->atcmd->response[0] == '\n')
     {
-        g_lqLTEM.atcmd->response++;                                                     // skip past prefixing line terminators
+        g_lqLTEM->atcmd->response++;                                                     // skip past prefixing line terminators
     }
     
+    g_lqLTEM->atcmd->parseIndx = responseLen;                                           // searches below cover all chars received
+    
     bool preambleSatisfied = false;
     if (preambleLen)                                                                    // if pPreamble provided
     {
-        char *pPreambleLoctn = strstr(g_lqLTEM.atcmd->rawResponse, pPreamble);             // find it in response
-        if (pPreambleLoctn)
+        char *pPreambleLoctn = NULL;
+        if (!g_lqLTEM->atcmd->preambleFound)                                            // found on prior pass, response already set past it
+        {
+            uint16_t searchFrom = (parseIndx >= preambleLen) ? parseIndx - preambleLen + 1 : 0;
+            pPreambleLoctn = strstr(g_lqLTEM->atcmd->rawResponse + searchFrom, pPreamble);  // find it in response
+        }
+        if (g_lqLTEM->atcmd->preambleFound || pPreambleLoctn)
         {
             preambleSatisfied = true;
-            g_lqLTEM.atcmd->preambleFound = true;
-            g_lqLTEM.atcmd->response = pPreambleLoctn + preambleLen;                // remove pPreamble from retResponse
+            if (pPreambleLoctn)
+            {
+                g_lqLTEM->atcmd->preambleFound = true;
+                g_lqLTEM->atcmd->response = pPreambleLoctn + preambleLen;            // remove pPreamble from retResponse
+                parseIndx = 0;                                                          // response start moved, finale search from there
+            }
         }
         else if (preambleReqd)
         {
@@ -631,7 +1505,7 @@ cmdParseRslt_t atcmd_stdResponseParser(const char *pPreamble, bool preambleReqd,
     else
     {
         preambleSatisfied = true;
-        g_lqLTEM.atcmd->preambleFound = false;
+        g_lqLTEM->atcmd->preambleFound = false;
     }
 
     /*  Parse for finale string in response
@@ -648,7 +1522,10 @@ cmdParseRslt_t atcmd_stdResponseParser(const char *pPreamble, bool preambleReqd,
             finaleSatisfied = true;
         else
         {
-            pFinaleLoctn = strstr(g_lqLTEM.atcmd->response, pFinale);
+            char *pSearchFrom = g_lqLTEM->atcmd->response;
+            if (parseIndx >= finaleLen)
+                pSearchFrom = MAX(pSearchFrom, g_lqLTEM->atcmd->rawResponse + parseIndx - finaleLen + 1);
+            pFinaleLoctn = strstr(pSearchFrom, pFinale);
             if (pFinaleLoctn)
             {
                 finaleSatisfied = true;
@@ -665,11 +1542,11 @@ cmdParseRslt_t atcmd_stdResponseParser(const char *pPreamble, bool preambleReqd,
     {
         tokenCnt = 1;
         char *pDelimeterAt;
-        char *pTokenAt = g_lqLTEM.atcmd->response;
+        char *pTokenAt = g_lqLTEM->atcmd->response;
         do
         {
             if (tokenCnt == valueIndx)                                                  // grab value, this is what is requested
-                g_lqLTEM.atcmd->retValue = strtol(pTokenAt, NULL, 0);
+                g_lqLTEM->atcmd->retValue = strtol(pTokenAt, NULL, 0);
 
             pDelimeterAt = strpbrk(pTokenAt, pDelimeters);                              // look for delimeter/next token
             if (tokenCnt >= tokensReqd && tokenCnt >= valueIndx)                        // at/past required token = done
@@ -705,13 +1582,219 @@ cmdParseRslt_t atcmd_stdResponseParser(const char *pPreamble, bool preambleReqd,
 #pragma region Static Function Definitions
 /*-----------------------------------------------------------------------------------------------*/
 
+/**
+ *	@brief Line streaming: deliver response lines from rxBffr to the registered callback, until a final result line.
+ *  @details Lines are delivered without line-end chars. Lines longer than atcmd__lineBufferSz are delivered as segments, 
+ *           with isPartial set on all but the last. Only line ends are searched for, each rxBffr char is examined once.
+ *  @return Parser result, pending until an OK or error line is received.
+ */
+static cmdParseRslt_t S__streamLines()
+{
+    atcmd_t *atcmd = g_lqLTEM->atcmd;
+    cbuffer_t *rxBffr = g_lqLTEM->iop->rxBffr;
+    char lineBffr[atcmd__lineBufferSz];
+
+    while (cbffr_getOccupied(rxBffr) > 0)
+    {
+        uint16_t occupied = cbffr_getOccupied(rxBffr);
+        int16_t lineEnd = cbffr_find(rxBffr, "\n", atcmd->lineScanIndx, 0, false);
+        uint16_t segmentSz;
+
+        if (CBFFR_FOUND(lineEnd))
+            segmentSz = MIN(lineEnd + 1, sizeof(lineBffr) - 1);
+        else if (occupied >= sizeof(lineBffr) - 1)                                     // long line, deliver a segment
+            segmentSz = sizeof(lineBffr) - 1;
+        else
+        {
+            atcmd->lineScanIndx = occupied;                                             // incomplete line, resume search at new chars
+            return cmdParseRslt_pending;
+        }
+        bool isPartial = !CBFFR_FOUND(lineEnd) || segmentSz < lineEnd + 1;
+
+        cbffr_pop(rxBffr, lineBffr, segmentSz);
+        atcmd->lineScanIndx = 0;
+
+        uint16_t lineSz = segmentSz;
+        while (lineSz > 0 && (lineBffr[lineSz - 1] == '\r' || lineBffr[lineSz - 1] == '\n'))
+            lineSz--;
+        lineBffr[lineSz] = '\0';
+
+        bool isLineStart = !atcmd->lineContinues;
+        atcmd->lineContinues = isPartial;
+        if (isLineStart)
+        {
+            if (lineSz == 0)                                                            // blank line separating response sections
+                continue;
+            if (strcmp(lineBffr, "OK") == 0)
+            {
+                strcpy(atcmd->rawResponse, lineBffr);
+                atcmd->rawResponseLen = lineSz;
+                return cmdParseRslt_success;
+            }
+            if (strncmp(lineBffr, "ERROR", 5) == 0 || strncmp(lineBffr, "+CME ERROR", 10) == 0 || strncmp(lineBffr, "+CMS ERROR", 10) == 0)
+            {
+                strncpy(atcmd->errorDetail, lineBffr, ltem__errorDetailSz);
+                atcmd->errorDetail[ltem__errorDetailSz] = '\0';
+                return cmdParseRslt_error | cmdParseRslt_moduleError;
+            }
+        }
+        atcmd->lineRecvCB(atcmd->lineCntxt, lineBffr, lineSz, isPartial);
+    }
+    return cmdParseRslt_pending;
+}
+
+
+/**
+ *	@brief Record completed command's result and execution duration in its verb's metrics.
+ */
+static void S__recordMetrics()
+{
+    atcmd_t *atcmd = g_lqLTEM->atcmd;
+    ltemMetrics_t *metrics = &g_lqLTEM->metrics;
+    atcmdVerb_t verb = atcmdVerb_other;
+
+    if (memcmp(atcmd->cmdStr, "AT+", 3) == 0)                                  // classify by verb: AT+<verb> followed by = ? or \r
+    {
+        const char *verbPtr = atcmd->cmdStr + 3;
+        uint8_t verbLen = strcspn(verbPtr, "=?\r");
+        for (uint8_t v = 1; v < atcmdVerb_cnt; v++)
+        {
+            if (strlen(s_atcmdVerbs[v]) == verbLen && memcmp(verbPtr, s_atcmdVerbs[v], verbLen) == 0)
+            {
+                verb = v;
+                break;
+            }
+        }
+    }
+
+    ltemVerbMetrics_t *verbMetrics = &metrics->verbs[verb];
+    bool failed = atcmd->resultCode != resultCode__success;
+
+    verbMetrics->completed++;
+    if (atcmd->resultCode == resultCode__timeout)
+        verbMetrics->timeouts++;
+    else if (atcmd->resultCode == resultCode__cmError)
+        verbMetrics->cmErrors++;
+    if (verb != atcmdVerb_other && verb == metrics->lastVerb && metrics->lastFailed)
+        verbMetrics->retries++;
+    metrics->lastVerb = verb;
+    metrics->lastFailed = failed;
+
+    uint8_t bucket = 0;                                                         // log2 bucket: bit length of duration
+    for (uint32_t duration = atcmd->execDuration; duration && bucket < metrics__durationBuckets - 1; duration >>= 1)
+        bucket++;
+    if (verbMetrics->durationHist[bucket] < UINT16_MAX)                         // saturate
+        verbMetrics->durationHist[bucket]++;
+    verbMetrics->maxDuration = MAX(verbMetrics->maxDuration, atcmd->execDuration);
+}
+
+
+/**
+ *	@brief Returns the retry error code for a completed command, 0 if the command succeeded.
+ */
+static uint16_t S__retryCode(resultCode_t rslt)
+{
+    if (rslt == resultCode__success)
+        return (uint16_t)g_lqLTEM->atcmd->retValue;                                     // command reported result (0 = success)
+
+    if (rslt == resultCode__cmError)
+    {
+        if (g_lqLTEM->atcmd->finalRslt == atcmdFinalRslt_sendFail)
+            return resultCode__tooManyRequests;
+        return atcmd_getErrorDetailCode();
+    }
+    return rslt;
+}
+
+
+/**
+ *	@brief Returns a pseudo-random value from 0 to range (inclusive) for retry backoff jitter.
+ *  @details Seed is stirred with the millisecond clock so devices recovering from a common outage diverge.
+ */
+static uint16_t S__retryJitter(uint16_t range)
+{
+    uint32_t seed = g_lqLTEM->atcmd->retryJitterSeed * 1103515245 + 12345 + pMillis();    // LCG
+    g_lqLTEM->atcmd->retryJitterSeed = seed;
+    return range ? (seed >> 16) % (range + 1) : 0;
+}
+
+
+/**
+ *	@brief Count of chars at the rxBffr head that start the data mode trigger, held until the trigger is complete.
+ *  @return Chars of a partially received trigger, 0 if the rxBffr head cannot be the start of the trigger.
+ */
+static uint16_t S__dataModeTriggerPartial()
+{
+    char triggerStart[atcmd__dataModeTriggerSz];
+    uint16_t occupied = cbffr_getOccupied(g_lqLTEM->iop->rxBffr);
+    uint16_t partialSz = MIN(strlen(g_lqLTEM->atcmd->dataMode.trigger) - 1, occupied);
+
+    for (; partialSz > 0; partialSz--)                                                          // longest partial first
+    {
+        memcpy(triggerStart, g_lqLTEM->atcmd->dataMode.trigger, partialSz);
+        triggerStart[partialSz] = '\0';
+        if (cbffr_find(g_lqLTEM->iop->rxBffr, triggerStart, occupied - partialSz, 0, false) == occupied - partialSz)
+            break;
+    }
+    return partialSz;
+}
+
+
+/* Final result code patterns, indexed by atcmdFinalRslt_t. None of these patterns has a proper prefix that is also
+ * a suffix (other than their first char), so a mismatch restarts the pattern at 0 or 1 matched chars without backtracking.
+ */
+static const char * const s_finalRsltPatterns[atcmdFinalRslt_cnt] = { "", "SEND OK\r\n", "OK\r\n", "+CME ERROR", "+CMS ERROR", "ERROR", "NO CARRIER", "SEND FAIL\r\n" };
+
+
+/**
+ *	@brief Multi-pattern match of BGx final result codes over newly received response chars, each char is examined once.
+ *  @details Matcher state is kept in atcmd so a pattern can span receive chunks. An error result is not superseded.
+ *  @param scanFrom [in] Offset in rawResponse of the first new char.
+ */
+static void S__scanFinalResult(uint16_t scanFrom)
+{
+    atcmd_t *atcmd = g_lqLTEM->atcmd;
+
+    for (uint16_t i = scanFrom; i < atcmd->rawResponseLen; i++)
+    {
+        char rxChar = atcmd->rawResponse[i];
+        atcmdFinalRslt_t matched = atcmdFinalRslt_none;
+
+        for (uint8_t p = 1; p < atcmdFinalRslt_cnt; p++)
+        {
+            const char *pattern = s_finalRsltPatterns[p];
+            uint8_t matchLen = atcmd->finalMatchLen[p];
+
+            if (pattern[matchLen] == rxChar)
+                matchLen++;
+            else
+                matchLen = (pattern[0] == rxChar) ? 1 : 0;
+
+            if (pattern[matchLen] == '\0')                                     // pattern complete
+            {
+                if (matched == atcmdFinalRslt_none)                             // 1st (longest) pattern completing on this char
+                    matched = p;
+                matchLen = 0;
+            }
+            atcmd->finalMatchLen[p] = matchLen;
+        }
+
+        if (matched != atcmdFinalRslt_none && atcmd->finalRslt < atcmdFinalRslt_firstError)
+        {
+            atcmd->finalRslt = matched;
+            atcmd->finalRsltAt = i + 1 - strlen(s_finalRsltPatterns[matched]);
+        }
+    }
+}
+
+
 
 // /**
 //  *	@brief register a stream peer with IOP to control communications. Typically performed by protocol open.
 //  */
 // void ATCMD_registerStream(uint8_t streamIndx, iopStreamCtrl_t *streamCtrl)
 // {
-//     g_lqLTEM.atcmd->streamPeers[streamIndx] = streamCtrl;
+//     g_lqLTEM->atcmd->streamPeers[streamIndx] = streamCtrl;
 // }
 
 
@@ -725,7 +1808,7 @@ cmdParseRslt_t atcmd_stdResponseParser(const char *pPreamble, bool preambleReqd,
 //     char *foundAt;
 //     // /* SSL/TLS data received
 //     // */
-//     // if (g_lqLTEM.iop->scktMap > 0 && (foundAt = strstr(urcBffr, "+QSSLURC: \"recv\",")))         // shortcircuit if no sockets
+//     // if (g_lqLTEM->iop->scktMap > 0 && (foundAt = strstr(urcBffr, "+QSSLURC: \"recv\",")))         // shortcircuit if no sockets
 //     // {
 //     //     PRINTF(dbgColor__cyan, "-p=sslURC");
 //     //     uint8_t urcLen = strlen("+QSSLURC: \"recv\",");
@@ -733,27 +1816,27 @@ cmdParseRslt_t atcmd_stdResponseParser(const char *pPreamble, bool preambleReqd,
 //     //     char *endPtr = NULL;
 //     //     uint8_t cntxtId = (uint8_t)strtol(cntxtIdPtr, &endPtr, 10);
 //     //     // action
-//     //     ((scktCtrl_t *)g_lqLTEM.iop->streamPeers[cntxtId])->dataPending = true;
+//     //     ((scktCtrl_t *)g_lqLTEM->iop->streamPeers[cntxtId])->dataPending = true;
 //     //     // clean up
-//     //     g_lqLTEM.iop->rxCBuffer->head - (endPtr - urcBffr);                                     // remove URC from rxBuffer
-//     //     memset(g_lqLTEM.iop->urcDetectBuffer, 0, IOP__urcDetectBufferSz);
+//     //     g_lqLTEM->iop->rxCBuffer->head - (endPtr - urcBffr);                                     // remove URC from rxBuffer
+//     //     memset(g_lqLTEM->iop->urcDetectBuffer, 0, IOP__urcDetectBufferSz);
 //     // }
 
 //     // // preserve temporarily Nov29-2022
-//     // // else if (g_lqLTEM.iop->scktMap && memcmp("+QIURC: \"recv", urcStartPtr, strlen("+QIURC: \"recv")) == 0)         // shortcircuit if no sockets
+//     // // else if (g_lqLTEM->iop->scktMap && memcmp("+QIURC: \"recv", urcStartPtr, strlen("+QIURC: \"recv")) == 0)         // shortcircuit if no sockets
 //     // // {
 //     // //     PRINTF(dbgColor__cyan, "-p=ipURC");
-//     // //     char *cntxIdPtr = g_lqLTEM.iop->rxCBuffer->prevHead + strlen("+QIURC: \"recv");
+//     // //     char *cntxIdPtr = g_lqLTEM->iop->rxCBuffer->prevHead + strlen("+QIURC: \"recv");
 //     // //     char *endPtr = NULL;
 //     // //     uint8_t cntxId = (uint8_t)strtol(cntxIdPtr, &endPtr, 10);
-//     // //     ((scktCtrl_t *)g_lqLTEM.iop->streamPeers[cntxId])->dataPending = true;
+//     // //     ((scktCtrl_t *)g_lqLTEM->iop->streamPeers[cntxId])->dataPending = true;
 //     // //     // discard this chunk, processed here
-//     // //     g_lqLTEM.iop->rxCBuffer->head = g_lqLTEM.iop->rxCBuffer->prevHead;
+//     // //     g_lqLTEM->iop->rxCBuffer->head = g_lqLTEM->iop->rxCBuffer->prevHead;
 //     // // }
 
 //     // /* TCP/UDP data received
 //     // */
-//     // else if (g_lqLTEM.iop->scktMap && (foundAt = strstr(urcBffr, "+QIURC: \"recv\",")))         // shortcircuit if no sockets
+//     // else if (g_lqLTEM->iop->scktMap && (foundAt = strstr(urcBffr, "+QIURC: \"recv\",")))         // shortcircuit if no sockets
 //     // {
 //     //     PRINTF(dbgColor__cyan, "-p=ipURC");
 //     //     uint8_t urcLen = strlen("+QIURC: \"recv\",");
@@ -761,15 +1844,15 @@ cmdParseRslt_t atcmd_stdResponseParser(const char *pPreamble, bool preambleReqd,
 //     //     char *endPtr = NULL;
 //     //     uint8_t cntxtId = (uint8_t)strtol(cntxtIdPtr, &endPtr, 10);
 //     //     // action
-//     //     ((scktCtrl_t *)g_lqLTEM.iop->streamPeers[cntxtId])->dataPending = true;
+//     //     ((scktCtrl_t *)g_lqLTEM->iop->streamPeers[cntxtId])->dataPending = true;
 //     //     // clean up
-//     //     g_lqLTEM.iop->rxCBuffer->head - (endPtr - urcBffr);                                     // remove URC from rxBuffer
-//     //     memset(g_lqLTEM.iop->urcDetectBuffer, 0, IOP__urcDetectBufferSz);
+//     //     g_lqLTEM->iop->rxCBuffer->head - (endPtr - urcBffr);                                     // remove URC from rxBuffer
+//     //     memset(g_lqLTEM->iop->urcDetectBuffer, 0, IOP__urcDetectBufferSz);
 //     // }
 
 //     // /* MQTT message receive
 //     // */
-//     // else if (g_lqLTEM.iop->mqttMap && (foundAt = strstr(urcBffr, "+QMTRECV: ")))
+//     // else if (g_lqLTEM->iop->mqttMap && (foundAt = strstr(urcBffr, "+QMTRECV: ")))
 //     // {
 //     //     PRINTF(dbgColor__cyan, "-p=mqttR");
 //     //     uint8_t urcLen = strlen("+QMTRECV: ");
@@ -778,29 +1861,29 @@ cmdParseRslt_t atcmd_stdResponseParser(const char *pPreamble, bool preambleReqd,
 //     //     uint8_t cntxtId = (uint8_t)strtol(cntxtIdPtr, &endPtr, 10);
 
 //     //     // action
-//     //     ASSERT(g_lqLTEM.iop->rxStreamCtrl == NULL);                                // ASSERT: not inside another stream recv
+//     //     ASSERT(g_lqLTEM->iop->rxStreamCtrl == NULL);                                // ASSERT: not inside another stream recv
 
 //     //     /* this chunk, contains both meta data for receive followed by actual data, need to copy the data chunk to start of rxDataBuffer for this context */
 
-//     //     g_lqLTEM.iop->rxStreamCtrl = g_lqLTEM.iop->streamPeers[cntxtId];                                // put IOP in datamode for context 
-//     //     rxDataBufferCtrl_t *dBufPtr = &g_lqLTEM.iop->rxStreamCtrl->recvBufCtrl;                         // get reference to context specific data RX buffer
+//     //     g_lqLTEM->iop->rxStreamCtrl = g_lqLTEM->iop->streamPeers[cntxtId];                                // put IOP in datamode for context 
+//     //     rxDataBufferCtrl_t *dBufPtr = &g_lqLTEM->iop->rxStreamCtrl->recvBufCtrl;                         // get reference to context specific data RX buffer
         
 //     //     /* need to fixup core/cmd and data buffers for mixed content in receive
 //     //      * moving post prefix received from core/cmd buffer to context data buffer
 //     //      * preserving prefix text for overflow detection (prefix & trailer text must be in same buffer)
 //     //      */
-//     //     char *urcStartPtr = memchr(g_lqLTEM.iop->rxCBuffer->prevHead, '+', g_lqLTEM.iop->rxCBuffer->head - g_lqLTEM.iop->rxCBuffer->prevHead);  
-//     //     memcpy(dBufPtr->pages[dBufPtr->iopPg]._buffer, urcStartPtr, g_lqLTEM.iop->rxCBuffer->head - urcStartPtr);
-//     //     dBufPtr->pages[dBufPtr->iopPg].head += g_lqLTEM.iop->rxCBuffer->head - urcStartPtr;
+//     //     char *urcStartPtr = memchr(g_lqLTEM->iop->rxCBuffer->prevHead, '+', g_lqLTEM->iop->rxCBuffer->head - g_lqLTEM->iop->rxCBuffer->prevHead);  
+//     //     memcpy(dBufPtr->pages[dBufPtr->iopPg]._buffer, urcStartPtr, g_lqLTEM->iop->rxCBuffer->head - urcStartPtr);
+//     //     dBufPtr->pages[dBufPtr->iopPg].head += g_lqLTEM->iop->rxCBuffer->head - urcStartPtr;
 
 //     //     // clean-up
-//     //     g_lqLTEM.iop->rxCBuffer->head = urcStartPtr;                                                    // drop recv'd from cmd\core buffer, processed here
-//     //     memset(g_lqLTEM.iop->urcDetectBuffer, 0, IOP__urcDetectBufferSz);
+//     //     g_lqLTEM->iop->rxCBuffer->head = urcStartPtr;                                                    // drop recv'd from cmd\core buffer, processed here
+//     //     memset(g_lqLTEM->iop->urcDetectBuffer, 0, IOP__urcDetectBufferSz);
 //     // }
 
 //     // /* MQTT connection reset by server
 //     // */
-//     // else if (g_lqLTEM.iop->mqttMap &&
+//     // else if (g_lqLTEM->iop->mqttMap &&
 //     //          (foundAt = MAX(strstr(urcBffr, "+QMTSTAT: "), strstr(urcBffr, "+QMTDISC: "))))
 //     // {
 //     //     PRINTF(dbgColor__cyan, "-p=mqttS");
@@ -809,11 +1892,11 @@ cmdParseRslt_t atcmd_stdResponseParser(const char *pPreamble, bool preambleReqd,
 //     //     char *endPtr = NULL;
 //     //     uint8_t cntxId = (uint8_t)strtol(cntxtIdPtr, &endPtr, 10);
 //     //     // action
-//     //     g_lqLTEM.iop->mqttMap &= ~(0x01 << cntxId);
-//     //     ((mqttCtrl_t *)g_lqLTEM.iop->streamPeers[cntxId])->state = mqttState_closed;
+//     //     g_lqLTEM->iop->mqttMap &= ~(0x01 << cntxId);
+//     //     ((mqttCtrl_t *)g_lqLTEM->iop->streamPeers[cntxId])->state = mqttState_closed;
 //     //     // clean up
-//     //     g_lqLTEM.iop->rxCBuffer->head - (endPtr - urcBffr);                                     // remove URC from rxBuffer
-//     //     memset(g_lqLTEM.iop->urcDetectBuffer, 0, IOP__urcDetectBufferSz);
+//     //     g_lqLTEM->iop->rxCBuffer->head - (endPtr - urcBffr);                                     // remove URC from rxBuffer
+//     //     memset(g_lqLTEM->iop->urcDetectBuffer, 0, IOP__urcDetectBufferSz);
 //     // }
 
 //     // /* PDP context closed by network
@@ -826,17 +1909,17 @@ cmdParseRslt_t atcmd_stdResponseParser(const char *pPreamble, bool preambleReqd,
 //     //     char *endPtr = NULL;
 //     //     uint8_t contextId = (uint8_t)strtol(pdpCntxtIdPtr, &endPtr, 10);
 //     //     // action
-//     //     for (size_t i = 0; i <  sizeof(g_lqLTEM.providerInfo->networks) / sizeof(providerInfo_t); i++)
+//     //     for (size_t i = 0; i <  sizeof(g_lqLTEM->providerInfo->networks) / sizeof(providerInfo_t); i++)
 //     //     {
-//     //         if (g_lqLTEM.providerInfo->networks[i].pdpContextId == contextId)
+//     //         if (g_lqLTEM->providerInfo->networks[i].pdpContextId == contextId)
 //     //         {
-//     //             g_lqLTEM.providerInfo->networks[i].pdpContextId = 0;
-//     //             g_lqLTEM.providerInfo->networks[i].ipAddress[0] = 0;
+//     //             g_lqLTEM->providerInfo->networks[i].pdpContextId = 0;
+//     //             g_lqLTEM->providerInfo->networks[i].ipAddress[0] = 0;
 //     //             break;
 //     //         }
 //     //     }
 //     //     // clean-up
-//     //     g_lqLTEM.iop->rxCBuffer->head - (endPtr - urcBffr);                                     // remove URC from rxBuffer
+//     //     g_lqLTEM->iop->rxCBuffer->head - (endPtr - urcBffr);                                     // remove URC from rxBuffer
 //     // }
 // }
 
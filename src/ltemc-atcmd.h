@@ -32,12 +32,23 @@
 extern "C" {
 #endif
 
-// /**
-//  *	@brief Sets options for BGx AT command control (atcmd). 
-//  *  @param timeoutMS [in] Number of milliseconds the action can take. Use system default ACTION_TIMEOUTms or your value.
-//  *  @param cmdResponseParser [in] Custom command response parser to signal result is complete. NULL for std parser.
-//  */
-// void atcmd_setOptions(uint32_t timeoutMS, cmdResponseParser_func cmdResponseParser);
+/**
+ *	@brief Sets options for the invoked BGx AT command (atcmd). Options revert to defaults when the command completes.
+ *  @param timeoutMS [in] Number of milliseconds the action can take. Use atcmd__noTimeoutChange for the default or your value.
+ *  @param cmdResponseParser [in] Custom command response parser to signal result is complete. NULL for std parser.
+ */
+void atcmd_setOptions(uint32_t timeoutMS, cmdResponseParser_func cmdResponseParser);
+
+
+/**
+ *	@brief Sets line streaming mode for the invoked BGx AT command, for responses larger than the atcmd response buffer.
+ *  @details Each response line is passed to lineRecvCB directly from the receive buffer as it arrives (line-end chars removed), 
+ *           the response is not accumulated. Command completes on an OK or ERROR line. Lines longer than atcmd__lineBufferSz 
+ *           are passed in segments, isPartial is set when more of the line follows. Mode reverts when the command completes.
+ *  @param lineRecvCB [in] Callback receiving response lines.
+ *  @param lineCntxt [in] Caller context passed to lineRecvCB (result structure, etc.)
+ */
+void atcmd_setLineStreaming(atcmdLineRecv_func lineRecvCB, void *lineCntxt);
 
 
 /**
@@ -68,6 +79,15 @@ void atcmd_configDataMode(uint16_t contextKey, const char* trigger, dataRxHndlr_
  */
 void atcmd_configDataModeEot(uint8_t eotChar);
 
+/**
+ * @brief Set a block sent ahead of the dataMode TX data (ex: application framing header), set following atcmd_configDataMode().
+ * @details Prefix and data are chained as TX descriptors, neither is copied; both must remain valid until the command completes.
+ * 
+ * @param prefix Prefix chars, NULL for no prefix.
+ * @param prefixSz Number of prefix chars.
+ */
+void atcmd_configDataModePrefix(const char *prefix, uint16_t prefixSz);
+
 
 /**
  *	@brief Invokes a BGx AT command using default option values (automatic locking).
@@ -78,6 +98,28 @@ void atcmd_configDataModeEot(uint8_t eotChar);
 bool atcmd_tryInvoke(const char *cmdTemplate, ...);
 
 
+/**
+ *	@brief Invokes a precompiled (descriptor) BGx AT command using default option values (automatic locking).
+ *  @details Arguments are formatted into the descriptor's typed slots by the atcmd integer/string formatter, no printf.
+ *	@param [in] cmd The command descriptor.
+ *  @param [in] variadic "..." arguments for the descriptor slots, int or char* as documented in atcmdCmd_t.
+ *  @return True if action was invoked, false if not
+ */
+bool atcmd_tryInvokeCmd(atcmdCmd_t cmd, ...);
+
+
+/**
+ *	@brief Invokes a BGx AT command (automatic locking) with options and returns immediately; use atcmd_poll() to complete it.
+ *  @details For cooperative main loops: the command result is collected by calling atcmd_poll() until it returns a final result.
+ *  @param [in] timeoutMS Command timeout, atcmd__noTimeoutChange for the default timeout.
+ *  @param [in] cmdResponseParser Parser for the command response, NULL for the standard OK parser.
+ *	@param [in] cmdTemplate The command string to send to the BGx module.
+ *  @param [in] variadic "..." parameter list to integrate into the cmdTemplate.
+ *  @return True if action was invoked, false if not (command lock is held)
+ */
+bool atcmd_invokeAsync(uint32_t timeoutMS, cmdResponseParser_func cmdResponseParser, const char *cmdTemplate, ...);
+
+
 /**
  *	@brief Invokes a BGx AT command without acquiring a lock, using previously set setOptions() values.
  *	@param cmdStrTemplate [in] The command string to send to the BG96 module.
@@ -86,12 +128,139 @@ bool atcmd_tryInvoke(const char *cmdTemplate, ...);
 void atcmd_invokeReuseLock(const char *cmdTemplate, ...);
 
 
+/**
+ *	@brief Invokes a precompiled (descriptor) BGx AT command without acquiring a lock, using previously set setOptions() values.
+ *	@param cmd [in] The command descriptor.
+ *  @param ... [in] Arguments for the descriptor slots, int or char* as documented in atcmdCmd_t.
+ */
+void atcmd_invokeReuseLockCmd(atcmdCmd_t cmd, ...);
+
+
 /**
  *	@brief Closes (completes) a BGx AT command structure and frees action resource (release action lock).
  */
 void atcmd_close();
 
 
+/**
+ *	@brief Queues a BGx AT command for pipelined execution. The command is sent as soon as the prior command's final result is 
+ *         received, without waiting for the application to await each result.
+ *  @details Waits for a free queue slot if the queue is full. Queue is serviced by ltem_eventMgr() and atcmd_awaitQueue().
+ *           Queued commands continue following a failed command, see atcmd_awaitQueue() for the first failure.
+ *  @param [in] responseParser Parser for the command response, NULL for the standard OK parser.
+ *  @param [in] timeoutMS Command timeout, atcmd__noTimeoutChange for the default timeout.
+ *  @param [in] completionCB Optional callback invoked with the command's result code and response; keep brief, the next command is sent after it returns.
+ *	@param [in] cmdTemplate The command string template (max atcmd__queueCmdSz - 2 chars when formatted).
+ *  @param [in] variadic "..." parameter list to integrate into the cmdTemplate.
+ */
+void atcmd_enqueue(cmdResponseParser_func responseParser, uint32_t timeoutMS, atcmdCompletion_func completionCB, const char *cmdTemplate, ...);
+
+
+/**
+ *	@brief Waits for all queued AT commands to complete.
+ *  @return Success if all queued commands succeeded, otherwise the result code of the first failed command.
+ */
+resultCode_t atcmd_awaitQueue();
+
+
+/**
+ *	@brief Initializes an AT command batch. A batch joins settings commands with ';' into one command line (up to 
+ *         atcmd__batchLineSz chars), removing a BGx round trip for each joined command.
+ *  @param [out] batch The batch to initialize.
+ *  @param [in] timeoutMS Timeout for each command, atcmd__noTimeoutChange for the default timeout.
+ */
+void atcmd_batchInit(atcmdBatch_t *batch, uint32_t timeoutMS);
+
+
+/**
+ *	@brief Adds a command to an AT command batch.
+ *  @details Extended (AT+) commands are joined to the batch line, other commands (ex: ATE0) are sent alone. If the command 
+ *           will not fit, the batch line is sent (blocking) and a new line started. Batched commands must complete with OK 
+ *           and not require data mode or a specialized response parser. Batching continues following a failed command.
+ *  @param [in,out] batch The batch to add the command to.
+ *	@param [in] cmdTemplate The command string template (max atcmd__batchLineSz - 3 chars when formatted).
+ *  @param [in] variadic "..." parameter list to integrate into the cmdTemplate.
+ */
+void atcmd_batchAdd(atcmdBatch_t *batch, const char *cmdTemplate, ...);
+
+
+/**
+ *	@brief Adds a modem setting command to an AT command batch, the command is skipped if the setting value is already in 
+ *         effect (see atcmd_applySetting()).
+ *  @param [in,out] batch The batch to add the command to.
+ *  @param [in] keyParams Count of leading command parameters identifying the setting (ex: 2 for AT+QSSLCFG="seclevel",<cntxt>,<level>).
+ *	@param [in] cmdTemplate The command string template (max atcmd__batchLineSz - 3 chars when formatted).
+ *  @param [in] variadic "..." parameter list to integrate into the cmdTemplate.
+ */
+void atcmd_batchAddSetting(atcmdBatch_t *batch, uint8_t keyParams, const char *cmdTemplate, ...);
+
+
+/**
+ *	@brief Sends any commands remaining in an AT command batch (blocking) and returns the batch result.
+ *  @details On a failed line the commands are resent individually, batch->failedCmd reports the first failed command.
+ *  @param [in,out] batch The batch to execute.
+ *  @return Success if all batched commands succeeded, otherwise the result code of the first failed command.
+ */
+resultCode_t atcmd_batchExec(atcmdBatch_t *batch);
+
+
+/**
+ *	@brief Replaces the retry policy for a command class of the bound device. Policies are copied, defaults apply until replaced.
+ *  @param [in] retryClass The command class.
+ *  @param [in] policy The new policy for the class.
+ */
+void atcmd_setRetryPolicy(atcmdRetryClass_t retryClass, const atcmdRetryPolicy_t *policy);
+
+
+/**
+ *	@brief Returns the retry policy in effect for a command class.
+ *  @param [in] retryClass The command class.
+ *  @return Pointer to the class policy (read only).
+ */
+const atcmdRetryPolicy_t *atcmd_getRetryPolicy(atcmdRetryClass_t retryClass);
+
+
+/**
+ *	@brief Starts retry tracking for a command sequence, call before the first attempt.
+ *  @param [out] retry The retry state to initialize.
+ *  @param [in] retryClass The command class, selects the retry policy.
+ */
+void atcmd_retryInit(atcmdRetry_t *retry, atcmdRetryClass_t retryClass);
+
+
+/**
+ *	@brief Evaluates a completed attempt against the class retry policy, waiting out the backoff if the attempt is to be retried.
+ *  @details Call with the atcmd result (before any mapping), the attempt's error code is taken from the completed command. 
+ *           A retry is made if the code is in the policy's retry codes and attempts and deadline allow. The backoff is 
+ *           exponential with jitter (half fixed, half random) to spread retries from devices recovering from a common outage.
+ *  @param [in,out] retry The retry state.
+ *  @param [in] rslt Result of the attempt.
+ *  @return True if the command should be invoked again.
+ */
+bool atcmd_retryAgain(atcmdRetry_t *retry, resultCode_t rslt);
+
+
+/**
+ *	@brief Applies a modem setting (blocking, automatic locking), the BGx write is skipped if the setting value is already in effect.
+ *  @details Settings applied are shadowed (keyed by command and leading parameters), the shadow is cleared on BGx reset or APP RDY.
+ *  @param [in] keyParams Count of leading command parameters identifying the setting (ex: 1 for AT+QCFG="nwscanmode",<mode>).
+ *	@param [in] cmdTemplate The command string template (max atcmd__queueCmdSz - 2 chars when formatted).
+ *  @param [in] variadic "..." parameter list to integrate into the cmdTemplate.
+ *  @return Success if setting applied or already in effect, otherwise the command result code.
+ */
+resultCode_t atcmd_applySetting(uint8_t keyParams, const char *cmdTemplate, ...);
+
+
+/**
+ *	@brief Applies a modem setting within an existing lock (blocking), the BGx write is skipped if the setting value is already in effect.
+ *  @param [in] keyParams Count of leading command parameters identifying the setting.
+ *	@param [in] cmdTemplate The command string template (max atcmd__queueCmdSz - 2 chars when formatted).
+ *  @param [in] variadic "..." parameter list to integrate into the cmdTemplate.
+ *  @return Success if setting applied or already in effect, otherwise the command result code.
+ */
+resultCode_t atcmd_applySettingReuseLock(uint8_t keyParams, const char *cmdTemplate, ...);
+
+
 // /**
 //  *	@brief Performs blind send data transfer to device.
 //  *  @details ASSERTS atcmd lock; does not change lock state.
@@ -109,6 +278,13 @@ void atcmd_close();
 resultCode_t atcmd_awaitResult();
 
 
+/**
+ *	@brief Performs one non-blocking step of result processing for the invoked command, the resumable form of atcmd_awaitResult().
+ *  @return resultCode__unknown while the command is pending, otherwise the command's final result code.
+ */
+resultCode_t atcmd_poll();
+
+
 /**
  *	@brief Waits for atcmd result, periodically checking recv buffer for valid response until timeout.
  *  @param timeoutMS Time to wait for command response (0==no change). 
@@ -180,6 +356,14 @@ uint16_t atcmd_getErrorDetailCode();
 uint32_t atcmd_getDuration();
 
 
+/**
+ *	@brief Returns the AT command verb name for a metrics verb (see ltem_getMetrics()).
+ *  @param verb [in] The metrics verb.
+ *  @return Verb name without the AT+ prefix (ex: "QIOPEN"), "" for atcmdVerb_other.
+ */
+const char *atcmd_getVerbName(atcmdVerb_t verb);
+
+
 /**
  *	@brief Sends ^Z character to ensure BGx is not in text mode.
  */
@@ -44,8 +44,6 @@
 #include "ltemc-internal.h"
 #include "ltemc-files.h"
 
-extern ltemDevice_t g_lqLTEM;
-
 
 #define MIN(x, y) (((x) < (y)) ? (x) : (y))
 #define MAX(X, Y) (((X) > (Y)) ? (X) : (Y))
@@ -53,6 +51,7 @@ extern ltemDevice_t g_lqLTEM;
 /* Local Static Functions
 ------------------------------------------------------------------------------------------------------------------------- */
 static cmdParseRslt_t S__writeStatusParser();
+static void S__filelistLineRecv(void *lineCntxt, const char *line, uint16_t lineSz, bool isPartial);
 static resultCode_t S__filesRxHndlr();
 
 
@@ -64,9 +63,9 @@ void file_setAppReceiver(fileReceiver_func fileReceiver)
 {
     ASSERT(fileReceiver != NULL);                                           // assert user provided receiver function
 
-    g_lqLTEM.fileCtrl->streamType = streamType_file;                        // init singleton fileCtrl
-    g_lqLTEM.fileCtrl->dataRxHndlr = S__filesRxHndlr;
-    g_lqLTEM.fileCtrl->appRecvDataCB = fileReceiver;
+    g_lqLTEM->fileCtrl->streamType = streamType_file;                        // init singleton fileCtrl
+    g_lqLTEM->fileCtrl->dataRxHndlr = S__filesRxHndlr;
+    g_lqLTEM->fileCtrl->appRecvDataCB = fileReceiver;
 }
 
 
@@ -86,7 +85,7 @@ resultCode_t file_getFSInfo(filesysInfo_t * fsInfo)
         // first get file system info
         atcmd_invokeReuseLock("AT+QFLDS=\"UFS\"");
         rslt = atcmd_awaitResult();
-        if (rslt != RESULT_CODE_SUCCESS)
+        if (rslt != resultCode__success)
         {
             break;
         }
@@ -126,6 +125,7 @@ resultCode_t file_getFilelist(fileListResult_t *fileList, const char* filename)
             break;
         }
 
+        fileList->fileCnt = 0;
         if (strlen(filename) == 0)
         {
             fileList->namePattern[0] = '*';
@@ -137,29 +137,8 @@ resultCode_t file_getFilelist(fileListResult_t *fileList, const char* filename)
             strncpy(fileList->namePattern, filename, MIN(strlen(filename), file__filenameSz));
             atcmd_invokeReuseLock("AT+QFLST=\"%s\"", fileList->namePattern);
         }
+        atcmd_setLineStreaming(S__filelistLineRecv, fileList);              // list can exceed atcmd response buffer, parse by line
         rslt = atcmd_awaitResult();
-        if (rslt != RESULT_CODE_SUCCESS)
-            break;
-
-        // parse response >>  +QFLST: <filename>,<file_size>
-        uint8_t lineNm = 0;
-        char *workPtr = atcmd_getResponse();
-
-        for (size_t i = 0; i < file__fileListMaxCnt; i++)
-        {
-            workPtr += 9;
-            uint8_t len = strchr(workPtr, '"') - workPtr;
-            strncpy(fileList->files[i].filename, workPtr, len);
-            workPtr += len + 2;
-            fileList->files[i].fileSz = strtol(workPtr, &workPtr, 10);
-
-            workPtr += 2;
-            if (*workPtr != '+')
-            {
-                fileList->fileCnt = ++i;
-                break;
-            }
-        }
     } while (0);
 
     atcmd_close();
@@ -240,7 +219,7 @@ resultCode_t file_getOpenFiles(char *fileInfo, uint16_t fileInfoSz)
  */
 resultCode_t file_close(uint16_t fileHandle)
 {
-    if (atcmd_tryInvoke("AT+QFCLOSE=%d", fileHandle))
+    if (atcmd_tryInvokeCmd(atcmdCmd_qfclose, fileHandle))
     {
         return atcmd_awaitResult();
     }
@@ -279,18 +258,18 @@ resultCode_t file_closeAll()
 resultCode_t file_read(uint16_t fileHandle, uint16_t readSz)
 {
     resultCode_t rslt = resultCode__success;
-    ASSERT(g_lqLTEM.fileCtrl->appRecvDataCB);                                   // assert that there is a app func registered to receive read data
+    ASSERT(g_lqLTEM->fileCtrl->appRecvDataCB);                                   // assert that there is a app func registered to receive read data
 
     if (readSz > 0)
-        rslt = atcmd_tryInvoke("AT+QFREAD=%d,%d", fileHandle, readSz);
+        rslt = atcmd_tryInvokeCmd(atcmdCmd_qfread, fileHandle, readSz);
     else
         rslt = atcmd_tryInvoke("AT+QFREAD=%d", fileHandle);
 
     if (rslt)
     {
-        atcmd_configDataMode(0, "CONNECT", S__filesRxHndlr, NULL, 0, g_lqLTEM.fileCtrl->appRecvDataCB, true);
-        // atcmd_setStreamControl("CONNECT", g_lqLTEM.fileCtrl);
-        g_lqLTEM.fileCtrl->handle = fileHandle;
+        atcmd_configDataMode(0, "CONNECT", S__filesRxHndlr, NULL, 0, g_lqLTEM->fileCtrl->appRecvDataCB, true);
+        // atcmd_setStreamControl("CONNECT", g_lqLTEM->fileCtrl);
+        g_lqLTEM->fileCtrl->handle = fileHandle;
         return atcmd_awaitResult() == resultCode__success;                     // dataHandler will be invoked by atcmd module and return a resultCode
     }
     return resultCode__conflict;
@@ -308,7 +287,7 @@ resultCode_t file_write(uint16_t fileHandle, const char* writeData, uint16_t wri
     do
     {
         atcmd_configDataMode(0, "CONNECT", atcmd_stdTxDataHndlr, writeData, writeSz, NULL, false);
-        atcmd_invokeReuseLock("AT+QFWRITE=%d,%d", fileHandle, writeSz);
+        atcmd_invokeReuseLockCmd(atcmdCmd_qfwrite, fileHandle, writeSz);
         rslt = atcmd_awaitResult();
         if (rslt == resultCode__success)                                                        // "CONNECT" prompt result
         {
@@ -334,7 +313,7 @@ resultCode_t file_write(uint16_t fileHandle, const char* writeData, uint16_t wri
  */
 resultCode_t file_seek(uint16_t fileHandle, uint32_t offset, fileSeekMode_t seekFrom)
 {
-    if (atcmd_tryInvoke("AT+QFSEEK=%d,%d,%d", fileHandle, offset, seekFrom))
+    if (atcmd_tryInvokeCmd(atcmdCmd_qfseek, fileHandle, offset, seekFrom))
     {
         return atcmd_awaitResult();
     }
@@ -366,7 +345,7 @@ resultCode_t file_getPosition(uint16_t fileHandle, uint32_t* filePtr)
  */
 resultCode_t file_truncate(uint16_t fileHandle)
 {
-    if (atcmd_tryInvokeAdv("AT+QFTUCAT=%d", fileHandle))
+    if (atcmd_tryInvoke("AT+QFTUCAT=%d", fileHandle))
     {
         return atcmd_awaitResult();
     }
@@ -398,6 +377,29 @@ resultCode_t file_delete(const char* filename)
  * --------------------------------------------------------------------------------------------- */
 
 
+/**
+ *	@brief Line streaming receiver for file_getFilelist(), parses each +QFLST: "<filename>",<file_size> line into the result.
+ */
+static void S__filelistLineRecv(void *lineCntxt, const char *line, uint16_t lineSz, bool isPartial)
+{
+    fileListResult_t *fileList = (fileListResult_t *)lineCntxt;
+
+    if (fileList->fileCnt >= file__fileListMaxCnt || strncmp(line, "+QFLST: \"", 9) != 0)
+        return;
+
+    const char *namePtr = line + 9;
+    const char *nameEnd = strchr(namePtr, '"');
+    if (nameEnd == NULL)                                                    // filename longer than line buffer (segment)
+        return;
+
+    uint8_t nameLen = MIN(nameEnd - namePtr, file__filenameSz - 1);
+    fileListItem_t *fileItem = &fileList->files[fileList->fileCnt++];
+    memcpy(fileItem->filename, namePtr, nameLen);
+    fileItem->filename[nameLen] = '\0';
+    fileItem->fileSz = strtol(nameEnd + 2, NULL, 10);
+}
+
+
 static cmdParseRslt_t S__writeStatusParser() 
 {
     // +QFWRITE: <written_length>,<total_length>
@@ -414,24 +416,24 @@ static resultCode_t S__filesRxHndlr()
 {
     char wrkBffr[32];
     
-    uint8_t popCnt = cbffr_find(g_lqLTEM.iop->rxBffr, "\r", 0, 0, false);
+    uint8_t popCnt = cbffr_find(g_lqLTEM->iop->rxBffr, "\r", 0, 0, false);
     if (CBFFR_NOTFOUND(popCnt))
     {
         return resultCode__internalError;
     }
     
-    cbffr_pop(g_lqLTEM.iop->rxBffr, wrkBffr, popCnt + 2);                                               // pop CONNECT phrase for parsing data length
+    cbffr_pop(g_lqLTEM->iop->rxBffr, wrkBffr, popCnt + 2);                                               // pop CONNECT phrase for parsing data length
     uint16_t readSz = strtol(wrkBffr + 8, NULL, 10);
     uint16_t streamSz = readSz + file__readTrailerSz;
 
-    PRINTF(dbgColor__cyan, "filesDataRcvr() fHandle=%d sz=%d\r", g_lqLTEM.fileCtrl->handle, streamSz);
+    PRINTF(dbgColor__cyan, "filesDataRcvr() fHandle=%d sz=%d\r", g_lqLTEM->fileCtrl->handle, streamSz);
     while (streamSz > 0)
     {
         uint32_t readTimeout = pMillis();
         uint16_t occupiedCnt;
         do
         {
-            occupiedCnt = cbffr_getOccupied(g_lqLTEM.iop->rxBffr);
+            occupiedCnt = cbffr_getOccupied(g_lqLTEM->iop->rxBffr);
             if (pMillis() - readTimeout > file__readTimeoutMs)
             {
                 return resultCode__timeout;
@@ -441,17 +443,17 @@ static resultCode_t S__filesRxHndlr()
         if (readSz > 0)                                                                                         // read content, forward to app
         {
             char* streamPtr;
-            uint16_t blockSz = cbffr_popBlock(g_lqLTEM.iop->rxBffr, &streamPtr, readSz);                        // get address from rxBffr
+            uint16_t blockSz = IOP_rxPopBlock(&streamPtr, readSz);                                               // get address from rxBffr
             PRINTF(dbgColor__cyan, "filesRxHndlr() ptr=%p, bSz=%d, rSz=%d\r", streamPtr, blockSz, readSz);
-            ((fileReceiver_func)(*g_lqLTEM.fileCtrl->appRecvDataCB))(g_lqLTEM.fileCtrl->handle, streamPtr, blockSz);                  // forward to application
-            cbffr_popBlockFinalize(g_lqLTEM.iop->rxBffr, true);                                                 // commit POP
+            ((fileReceiver_func)(*g_lqLTEM->fileCtrl->appRecvDataCB))(g_lqLTEM->fileCtrl->handle, streamPtr, blockSz);                  // forward to application
+            IOP_rxPopBlockFinalize();                                                                           // commit POP
             readSz -= blockSz;
             streamSz -= blockSz;
         }
 
-        if (cbffr_getOccupied(g_lqLTEM.iop->rxBffr) >= file__readTrailerSz)                                     // cleanup, remove trailer
+        if (cbffr_getOccupied(g_lqLTEM->iop->rxBffr) >= file__readTrailerSz)                                     // cleanup, remove trailer
         {
-            cbffr_skipTail(g_lqLTEM.iop->rxBffr, file__readTrailerSz);
+            cbffr_skipTail(g_lqLTEM->iop->rxBffr, file__readTrailerSz);
         }
     }
     return resultCode__success;
@@ -46,7 +46,7 @@
 
 
 // private local declarations
-static resultCode_t geoQueryResponseParser(const char *response);
+static cmdParseRslt_t geoQueryResponseParser(const char *response, char **endptr);
 
 
 /* public functions
@@ -96,7 +96,7 @@ resultCode_t geo_add(uint8_t geoId, geoMode_t mode, geoShape_t shape, double lat
         strcat(cmdStr, cmdChunk);
     }
 
-    if (atcmd_tryInvokeDefaults(cmdStr))
+    if (atcmd_tryInvoke("%s", cmdStr))
     {
         return atcmd_awaitResult();
     }
@@ -111,8 +111,8 @@ resultCode_t geo_add(uint8_t geoId, geoMode_t mode, geoShape_t shape, double lat
 resultCode_t geo_delete(uint8_t geoId)
 {
     char cmdStr[28] = {0};
-    snprintf(cmdStr, 80, "AT+QCFGEXT=\"deletegeo\",%d", geoId);
-    if (atcmd_tryInvokeDefaults(cmdStr))
+    snprintf(cmdStr, sizeof(cmdStr), "AT+QCFGEXT=\"deletegeo\",%d", geoId);
+    if (atcmd_tryInvoke("%s", cmdStr))
     {
         return atcmd_awaitResult();
     }
@@ -128,11 +128,11 @@ geoPosition_t geo_query(uint8_t geoId)
 {
     if (atcmd_tryInvoke("AT+QCFGEXT=\"querygeo\",%d", geoId))
     {
-        if (atcmd_awaitResult() != resultCode__success)
+        if (atcmd_awaitResultWithOptions(atcmd__defaultTimeout, geoQueryResponseParser) != resultCode__success)
             return geoPosition_unknown;
-        return resultCode__success;
+        return (geoPosition_t)atcmd_getValue();
     }
-    return resultCode__conflict;
+    return geoPosition_unknown;
 };
 
 
@@ -146,9 +146,9 @@ geoPosition_t geo_query(uint8_t geoId)
 /**
  *	\brief Action response parser for a geo-fence query.
  */
-static resultCode_t geoQueryResponseParser(const char *response)
+static cmdParseRslt_t geoQueryResponseParser(const char *response, char **endptr)
 {
-    return serviceResponseParser(response, "+QCFGEXT: \"querygeo\",");
+    return atcmd_stdResponseParser("+QCFGEXT: \"querygeo\",", true, ",", 2, 2, "", 0);     // <geoid>,<position>
 }
 
 
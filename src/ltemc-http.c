@@ -43,8 +43,6 @@
 #define PRINTF(c_, f_, ...) ;
 #endif
 
-extern ltemDevice_t g_lqLTEM;
-
 #define MIN(x, y) (((x) < (y)) ? (x) : (y))
 #define MAX(X, Y) (((X) > (Y)) ? (X) : (Y))
 
@@ -57,6 +55,9 @@ static uint16_t S__setUrl(const char *host, const char *relative);
 static cmdParseRslt_t S__httpGetStatusParser();
 static cmdParseRslt_t S__httpPostStatusParser();
 static resultCode_t S__httpRxHndlr();
+static resultCode_t S__httpGetPrepare(httpCtrl_t *httpCtrl, const char* relativeUrl, bool returnResponseHdrs);
+static resultCode_t S__httpGetComplete(httpCtrl_t *httpCtrl, resultCode_t rslt);
+static resultCode_t S__httpGetStep(void *ctrl);
 
 
 /* Public Functions
@@ -70,7 +71,7 @@ void http_initControl(httpCtrl_t *httpCtrl, dataCntxt_t dataCntxt, httpRecv_func
     ASSERT(httpCtrl != NULL && recvCallback != NULL);
     ASSERT(dataCntxt < dataCntxt__cnt);
 
-    g_lqLTEM.streams[dataCntxt] = httpCtrl;
+    g_lqLTEM->streams[dataCntxt] = httpCtrl;
 
     memset(httpCtrl, 0, sizeof(httpCtrl_t));
 
@@ -83,7 +84,7 @@ void http_initControl(httpCtrl_t *httpCtrl, dataCntxt_t dataCntxt, httpRecv_func
     httpCtrl->pageCancellation = false;
     httpCtrl->useTls = false;
     httpCtrl->timeoutSec = http__defaultTimeoutBGxSec;
-    httpCtrl->defaultBlockSz = cbffr_getCapacity(g_lqLTEM.iop->rxBffr) / 4;
+    httpCtrl->defaultBlockSz = cbffr_getCapacity(g_lqLTEM->iop->rxBffr) / 4;
     httpCtrl->cstmHdrs = NULL;
     httpCtrl->cstmHdrsSz = 0;
     httpCtrl->httpStatus = 0xFFFF;
@@ -210,109 +211,66 @@ void http_addBasicAuthHdr(httpCtrl_t *http, const char *user, const char *pw)
  */
 resultCode_t http_get(httpCtrl_t *httpCtrl, const char* relativeUrl, bool returnResponseHdrs)
 {
-    httpCtrl->requestState = httpState_idle;
-    httpCtrl->httpStatus = resultCode__unknown;
-    strcpy(httpCtrl->requestType, "GET");
-    resultCode_t rslt;
-
-    if (ATCMD_awaitLock(httpCtrl->timeoutSec))
+    resultCode_t rslt = S__httpGetPrepare(httpCtrl, relativeUrl, returnResponseHdrs);
+    if (rslt != resultCode__success)
+        return rslt;
+
+    /* INVOKE HTTP GET METHOD
+    * BGx responds with OK immediately upon acceptance of cmd, then later (up to timeout) with "+QHTTPGET: " string
+    * After "OK" we switch IOP to data mode and return. S_httpDoWork() handles the parsing of the page response and
+    * if successful, the issue of the AT+QHTTPREAD command to start the page data stream
+    * 
+    * This allows other application tasks to be performed while waiting for page. No LTEm commands can be invoked
+    * but non-LTEm tasks like reading sensors can continue.
+    *---------------------------------------------------------------------------------------------------------------*/
+
+    char httpRequestCmd[http__getRequestLength];
+    if (httpCtrl->cstmHdrs)
     {
-        if (returnResponseHdrs)
-        {
-            atcmd_invokeReuseLock("AT+QHTTPCFG=\"responseheader\",%d",  (int)(httpCtrl->returnResponseHdrs));
-            rslt = atcmd_awaitResultWithOptions(atcmd__defaultTimeout, NULL);
-            if (rslt != resultCode__success)
-            {
-                atcmd_close();
-                return rslt;
-            }
-        }
-
-        if (httpCtrl->useTls)
-        {
-            // AT+QHTTPCFG="sslctxid",<httpCtrl->sckt>
-            atcmd_invokeReuseLock("AT+QHTTPCFG=\"sslctxid\",%d",  (int)httpCtrl->dataCntxt);
-            rslt = atcmd_awaitResult();
-            if (rslt != resultCode__success)
-            {
-                atcmd_close();
-                return rslt;
-            }
-        }
+        char *hostName = strchr(httpCtrl->hostUrl, ':');
+        hostName = hostName ? hostName + 3 : httpCtrl->hostUrl;
 
-        /* SET URL FOR REQUEST
-        * set BGx HTTP URL: AT+QHTTPURL=<urlLength>,timeoutSec  (BGx default timeout is 60, if not specified)
-        * wait for CONNECT prompt, then output <URL>, /r/n/r/nOK
-        * 
-        * NOTE: there is only 1 URL in the BGx at a time
-        *---------------------------------------------------------------------------------------------------------------*/
+        char cstmRequest[240];
+        snprintf(cstmRequest, sizeof(cstmRequest), "%s %s HTTP/1.1\r\nHost: %s\r\n%s\r\n", httpCtrl->requestType, relativeUrl, hostName, httpCtrl->cstmHdrs);
+        PRINTF(dbgColor__dMagenta, "CustomRqst:\r%s\r", cstmRequest);
 
-        rslt = S__setUrl(httpCtrl->hostUrl, relativeUrl);
-        if (rslt != resultCode__success)
-        {
-            PRINTF(dbgColor__warn, "Failed set URL rslt=%d\r", rslt);
-            atcmd_close();
-            return rslt;
-        }
-
-        /* INVOKE HTTP GET METHOD
-        * BGx responds with OK immediately upon acceptance of cmd, then later (up to timeout) with "+QHTTPGET: " string
-        * After "OK" we switch IOP to data mode and return. S_httpDoWork() handles the parsing of the page response and
-        * if successful, the issue of the AT+QHTTPREAD command to start the page data stream
-        * 
-        * This allows other application tasks to be performed while waiting for page. No LTEm commands can be invoked
-        * but non-LTEm tasks like reading sensors can continue.
-        *---------------------------------------------------------------------------------------------------------------*/
-
-        /* If custom headers, need to both set flag here and include in request stream below
-         */
-        atcmd_invokeReuseLock("AT+QHTTPCFG=\"requestheader\",%d", httpCtrl->cstmHdrs ? 1 : 0);
-        rslt = atcmd_awaitResult();
-        if (rslt != resultCode__success)
-        {
-            atcmd_close();
-            return rslt;
-        }
+        atcmd_configDataMode(httpCtrl->dataCntxt, "CONNECT", atcmd_stdTxDataHndlr, cstmRequest, strlen(cstmRequest), NULL, false);
+        atcmd_invokeReuseLock("AT+QHTTPGET=%d,%d", httpCtrl->timeoutSec, strlen(cstmRequest));
+    }
+    else
+    {
+        atcmd_invokeReuseLock("AT+QHTTPGET=%d", PERIOD_FROM_SECONDS(httpCtrl->timeoutSec));
+    }
 
-        char httpRequestCmd[http__getRequestLength];
-        if (httpCtrl->cstmHdrs)
-        {
-            char *hostName = strchr(httpCtrl->hostUrl, ':');
-            hostName = hostName ? hostName + 3 : httpCtrl->hostUrl;
+    rslt = atcmd_awaitResultWithOptions(PERIOD_FROM_SECONDS(httpCtrl->timeoutSec), S__httpGetStatusParser);    // wait for "+QHTTPGET trailer (request completed)
+    return S__httpGetComplete(httpCtrl, rslt);
+}   /* http_get() */
 
-            char cstmRequest[240];
-            snprintf(cstmRequest, sizeof(cstmRequest), "%s %s HTTP/1.1\r\nHost: %s\r\n%s\r\n", httpCtrl->requestType, relativeUrl, hostName, httpCtrl->cstmHdrs);
-            PRINTF(dbgColor__dMagenta, "CustomRqst:\r%s\r", cstmRequest);
 
-            atcmd_configDataMode(httpCtrl->dataCntxt, "CONNECT", atcmd_stdTxDataHndlr, cstmRequest, strlen(cstmRequest), NULL, false);
-            atcmd_invokeReuseLock("AT+QHTTPGET=%d,%d", httpCtrl->timeoutSec, strlen(cstmRequest));
-        }
-        else
-        {
-            atcmd_invokeReuseLock("AT+QHTTPGET=%d", PERIOD_FROM_SECONDS(httpCtrl->timeoutSec));
-        }
+/**
+ *	@brief Start a HTTP GET page web request, returning without waiting for the server response.
+ *  -----------------------------------------------------------------------------------------------
+ */
+bool http_getAsync(httpCtrl_t *httpCtrl, const char* relativeUrl, bool returnResponseHdrs, ltemAsyncComplete_func completeCB)
+{
+    if (httpCtrl->cstmHdrs != NULL)                                         // custom request is sent from a stack buffer, use http_get()
+        return false;
+    if (ltem_isAsyncPending() || ATCMD_isLockActive())
+        return false;
 
-        rslt = atcmd_awaitResultWithOptions(PERIOD_FROM_SECONDS(httpCtrl->timeoutSec), S__httpGetStatusParser);                                                                     // wait for "+QHTTPGET trailer (request completed)
-        if (rslt == resultCode__success && atcmd_getValue() == 0)
-        {
-            httpCtrl->httpStatus = S__parseResponseForHttpStatus(httpCtrl, atcmd_getResponse());
-            if (httpCtrl->httpStatus >= resultCode__success && httpCtrl->httpStatus <= resultCode__successMax)
-            {
-                httpCtrl->requestState = httpState_requestComplete;                                         // update httpState, got GET/POST response
-                PRINTF(dbgColor__magenta, "GetRqst dCntxt:%d, status=%d\r", httpCtrl->dataCntxt, httpCtrl->httpStatus);
-            }
-        }
-        else
-        {
-            httpCtrl->requestState = httpState_idle;
-            httpCtrl->httpStatus = atcmd_getValue();
-            PRINTF(dbgColor__warn, "Closed failed GET request, status=%d %s\r", httpCtrl->httpStatus, atcmd_getErrorDetail());
-        }
-        atcmd_close();
-        return httpCtrl->httpStatus;
+    resultCode_t rslt = S__httpGetPrepare(httpCtrl, relativeUrl, returnResponseHdrs);    // config round-trips are brief, performed inline
+    if (rslt != resultCode__success)
+    {
+        if (completeCB != NULL)
+            completeCB(httpCtrl, rslt);
+        return true;
     }
-    return resultCode__timeout;
-}   /* http_get() */
+    atcmd_invokeReuseLock("AT+QHTTPGET=%d", PERIOD_FROM_SECONDS(httpCtrl->timeoutSec));
+    atcmd_setOptions(PERIOD_FROM_SECONDS(httpCtrl->timeoutSec), S__httpGetStatusParser);
+
+    LTEM_startAsync(S__httpGetStep, httpCtrl, completeCB);                  // started after prepare, blocking awaits yield to eventMgr
+    return true;
+}
 
 
 
@@ -331,9 +289,7 @@ resultCode_t http_post(httpCtrl_t *httpCtrl, const char *relativeUrl, bool retur
     {
         if (returnResponseHdrs)
         {
-            atcmd_invokeReuseLock("AT+QHTTPCFG=\"responseheader\",%d",  (int)(httpCtrl->returnResponseHdrs));
-
-            rslt = atcmd_awaitResult();
+            rslt = atcmd_applySettingReuseLock(1, "AT+QHTTPCFG=\"responseheader\",%d",  (int)(httpCtrl->returnResponseHdrs));
             if (rslt != resultCode__success)
             {
                 atcmd_close();
@@ -344,8 +300,7 @@ resultCode_t http_post(httpCtrl_t *httpCtrl, const char *relativeUrl, bool retur
         if (httpCtrl->useTls)
         {
             // AT+QHTTPCFG="sslctxid",<httpCtrl->sckt>
-            atcmd_invokeReuseLock("AT+QHTTPCFG=\"sslctxid\",%d",  (int)httpCtrl->dataCntxt);
-            rslt = atcmd_awaitResult();
+            rslt = atcmd_applySettingReuseLock(1, "AT+QHTTPCFG=\"sslctxid\",%d",  (int)httpCtrl->dataCntxt);
             if (rslt != resultCode__success)
             {
                 atcmd_close();
@@ -437,10 +392,10 @@ uint16_t http_readPage(httpCtrl_t *httpCtrl)
     if (httpCtrl->requestState != httpState_requestComplete)
         return resultCode__preConditionFailed;                                  // readPage() only valid after a completed GET\POST
     
-    cbuffer_t* rxBffr = g_lqLTEM.iop->rxBffr;                                   // for better readability
+    cbuffer_t* rxBffr = g_lqLTEM->iop->rxBffr;                                   // for better readability
     char* workPtr;
 
-    if (atcmd_tryInvoke("AT+QHTTPREAD=%d", httpCtrl->timeoutSec))
+    if (atcmd_tryInvokeCmd(atcmdCmd_qhttpread, httpCtrl->timeoutSec))
     {
         atcmd_configDataMode(httpCtrl->dataCntxt, "CONNECT", S__httpRxHndlr, NULL, 0, httpCtrl->appRecvDataCB, true);
         // atcmd_setStreamControl("CONNECT", (streamCtrl_t*)httpCtrl);
@@ -464,6 +419,104 @@ void http_cancelPage(httpCtrl_t *httpCtrl)
 #pragma region Static Functions
 /*-----------------------------------------------------------------------------------------------*/
 
+/**
+ * @brief Lock atcmd and apply GET request config and URL to BGx, leaves lock held on success (closed on failure).
+ */
+static resultCode_t S__httpGetPrepare(httpCtrl_t *httpCtrl, const char* relativeUrl, bool returnResponseHdrs)
+{
+    httpCtrl->requestState = httpState_idle;
+    httpCtrl->httpStatus = resultCode__unknown;
+    strcpy(httpCtrl->requestType, "GET");
+    resultCode_t rslt;
+
+    if (!ATCMD_awaitLock(httpCtrl->timeoutSec))
+        return resultCode__timeout;
+
+    if (returnResponseHdrs)
+    {
+        rslt = atcmd_applySettingReuseLock(1, "AT+QHTTPCFG=\"responseheader\",%d",  (int)(httpCtrl->returnResponseHdrs));
+        if (rslt != resultCode__success)
+        {
+            atcmd_close();
+            return rslt;
+        }
+    }
+
+    if (httpCtrl->useTls)
+    {
+        // AT+QHTTPCFG="sslctxid",<httpCtrl->sckt>
+        rslt = atcmd_applySettingReuseLock(1, "AT+QHTTPCFG=\"sslctxid\",%d",  (int)httpCtrl->dataCntxt);
+        if (rslt != resultCode__success)
+        {
+            atcmd_close();
+            return rslt;
+        }
+    }
+
+    /* SET URL FOR REQUEST
+    * set BGx HTTP URL: AT+QHTTPURL=<urlLength>,timeoutSec  (BGx default timeout is 60, if not specified)
+    * wait for CONNECT prompt, then output <URL>, /r/n/r/nOK
+    * 
+    * NOTE: there is only 1 URL in the BGx at a time
+    *---------------------------------------------------------------------------------------------------------------*/
+
+    rslt = S__setUrl(httpCtrl->hostUrl, relativeUrl);
+    if (rslt != resultCode__success)
+    {
+        PRINTF(dbgColor__warn, "Failed set URL rslt=%d\r", rslt);
+        atcmd_close();
+        return rslt;
+    }
+
+    /* If custom headers, need to both set flag here and include in request stream
+     */
+    rslt = atcmd_applySettingReuseLock(1, "AT+QHTTPCFG=\"requestheader\",%d", httpCtrl->cstmHdrs ? 1 : 0);
+    if (rslt != resultCode__success)
+    {
+        atcmd_close();
+    }
+    return rslt;
+}
+
+
+/**
+ * @brief Process the QHTTPGET result into httpCtrl request state and HTTP status, releases atcmd lock.
+ */
+static resultCode_t S__httpGetComplete(httpCtrl_t *httpCtrl, resultCode_t rslt)
+{
+    if (rslt == resultCode__success && atcmd_getValue() == 0)
+    {
+        httpCtrl->httpStatus = S__parseResponseForHttpStatus(httpCtrl, atcmd_getResponse());
+        if (httpCtrl->httpStatus >= resultCode__success && httpCtrl->httpStatus <= resultCode__successMax)
+        {
+            httpCtrl->requestState = httpState_requestComplete;                                         // update httpState, got GET/POST response
+            PRINTF(dbgColor__magenta, "GetRqst dCntxt:%d, status=%d\r", httpCtrl->dataCntxt, httpCtrl->httpStatus);
+        }
+    }
+    else
+    {
+        httpCtrl->requestState = httpState_idle;
+        httpCtrl->httpStatus = atcmd_getValue();
+        PRINTF(dbgColor__warn, "Closed failed GET request, status=%d %s\r", httpCtrl->httpStatus, atcmd_getErrorDetail());
+    }
+    atcmd_close();
+    return httpCtrl->httpStatus;
+}
+
+
+/**
+ * @brief Async step for http_getAsync(), completes when the QHTTPGET result is received.
+ */
+static resultCode_t S__httpGetStep(void *ctrl)
+{
+    resultCode_t rslt = atcmd_poll();
+    if (rslt == resultCode__unknown)
+        return resultCode__unknown;
+
+    return S__httpGetComplete((httpCtrl_t *)ctrl, rslt);
+}
+
+
 /**
  * @brief Helper function to create a URL from host and relative parts.
  */
@@ -494,10 +547,14 @@ static resultCode_t S__setUrl(const char *host, const char *relative)
         }
     }
     PRINTF(dbgColor__dMagenta, "URL(%d)=\"%s\" \r", strlen(url), url);
+
+    if (LTEM_shadowIsCurrent("+QHTTPURL", 9, url, strlen(url)))                                // BGx retains URL until replaced
+        return resultCode__success;
     
     atcmd_configDataMode(0, "CONNECT", atcmd_stdTxDataHndlr, url, strlen(url), NULL, true);     // setup for URL dataMode transfer 
     atcmd_invokeReuseLock("AT+QHTTPURL=%d,5", strlen(url));
     rslt = atcmd_awaitResult();
+    LTEM_shadowUpdate("+QHTTPURL", 9, (rslt == resultCode__success) ? url : NULL, strlen(url));
     return rslt;
 }
 
@@ -530,45 +587,49 @@ static resultCode_t S__httpRxHndlr()
     char wrkBffr[32];
     uint16_t pageRslt = 0;
 
-    httpCtrl_t *httpCtrl = (httpCtrl_t*)ltem_getStreamFromCntxt(g_lqLTEM.atcmd->dataMode.contextKey, streamType_HTTP);
+    httpCtrl_t *httpCtrl = (httpCtrl_t*)ltem_getStreamFromCntxt(g_lqLTEM->atcmd->dataMode.contextKey, streamType_HTTP);
     ASSERT(httpCtrl != NULL);                                                                           // ASSERT data mode and stream context are consistent
 
-    uint8_t popCnt = cbffr_find(g_lqLTEM.iop->rxBffr, "\r", 0, 0, false);
+    uint8_t popCnt = cbffr_find(g_lqLTEM->iop->rxBffr, "\r", 0, 0, false);
     if (CBFFR_NOTFOUND(popCnt))
     {
         return resultCode__internalError;
     }
     
-    cbffr_pop(g_lqLTEM.iop->rxBffr, wrkBffr, popCnt + 2);                                               // pop CONNECT phrase for parsing data length
+    cbffr_pop(g_lqLTEM->iop->rxBffr, wrkBffr, popCnt + 2);                                               // pop CONNECT phrase for parsing data length
     PRINTF(dbgColor__cyan, "httpPageRcvr() stream started\r");
 
     memset(wrkBffr, 0, sizeof(wrkBffr));                                                                // need clean wrkBffr for trailer parsing
     uint32_t readStart = pMillis();
     do
     {
-        uint16_t occupiedCnt = cbffr_getOccupied(g_lqLTEM.iop->rxBffr);
+        uint16_t occupiedCnt = cbffr_getOccupied(g_lqLTEM->iop->rxBffr);
         bool readTimeout = pMillis() - readStart > httpCtrl->timeoutSec;
-        uint16_t trailerIndx = cbffr_find(g_lqLTEM.iop->rxBffr, "\r\nOK\r\n\r\n", 0, 0, false);
+        uint16_t trailerIndx = cbffr_find(g_lqLTEM->iop->rxBffr, "\r\nOK\r\n\r\n", 0, 0, false);
         uint16_t reqstBlockSz = MIN(trailerIndx, httpCtrl->defaultBlockSz);
 
-        if (cbffr_getOccupied(g_lqLTEM.iop->rxBffr) >= reqstBlockSz)                                        // sufficient read content ready
+        if (cbffr_getOccupied(g_lqLTEM->iop->rxBffr) >= reqstBlockSz)                                        // sufficient read content ready
         {
             char* streamPtr;
-            uint16_t blockSz = cbffr_popBlock(g_lqLTEM.iop->rxBffr, &streamPtr, reqstBlockSz);              // get address from rxBffr
+            uint16_t blockSz = IOP_rxPopBlock(&streamPtr, reqstBlockSz);                                    // get address from rxBffr
             PRINTF(dbgColor__cyan, "httpPageRcvr() ptr=%p blkSz=%d isFinal=%d\r", streamPtr, blockSz, CBFFR_FOUND(trailerIndx));
 
             // forward to application
             ((httpRecv_func)(*httpCtrl->appRecvDataCB))(httpCtrl->dataCntxt, streamPtr, blockSz, CBFFR_FOUND(trailerIndx));
-            cbffr_popBlockFinalize(g_lqLTEM.iop->rxBffr, true);                                             // commit POP
+            IOP_rxPopBlockFinalize();                                                                       // commit POP
         }
+        else
+            IOP_awaitRx(PERIOD_FROM_SECONDS(httpCtrl->timeoutSec));                                         // sleep until more page content
 
         if (CBFFR_FOUND(trailerIndx))
         {
             // parse trailer for status 
             uint8_t offset = strlen(wrkBffr);
-            cbffr_pop(g_lqLTEM.iop->rxBffr, wrkBffr + offset, sizeof(wrkBffr) - offset);
+            cbffr_pop(g_lqLTEM->iop->rxBffr, wrkBffr + offset, sizeof(wrkBffr) - offset);
 
-            if (strchr(wrkBffr, '\n'))                                                                      // wait for final /r/n in wrkBffr
+            if (!strchr(wrkBffr, '\n'))                                                                     // wait for final /r/n in wrkBffr
+                IOP_awaitRx(PERIOD_FROM_SECONDS(httpCtrl->timeoutSec));
+            else
             {
                 char* suffix = strstr(wrkBffr, "+QHTTPREAD: ") + sizeof("+QHTTPREAD: ");
                 uint16_t errVal = strtol(suffix, NULL, 10);
@@ -179,6 +179,19 @@ void http_addCustomHdr(httpCtrl_t *httpCtrl, const char *hdrText);
 resultCode_t http_get(httpCtrl_t *httpCtrl, const char* relativeUrl, bool returnResponseHdrs);
 
 
+/**
+ *	@brief Start HTTP GET operation, returning without waiting for the server response. Results are buffered on the LTEm, see http_readPage().
+ *  @details Request config/URL are applied before return, the GET is completed by ltem_eventMgr() calling completeCB with the 
+ *           httpCtrl and the http_get() style HTTP status. Custom request headers are not supported, use http_get().
+ *  @param [in] httpCtrl Pointer to the control block for HTTP communications.
+ *	@param [in] relativeUrl The URL to GET (starts with \ and doesn't include the host part)
+ *  @param [in] returnResponseHdrs Set to true for page result to include response headers at the start of the page
+ *  @param [in] completeCB Application callback on GET completion
+ *  @return true if GET request was started, false if another command or async operation is underway (or custom headers set)
+ */
+bool http_getAsync(httpCtrl_t *httpCtrl, const char* relativeUrl, bool returnResponseHdrs, ltemAsyncComplete_func completeCB);
+
+
 /**
  *	@brief Performs a HTTP POST page web request.
  *  @param [in] httpCtrl Pointer to the control block for HTTP communications.
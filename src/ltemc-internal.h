@@ -55,14 +55,48 @@
 
 
 
-/* Metric Type Definitions
- * ------------------------------------------------------------------------------------------------------------------------------*/
-typedef struct ltemMetrics_tag
+/**
+ * @brief Async (non-blocking) operation underway, stepped by ltem_eventMgr() until complete.
+ */
+typedef struct ltemAsyncOp_tag
+{
+    ltemAsyncStep_func stepFunc;                /// operation step function, polls in-flight command and invokes next
+    void *ctrl;                                 /// stream control (or other context) the operation is acting on
+    uint8_t step;                               /// operation defined step (state)
+    uint8_t index;                              /// operation defined iterator (ex: topic index)
+    bool flag;                                  /// operation defined option (ex: cleanSession)
+    bool stepping;                              /// reentrancy guard, eventMgr is called within result processing
+    ltemAsyncComplete_func completeCB;          /// application callback on operation completion
+} ltemAsyncOp_t;
+
+/**
+ * @brief Arbiter serializing modem access between tasks, see ltem_acquire().
+ */
+typedef struct ltemArbiter_tag
+{
+    ltemRequest_t *owner;                               /// request granted modem access, NULL if none
+    ltemRequest_t *waiting[ltem__arbiterSlots];         /// requests waiting for access
+    uint32_t arrivals;                                  /// arrival sequence counter
+} ltemArbiter_t;
+
+/**
+ * @brief Shadow of a modem setting, the setting key (command and context) followed by the last applied value.
+ */
+typedef struct ltemShadowEntry_tag
 {
-    // metrics
-    uint32_t cmdInvokes;
+    char text[ltem__shadowTextSz];              /// key chars followed by value chars (not NULL terminated)
+    uint8_t keySz;                              /// chars of key in text, 0 = entry unused
+    uint8_t valueSz;                            /// chars of applied setting (full command) following key
+} ltemShadowEntry_t;
 
-} ltemMetrics_t;
+/**
+ * @brief Shadow cache of modem settings applied to the BGx, writes of a value already in effect are skipped.
+ */
+typedef struct ltemShadow_tag
+{
+    ltemShadowEntry_t entries[ltem__shadowSz];
+    uint8_t nextEvict;                          /// next entry replaced when cache is full (round-robin)
+} ltemShadow_t;
 
 /**
  * @brief enum describing the last receive event serviced by the ISR
@@ -98,8 +132,15 @@ typedef struct ltemDevice_tag
     bool cancellationRequest;                   /// For RTOS implementations, token to request cancellation of long running task/action
     deviceState_t deviceState;                  /// Device state of the BGx module
     appEvntNotify_func appEvntNotifyCB;         /// Event notification callback to parent application
+    ltemWait_func waitCB;                       /// optional application wait (sleep) for RX, NULL to poll with pYield()
+    ltemSignal_func signalCB;                   /// optional application wake from ISR on RX, pairs with waitCB
+    ltemCritical_func criticalCB;               /// optional application critical section (multi-task), protects lock/arbiter state
+    ltemRequestWait_func requestWaitCB;         /// optional application wait for ltem_acquire() grant, NULL to poll with pYield()
+    ltemRequestSignal_func requestSignalCB;     /// optional application wake of ltem_acquire() waiter, pairs with requestWaitCB
+    ltemArbiter_t arbiter;                      /// modem access arbiter for multi-task applications
     char moduleType[ltem__moduleTypeSz];        /// c-str indicating module type. BG96, BG95-M3, BG77, etc. (so far)
     void *spi;                                  /// SPI device (methods signatures compatible with Arduino)
+    SC16IS7xx_IER bridgeIer;                    /// NXP bridge IER setting, shared by ISR (RX/TX source control) and foreground
     iop_t *iop;                                 /// IOP subsystem controls
     atcmd_t *atcmd;                             /// Action subsystem controls
     modemSettings_t *modemSettings;             /// Settings to control radio and cellular network initialization
@@ -108,16 +149,37 @@ typedef struct ltemDevice_tag
     streamCtrl_t* streams[ltem__streamCnt];     /// Data streams: protocols or file system
     fileCtrl_t* fileCtrl;
 
+    ltemAsyncOp_t asyncOp;                      /// async (non-blocking) operation underway, stepped by ltem_eventMgr()
+    ltemShadow_t shadow;                        /// modem settings in effect, invalidated on BGx reset/APP RDY
+
     ltemMetrics_t metrics;                      /// metrics for operational analysis and reporting
 } ltemDevice_t;
 
 
 /* ================================================================================================================================
- * LTEmC Global Structure */
+ * LTEmC Bound Device */
+
+extern ltemTaskBinding_t g_lqLTEMBinding;       // process-wide binding, see ltem_bind()
+extern ltemTaskBinding_t g_lqLTEMIsrBinding;    // device of the interrupt service in progress (NULL in foreground)
+extern ltemTaskBinding_func g_lqLTEMTaskBindingCB;
+
+/**
+ *	@brief Resolve the binding: the interrupt service's device, else the calling task's binding (task binding callback
+ *         registered), else the process-wide binding.
+ */
+static inline ltemTaskBinding_t *LTEM_binding()
+{
+    if (g_lqLTEMIsrBinding.device != NULL)
+        return &g_lqLTEMIsrBinding;
+    if (g_lqLTEMTaskBindingCB != NULL)
+        return g_lqLTEMTaskBindingCB();
+    return &g_lqLTEMBinding;
+}
 
-extern ltemDevice_t g_lqLTEM;                   // The LTEm "object".
+#define g_lqLTEM (LTEM_binding()->device)       // The LTEm "object" LTEmC calls operate on, see ltem_bind().
 
-/* LTEmC device is created as a global singleton variable
+/* LTEmC devices are created by ltem_create(), g_lqLTEM resolves to the device currently bound. ISR and DMA completion
+ * dispatch bind their device (g_lqLTEMIsrBinding) for the duration of the interrupt service, restoring the prior on exit.
  * ==============================================================================================================================*/
 
 
@@ -130,6 +192,49 @@ extern "C"
 
 
 // LTEM Internal
+
+/**
+ *	\brief Starts an async operation, the step function is called from ltem_eventMgr() until it returns a final result.
+ *  \details ASSERTS that no other async operation is underway. Caller invokes the operation's first command prior to starting.
+ *  \return Pointer to the async operation, for step functions to track their state.
+ */
+ltemAsyncOp_t *LTEM_startAsync(ltemAsyncStep_func stepFunc, void *ctrl, ltemAsyncComplete_func completeCB);
+
+/**
+ *	\brief Completes the underway async operation and notifies the application through the operation's completion callback.
+ */
+void LTEM_completeAsync(resultCode_t resultCode);
+
+/**
+ *	\brief Enter/exit the application critical section protecting lock and arbiter state, no action if none registered.
+ */
+void LTEM_critical(bool enter);
+
+/**
+ *	\brief Returns true if cancellation is requested, globally (cancellationRequest) or by the request holding modem access.
+ */
+bool LTEM_isCancelled();
+
+/**
+ *	\brief Returns true if the calling task may drive the device: no request holds modem access or the task's request does.
+ */
+bool LTEM_isAccessOwner();
+
+/**
+ *	\brief Returns true if the modem setting (key) was last applied with value, writing it again can be skipped.
+ */
+bool LTEM_shadowIsCurrent(const char *key, uint16_t keySz, const char *value, uint16_t valueSz);
+
+/**
+ *	\brief Record the value applied to a modem setting (key), a NULL value removes the setting (value on BGx is unknown).
+ */
+void LTEM_shadowUpdate(const char *key, uint16_t keySz, const char *value, uint16_t valueSz);
+
+/**
+ *	\brief Clears all shadowed modem settings, BGx has reset to its configured defaults.
+ */
+void LTEM_shadowInvalidate();
+
 // void LTEM_initIo();
 // void LTEM_registerDoWorker(doWork_func *doWorker);
 // void LTEM_registerUrcHandler(urcHandler_func *urcHandler);
@@ -148,6 +253,11 @@ extern "C"
 */
 cmdParseRslt_t ATCMD_okResponseParser();
 
+/**
+ *  \brief Initialize the AT command subsystem (command control, retry policy defaults) of the device being created.
+ */
+void ATCMD_create();
+
 /**
  *  \brief Awaits exclusive access to QBG module command interface.
  *  \param timeoutMS [in] - Number of milliseconds to wait for a lock.
@@ -161,6 +271,11 @@ bool ATCMD_awaitLock(uint16_t timeoutMS);
  */
 bool ATCMD_isLockActive();
 
+/**
+ *	\brief Service the pipelined command queue: complete the in-flight queued command and send the next. Called from ltem_eventMgr().
+ */
+void ATCMD_serviceQueue();
+
 /* LTEmC INTERNAL prompt parsers 
  * ------------------------------------------------------------------------- */
 
@@ -201,6 +316,24 @@ void NTWK_initRatOptions();
 void NTWK_applyDefaulNetwork();
 
 
+/**
+ *	\brief Update network registration status from a +CEREG/+CGREG report (URC or query response).
+ */
+void NTWK_regStatusReport(const char *regReport);
+
+
+/**
+ *	\brief Mark a PDP context inactive following network deactivation (pdpContextId 0 is all contexts).
+ */
+void NTWK_setNetworkInactive(uint8_t pdpContextId);
+
+
+/**
+ *	\brief Clear provider and network state, SIM is unavailable.
+ */
+void NTWK_clearProviderInfo();
+
+
 #pragma endregion
 /* ------------------------------------------------------------------------------------------------
  * End NTWK LTEmC Internal Functions */
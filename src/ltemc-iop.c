@@ -73,12 +73,11 @@
 #endif
 
 #define SRCFILE "IOP"                           // create SRCFILE (3 char) MACRO for lq-diagnostics ASSERT
+#include <inttypes.h>
 
 #include "ltemc-internal.h"
 #include "ltemc-iop.h"
 
-extern ltemDevice_t g_lqLTEM;
-
 #define QBG_APPREADY_MILLISMAX 15000
 
 #define MIN(x, y) (((x) < (y)) ? (x) : (y))
@@ -91,11 +90,39 @@ extern ltemDevice_t g_lqLTEM;
 /* ------------------------------------------------------------------------------------------------ */
 
 static void S_interruptCallbackISR();
+static void S__isrService();
+static void S__isrHold();
+static void S__isrRelease();
+static void S__setTxIrq(bool enabled);
+static void S__isrDispatch(uint8_t slot);
+static void S__isrDispatch0();
+static void S__isrDispatch1();
+static void S__txServiceISR(uint8_t txLevel);
+static uint16_t S__rxCommitSpill(uint16_t spillSz);
+static void S__rxCommitISR(const char *block, uint16_t blockSz);
+static void S__urcClassifyISR(const char *block, uint16_t blockSz);
+static uint32_t S__rxTailAt();
+static void S__urcQueueISR();
+static void S__rxDiscardISR(uint8_t unreadCnt, uint16_t dropCnt);
+static void S__rxResyncISR(uint8_t rxLevel);
+static void S__rxSignalISR();
 static inline uint8_t S_convertCharToContextId(const char cntxtChar);
 
+#ifdef LTEMC_SPI_DMA
+static bool S__rxDmaStart();
+static void S__rxDmaCompleteISR();
+static void S__isrServiceDeferred();
+#endif
+
 #pragma endregion // Header
 
 
+static ltemDevice_t *s_isrDevices[ltem__deviceMax] = {0};                                  // ISR dispatch: device instance by slot
+static platformGpioPinIrqCallback const s_isrDispatch[] = { S__isrDispatch0, S__isrDispatch1 };               // one trampoline per device slot
+
+typedef char S__isrDispatchSlotsCheck[(sizeof(s_isrDispatch) / sizeof(s_isrDispatch[0]) == ltem__deviceMax) ? 1 : -1];  // compile-time: trampolines match ltem__deviceMax
+
+
 #pragma region Public Functions
 /*-----------------------------------------------------------------------------------------------*/
 #pragma endregion // Public Functions
@@ -109,32 +136,25 @@ static inline uint8_t S_convertCharToContextId(const char cntxtChar);
  */
 void IOP_create()
 {
-    g_lqLTEM.iop = calloc(1, sizeof(iop_t));
-    ASSERT(g_lqLTEM.iop != NULL);
-
-    cbuffer_t *txBffrCtrl = calloc(1, sizeof(cbuffer_t));           // allocate space for TX buffer control struct
-    if (txBffrCtrl == NULL)
-        return;
-    char *txBffr = calloc(1, ltem__bufferSz_tx);                    // allocate space for raw buffer
-    if (txBffr == NULL)
-    {
-        free(txBffr);
-        return;
-    }
+    g_lqLTEM->iop = calloc(1, sizeof(iop_t));
+    ASSERT(g_lqLTEM->iop != NULL);
 
     cbuffer_t *rxBffrCtrl = calloc(1, sizeof(cbuffer_t));           // allocate space for RX buffer control struct
     if (rxBffrCtrl == NULL)
         return;
-    char *rxBffr = calloc(1, ltem__bufferSz_rx);                    // allocate space for raw buffer
+    char *rxBffr = calloc(1, ltem__bufferSz_rx + IOP__rxBufferSlackSz);     // allocate space for raw buffer, slack past ring end keeps wrapping blocks contiguous
     if (rxBffr == NULL)
     {
         free(rxBffr);
         return;
     }
 
-    // TX handled with CALLOC of struct
-    cbffr_init(rxBffrCtrl, rxBffr, ltem__bufferSz_rx);              // initialize as a circ-buffer
-    g_lqLTEM.iop->rxBffr = rxBffrCtrl;                              // add into IOP struct
+    // TX sends from caller's data via TX descriptor queue, no TX buffer
+    cbffr_init(rxBffrCtrl, rxBffr, ltem__bufferSz_rx);              // initialize as a circ-buffer, slack is outside ring
+    g_lqLTEM->iop->rxBffr = rxBffrCtrl;                              // add into IOP struct
+    g_lqLTEM->iop->rxRaw = rxBffr;
+    g_lqLTEM->iop->baudRate = IOP__uartBaudRate;
+    g_lqLTEM->iop->urcMatched = -1;
 }
 
 
@@ -143,10 +163,38 @@ void IOP_create()
  */
 void IOP_attachIrq()
 {
-    g_lqLTEM.iop->txBffr = NULL;
-    g_lqLTEM.iop->txPending = 0;
-    spi_usingInterrupt(g_lqLTEM.spi, g_lqLTEM.pinConfig.irqPin);
-    platform_attachIsr(g_lqLTEM.pinConfig.irqPin, true, gpioIrqTriggerOn_falling, S_interruptCallbackISR);
+    g_lqLTEM->iop->txBffr = NULL;
+    g_lqLTEM->iop->txPending = 0;
+    g_lqLTEM->iop->txQueueHead = 0;
+    g_lqLTEM->iop->txQueueTail = 0;
+    uint8_t slot = 0;                                               // find this device's ISR dispatch slot or first open slot
+    while (slot < ltem__deviceMax && s_isrDevices[slot] != NULL && s_isrDevices[slot] != g_lqLTEM)
+        slot++;
+    ASSERT(slot < ltem__deviceMax);
+    s_isrDevices[slot] = g_lqLTEM;
+    g_lqLTEM->iop->isrSlot = slot;
+
+    spi_usingInterrupt(g_lqLTEM->spi, g_lqLTEM->pinConfig.irqPin);
+    platform_attachIsr(g_lqLTEM->pinConfig.irqPin, true, gpioIrqTriggerOn_falling, s_isrDispatch[slot]);
+
+    g_lqLTEM->iop->trafficProfile = iopTrafficProfile_none;          // bridge was (re)started, TLR cleared
+    IOP_setTrafficProfile(iopTrafficProfile_command);
+}
+
+
+/**
+ *	@brief Set the bridge FIFO trigger levels for the type of traffic expected.
+ */
+void IOP_setTrafficProfile(iopTrafficProfile_t profile)
+{
+    if (profile == g_lqLTEM->iop->trafficProfile)
+        return;
+
+    if (profile == iopTrafficProfile_data)
+        SC16IS7xx_setTriggerLevels(IOP__dataRxTriggerLevel, IOP__dataTxTriggerLevel);
+    else
+        SC16IS7xx_setTriggerLevels(IOP__cmdRxTriggerLevel, IOP__cmdTxTriggerLevel);
+    g_lqLTEM->iop->trafficProfile = profile;
 }
 
 
@@ -155,7 +203,26 @@ void IOP_attachIrq()
  */
 void IOP_detachIrq()
 {
-    platform_detachIsr(g_lqLTEM.pinConfig.irqPin);
+    platform_detachIsr(g_lqLTEM->pinConfig.irqPin);
+}
+
+
+/**
+ *	@brief Release the Input/Output Process subsystem: IRQ detached, ISR dispatch slot freed, buffers released.
+ */
+void IOP_destroy()
+{
+    IOP_detachIrq();
+    for (uint8_t slot = 0; slot < ltem__deviceMax; slot++)
+    {
+        if (s_isrDevices[slot] == g_lqLTEM)
+            s_isrDevices[slot] = NULL;                              // slot reusable by a later device instance
+    }
+
+    free(g_lqLTEM->iop->rxRaw);
+    free(g_lqLTEM->iop->rxBffr);
+    free(g_lqLTEM->iop);
+    g_lqLTEM->iop = NULL;
 }
 
 
@@ -184,8 +251,9 @@ bool IOP_awaitAppReady()
                 head += rxLevel;
                 if (strstr(buf, "APP RDY"))
                 {
-                    PRINTF(dbgColor__white, "AppRdy @ %lums\r", pMillis() - waitStart);
-                    g_lqLTEM.deviceState = deviceState_appReady;
+                    PRINTF(dbgColor__white, "AppRdy @ %" PRIu32 "ms\r", pMillis() - waitStart);
+                    g_lqLTEM->deviceState = deviceState_appReady;
+                    LTEM_shadowInvalidate();                                // BGx (re)started with default settings
                     return true;
                 }
             }
@@ -198,23 +266,45 @@ bool IOP_awaitAppReady()
 
 
 /**
- *	@brief Perform a TX send operation buffered in TX buffer. This is a blocking until send is buffered.
+ *	@brief Queue a block of data for TX without starting TX. Data is not copied.
  */
-void IOP_startTx(const char *sendData, uint16_t sendSz)
+bool IOP_enqueueTx(const char *sendData, uint16_t sendSz)
 {
-    ASSERT(sendData != NULL && *sendData != '\0' && sendSz > 0);
+    ASSERT(sendData != NULL && sendSz > 0);
 
-    uint8_t txLevel = SC16IS7xx_readReg(SC16IS7xx_TXLVL_regAddr);       // check TX buffer status for flow, empty buffer is TX idle
-    if (txLevel == SC16IS7xx__FIFO_bufferSz)
-    {
-        g_lqLTEM.iop->txBffr = sendData;
-        g_lqLTEM.iop->txPending = sendSz;
+    uint8_t nextHead = (g_lqLTEM->iop->txQueueHead + 1) % IOP__txQueueSz;
+    if (nextHead == g_lqLTEM->iop->txQueueTail)                          // queue full
+        return false;
 
-        uint8_t immediateSz = MIN(g_lqLTEM.iop->txPending, SC16IS7xx__FIFO_bufferSz);
-        g_lqLTEM.iop->txBffr += immediateSz;
-        g_lqLTEM.iop->txPending -= immediateSz;
-        SC16IS7xx_write(sendData, immediateSz);
+    g_lqLTEM->iop->txQueue[g_lqLTEM->iop->txQueueHead].data = sendData;
+    g_lqLTEM->iop->txQueue[g_lqLTEM->iop->txQueueHead].size = sendSz;
+    g_lqLTEM->iop->txQueueHead = nextHead;                               // publish descriptor to ISR
+    return true;
+}
+
+
+/**
+ *	@brief Queue a block of data for TX and start sending. Blocks only if the TX queue is full.
+ */
+void IOP_startTx(const char *sendData, uint16_t sendSz)
+{
+    if (!IOP_enqueueTx(sendData, sendSz))
+    {
+        S__setTxIrq(true);                                              // ensure queued descriptors are being sent
+        while (!IOP_enqueueTx(sendData, sendSz))
+            pDelay(1);
     }
+    g_lqLTEM->iop->lastTxAt = pMillis();
+    S__setTxIrq(true);                                                  // THR IRQ, ISR fills FIFO from queue as space is available
+}
+
+
+/**
+ *	@brief Test for all queued TX data written to bridge FIFO.
+ */
+bool IOP_isTxIdle()
+{
+    return g_lqLTEM->iop->txPending == 0 && g_lqLTEM->iop->txQueueTail == g_lqLTEM->iop->txQueueHead;
 }
 
 
@@ -224,9 +314,37 @@ void IOP_startTx(const char *sendData, uint16_t sendSz)
 void IOP_forceTx(const char *sendData, uint16_t sendSz)
 {
     ASSERT(sendSz <= SC16IS7xx__FIFO_bufferSz);
+
+    S__setTxIrq(false);                                                 // abandon queued TX
+    g_lqLTEM->iop->txPending = 0;
+    g_lqLTEM->iop->txQueueTail = g_lqLTEM->iop->txQueueHead;
     SC16IS7xx_resetFifo(SC16IS7xx_FIFO_resetActionTx);
     pDelay(1);
-    SC16IS7xx_write(sendData, SC16IS7xx__FIFO_bufferSz);
+    SC16IS7xx_write(sendData, sendSz);
+}
+
+
+/**
+ *	@brief Set the bridge side UART baud rate and clear any chars garbled by the rate change.
+ */
+bool IOP_setBaudRate(uint32_t baudRate)
+{
+    if (!SC16IS7xx_setBaudRate(baudRate))
+        return false;
+
+    g_lqLTEM->iop->baudRate = baudRate;
+    SC16IS7xx_resetFifo(SC16IS7xx_FIFO_resetActionRx);
+    IOP_resetRxBuffer();
+    return true;
+}
+
+
+/**
+ *	@brief Get the time in milliseconds for the UART to fill the bridge FIFO at the current baud rate.
+ */
+uint16_t IOP_getFifoFillPeriod()
+{
+    return (uint16_t)((10UL * SC16IS7xx__FIFO_bufferSz * 1000) / g_lqLTEM->iop->baudRate) + 1;       // 10 bits/char on wire
 }
 
 
@@ -235,7 +353,7 @@ void IOP_forceTx(const char *sendData, uint16_t sendSz)
  */
 uint32_t IOP_getRxIdleDuration()
 {
-    return pMillis() - g_lqLTEM.iop->lastRxAt;
+    return pMillis() - g_lqLTEM->iop->lastRxAt;
 }
 
 
@@ -244,7 +362,125 @@ uint32_t IOP_getRxIdleDuration()
  */
 void IOP_resetRxBuffer()
 {
-    cbffr_reset(g_lqLTEM.iop->rxBffr);
+    #ifdef LTEMC_SPI_DMA
+    while (g_lqLTEM->iop->rxDmaPending > 0) {}                           // let in-flight FIFO drain land before reset
+    #endif
+    cbffr_reset(g_lqLTEM->iop->rxBffr);
+    g_lqLTEM->iop->rxResyncPending = false;                              // empty buffer is a line boundary
+    g_lqLTEM->iop->urcCandidates = g_lqLTEM->iop->rxDataXfer ? 0 : g_lqLTEM->iop->urcActive;
+    g_lqLTEM->iop->urcLineAt = g_lqLTEM->iop->rxCommitCnt;
+    g_lqLTEM->iop->urcLinePos = 0;
+    g_lqLTEM->iop->urcMatched = -1;
+    IOP_resumeRxFlow();
+}
+
+
+/**
+ *	@brief Start a data transfer reading data from the RX buffer, URC classification is suspended.
+ */
+void IOP_beginRxDataXfer()
+{
+    g_lqLTEM->iop->rxDataXfer = true;                                   // ISR suspends classification at its next commit
+    g_lqLTEM->iop->rxDataXferAt = S__rxTailAt();
+}
+
+
+/**
+ *	@brief End the data transfer, URC events for lines the transfer read are marked and not serviced.
+ */
+void IOP_endRxDataXfer()
+{
+    iop_t *iop = g_lqLTEM->iop;
+    uint32_t xferSz = S__rxTailAt() - iop->rxDataXferAt;                // RX positions read by transfer
+
+    for (uint8_t indx = iop->urcQueueTail; indx != iop->urcQueueHead; indx = (indx + 1) % ltem__urcQueueSz)
+    {
+        if (iop->urcQueue[indx].rxAt - iop->rxDataXferAt < xferSz)      // classified before suspension took effect
+            iop->urcQueue[indx].inDataXfer = true;
+    }
+    iop->rxDataXfer = false;                                            // classification resumes at next line start
+}
+
+
+/**
+ *	@brief Resume draining the bridge RX FIFO once RX buffer consumers have made room (LTEMC_HW_FLOWCTRL).
+ */
+void IOP_resumeRxFlow()
+{
+    #ifdef LTEMC_HW_FLOWCTRL
+    if (g_lqLTEM->iop->rxFlowHalted && cbffr_getVacant(g_lqLTEM->iop->rxBffr) >= IOP__rxFlowResumeVacancy)
+    {
+        g_lqLTEM->iop->rxFlowHalted = false;
+        S__isrHold();                                                   // bridgeIer is shared with the ISR
+        SC16IS7xx_setRxIrq(true);                                       // chars held in FIFO raise RX IRQ on enable
+        S__isrRelease();
+    }
+    #endif
+}
+
+
+/**
+ *	@brief Get a contiguous block of received chars from the RX buffer, spanning the ring wrap if necessary.
+ *  @details If the ring block ends at the buffer end, chars continuing at the ring start are mirrored into the slack 
+ *           following the ring (up to IOP__rxBufferSlackSz) and returned as part of the same block.
+ *  @param blockPtr [out] Pointer to the start of the block.
+ *  @param requestSz [in] Maximum number of chars requested.
+ *  @return Number of contiguous chars available at blockPtr.
+ */
+uint16_t IOP_rxPopBlock(char **blockPtr, uint16_t requestSz)
+{
+    cbuffer_t *rxBffr = g_lqLTEM->iop->rxBffr;
+    char *ringEnd = g_lqLTEM->iop->rxRaw + ltem__bufferSz_rx;
+
+    uint16_t blockSz = cbffr_popBlock(rxBffr, blockPtr, requestSz);
+    g_lqLTEM->iop->rxPopWrapSz = 0;
+
+    if (blockSz < requestSz && *blockPtr + blockSz == ringEnd)             // block stopped at ring end, data continues at ring start
+    {
+        uint16_t occupied = cbffr_getOccupied(rxBffr);
+        uint16_t wrapSz = (occupied > blockSz) ? occupied - blockSz : 0;
+        wrapSz = MIN(wrapSz, requestSz - blockSz);
+        wrapSz = MIN(wrapSz, IOP__rxBufferSlackSz);
+
+        memcpy(ringEnd, g_lqLTEM->iop->rxRaw, wrapSz);                       // mirror into slack, ISR won't write there until ring head wraps again
+        g_lqLTEM->iop->rxPopWrapSz = wrapSz;
+        blockSz += wrapSz;
+    }
+    return blockSz;
+}
+
+
+/**
+ *	@brief Commit (remove) the block from the last IOP_rxPopBlock() from the RX buffer, including any mirrored wrap chars.
+ */
+void IOP_rxPopBlockFinalize()
+{
+    cbffr_popBlockFinalize(g_lqLTEM->iop->rxBffr, true);
+
+    if (g_lqLTEM->iop->rxPopWrapSz > 0)                                      // commit mirrored chars at ring start
+    {
+        char *wrapPtr;
+        cbffr_popBlock(g_lqLTEM->iop->rxBffr, &wrapPtr, g_lqLTEM->iop->rxPopWrapSz);
+        cbffr_popBlockFinalize(g_lqLTEM->iop->rxBffr, true);
+        g_lqLTEM->iop->rxPopWrapSz = 0;
+    }
+    IOP_resumeRxFlow();
+}
+
+
+/**
+ *	@brief Wait for new chars in the RX buffer (ISR signal) or timeout.
+ */
+void IOP_awaitRx(uint32_t timeoutMS)
+{
+    if (!g_lqLTEM->iop->rxSignalled)                                        // RX since last wait, return to consume
+    {
+        if (g_lqLTEM->waitCB != NULL && timeoutMS > 0)
+            g_lqLTEM->waitCB(timeoutMS);
+        else
+            pYield();
+    }
+    g_lqLTEM->iop->rxSignalled = false;
 }
 
 
@@ -265,15 +501,54 @@ static inline uint8_t S_convertCharToContextId(const char cntxtChar)
 
 
 
+/**
+ *	@brief Service IRQ for the device instance in a dispatch slot, binding the device for the duration of the ISR.
+ *  @param slot [in] ISR dispatch slot assigned to device in IOP_attachIrq().
+ */
+static void S__isrDispatch(uint8_t slot)
+{
+    ltemDevice_t *isrBound = g_lqLTEMIsrBinding.device;                                     // restore on exit, ISR may preempt another device's service
+    g_lqLTEMIsrBinding.device = s_isrDevices[slot];
+    S_interruptCallbackISR();
+    g_lqLTEMIsrBinding.device = isrBound;
+}
+
+static void S__isrDispatch0() { S__isrDispatch(0); }
+static void S__isrDispatch1() { S__isrDispatch(1); }
+
+
 /**
  *	@brief ISR for NXP UART interrupt events, the NXP UART performs all serial I/O with BGx.
+ *  @details Service is deferred while the foreground holds the ISR off (S__isrHold), the IRQ line stays asserted and is
+ *           serviced by S__isrRelease(). With LTEMC_SPI_DMA, service is also deferred while a DMA transfer (any device)
+ *           holds the SPI bus, the transfer's completion services it (S__isrServiceDeferred), the ISR never waits on the bus.
  */
 static void S_interruptCallbackISR()
+{
+    bool deferred = g_lqLTEM->iop->isrHeld;
+    #ifdef LTEMC_SPI_DMA
+    deferred = deferred || SC16IS7xx_isXferActive();
+    #endif
+
+    if (deferred)
+    {
+        g_lqLTEM->iop->isrPending = true;
+        return;
+    }
+    g_lqLTEM->iop->isrPending = false;                                                      // service covers all pending sources
+    S__isrService();
+}
+
+
+/**
+ *	@brief Service the bridge interrupt sources until the IRQ line is released.
+ */
+static void S__isrService()
 {
     /* ----------------------------------------------------------------------------------------------------------------
-     * NOTE: The IIR, TXLVL and RXLVL are read seemingly redundantly, this is required to ensure NXP SC16IS741
-     * IRQ line is reset (belt AND suspenders).  During initial testing it was determined that without this 
-     * duplication of register reads IRQ would latch in active IRQ state randomly.
+     * NOTE: Each pass of the service loop works from a single register snapshot (SC16IS7xx_readIsrState), only the
+     * registers needed for the pending source are read. The IIR re-read at the top of each pass and the IRQ pin check
+     * at exit ensure the NXP SC16IS741 IRQ line is released before leaving the ISR.
      * ------------------------------------------------------------------------------------------------------------- */
     /*
     * IIR servicing:
@@ -281,100 +556,114 @@ static void S_interruptCallbackISR()
     *   write (THR): buffer emptied sufficiently to send more chars
     */
 
-    SC16IS7xx_IIR iirVal;
-    uint8_t rxLevel;
-    uint8_t txLevel;
+    SC16IS7xx_isrState_t isrState;
+    bool rxReceived = false;
+
+    #ifdef LTEMC_SPI_DMA
+    if (g_lqLTEM->iop->rxDmaPending > 0)                                                     // FIFO drain in flight, DMA completion re-services IRQ
+        return;
+    #endif
 
     retryIsr:
 
-    iirVal.reg = SC16IS7xx_readReg(SC16IS7xx_IIR_regAddr);
-    do
+    while (SC16IS7xx_readIsrState(&isrState))
     {
-        uint8_t regReads = 0;
-        while(iirVal.IRQ_nPENDING == 1 && regReads < 60)                               // wait for register, IRQ was signaled; safety limit at 60 in case of error gpio
-        {
-            iirVal.reg = SC16IS7xx_readReg(SC16IS7xx_IIR_regAddr);
-            PRINTF(dbgColor__dRed, "*");
-            regReads++;
-        }
-
-        txLevel = SC16IS7xx_readReg(SC16IS7xx_TXLVL_regAddr);
-        rxLevel = SC16IS7xx_readReg(SC16IS7xx_RXLVL_regAddr);
-        PRINTF(dbgColor__white, "\rISR[%02X/t%d/r%d-iSrc=%d ", iirVal.reg, txLevel, rxLevel, iirVal.IRQ_SOURCE);
+        PRINTF(dbgColor__white, "\rISR[%02X/t%d/r%d-iSrc=%d ", isrState.iir.reg, isrState.txLevel, isrState.rxLevel, isrState.iir.IRQ_SOURCE);
 
         // RX Error
-        if (iirVal.IRQ_SOURCE == 3)                                                         // priority 1 -- receiver line status error : clear fifo of bad char
+        if (isrState.iir.IRQ_SOURCE == 3)                                                   // priority 1 -- receiver line status error : clear fifo of bad char
         {
-            uint8_t lnStatus = SC16IS7xx_readReg(SC16IS7xx_LSR_regAddr);
-            PRINTF(dbgColor__error, "rxERR(%02X)-lvl=%d ", lnStatus, rxLevel);
-            PRINTF(dbgColor__warn, "bffrO=%d ", cbffr_getOccupied(g_lqLTEM.iop->rxBffr));
+            PRINTF(dbgColor__error, "rxERR(%02X)-lvl=%d ", isrState.lsr.reg, isrState.rxLevel);
+            PRINTF(dbgColor__warn, "bffrO=%d ", cbffr_getOccupied(g_lqLTEM->iop->rxBffr));
 
             #if _DEBUG > 2
                 PRINTF(dbgColor__yellow, " >FIFO Dump\r");
                 char fifoTop;
-                for (size_t i = 0; i < rxLevel; i++)
+                uint8_t lnStatus;
+                for (size_t i = 0; i < isrState.rxLevel; i++)
                 {
                     lnStatus = SC16IS7xx_readReg(SC16IS7xx_LSR_regAddr);
                     SC16IS7xx_read(&fifoTop, 1);
                     PRINTF(dbgColor__yellow, " >%02d-%02d 0x%02X\r", i, fifoTop, lnStatus);
                 }
-            #elif _DEBUG > 0
-                char dbg[65] = {0};
-                SC16IS7xx_read(dbg, 64);
-                SC16IS7xx_flushRxFifo();
+                S__rxDiscardISR(0, isrState.rxLevel);
             #else
-                ASSERT(false);                                                              // should have caught earlier, dead now.
+                S__rxDiscardISR(isrState.rxLevel, isrState.rxLevel);                        // drop FIFO contents, chars can't be trusted
             #endif
+            g_lqLTEM->iop->rxLineErrorCnt++;
         }
 
         // RX - read data from UART to rxBuffer
-        if (iirVal.IRQ_SOURCE == 2 || iirVal.IRQ_SOURCE == 6)                               // priority 2 -- receiver RHR full (src=2), receiver time-out (src=6)
+        else if (isrState.iir.IRQ_SOURCE == 2 || isrState.iir.IRQ_SOURCE == 6)              // priority 2 -- receiver RHR full (src=2), receiver time-out (src=6)
         {
-            if (rxLevel > 0)
+            #ifdef LTEMC_HW_FLOWCTRL
+            if (cbffr_getVacant(g_lqLTEM->iop->rxBffr) < isrState.rxLevel)                  // RX buffer can't take FIFO, stop draining: FIFO fills and RTS halts BGx
+            {
+                PRINTF(dbgColor__warn, "-rxHalt ");
+                SC16IS7xx_setRxIrq(false);
+                g_lqLTEM->iop->rxFlowHalted = true;
+                continue;
+            }
+            #endif
+
+            if (isrState.rxLevel > 0)
             {
-                g_lqLTEM.iop->lastRxAt = pMillis();
+                g_lqLTEM->iop->lastRxAt = pMillis();
+                rxReceived = true;
+
+                if (g_lqLTEM->iop->rxResyncPending)                                          // recovering from drop, discard through next line boundary
+                {
+                    S__rxResyncISR(isrState.rxLevel);
+                    continue;
+                }
+
+                #ifdef LTEMC_SPI_DMA
+                g_lqLTEM->iop->rxDmaPending = isrState.rxLevel;
+                if (S__rxDmaStart())
+                    return;                                                                 // servicing resumes in S__rxDmaCompleteISR()
+                #else
                 char *bAddr;
-                rxLevel = SC16IS7xx_readReg(SC16IS7xx_RXLVL_regAddr);
+                uint16_t spillSz = 0;
 
-                uint16_t bWrCnt = cbffr_pushBlock(g_lqLTEM.iop->rxBffr, &bAddr, rxLevel);   // get contiguous block to write from UART
-                PRINTF(dbgColor__dYellow, "-rx(%p:%d) -Bo=%d ", bAddr, bWrCnt, cbffr_getOccupied(g_lqLTEM.iop->rxBffr));
-                SC16IS7xx_read(bAddr, bWrCnt);
-                cbffr_pushBlockFinalize(g_lqLTEM.iop->rxBffr, true);
+                uint16_t bWrCnt = cbffr_pushBlock(g_lqLTEM->iop->rxBffr, &bAddr, isrState.rxLevel);     // get contiguous block to write from UART
+                if (bWrCnt < isrState.rxLevel && bAddr + bWrCnt == g_lqLTEM->iop->rxRaw + ltem__bufferSz_rx)
+                {
+                    spillSz = isrState.rxLevel - bWrCnt;                                    // block ends at ring end, read remainder into slack with same transfer
+                }
+                PRINTF(dbgColor__dYellow, "-rx(%p:%d+%d) -Bo=%d ", bAddr, bWrCnt, spillSz, cbffr_getOccupied(g_lqLTEM->iop->rxBffr));
+                if (bWrCnt + spillSz > 0)
+                    SC16IS7xx_read(bAddr, bWrCnt + spillSz);
+                S__rxCommitISR(bAddr, bWrCnt);
+                uint16_t readCnt = bWrCnt + spillSz;
 
-                if (bWrCnt < rxLevel)                                                       // pushBlock only partially emptied UART
+                if (spillSz > 0)
+                {
+                    bWrCnt += S__rxCommitSpill(spillSz);
+                }
+                else if (bWrCnt < isrState.rxLevel)                                         // ring wrapped (buffer not using slack) or RX buffer full
                 {
-                    rxLevel = SC16IS7xx_readReg(SC16IS7xx_RXLVL_regAddr);                   // get new rx number, push new receipts
-                    bWrCnt = cbffr_pushBlock(g_lqLTEM.iop->rxBffr, &bAddr, rxLevel);
-                    PRINTF(dbgColor__dYellow, "-Wrx(%p:%d) -Bo=%d ", bAddr, bWrCnt, cbffr_getOccupied(g_lqLTEM.iop->rxBffr));
-                    SC16IS7xx_read(bAddr, bWrCnt);
-                    cbffr_pushBlockFinalize(g_lqLTEM.iop->rxBffr, true);
+                    uint16_t wrapCnt = cbffr_pushBlock(g_lqLTEM->iop->rxBffr, &bAddr, isrState.rxLevel - bWrCnt);
+                    if (wrapCnt > 0)
+                        SC16IS7xx_read(bAddr, wrapCnt);
+                    S__rxCommitISR(bAddr, wrapCnt);
+                    bWrCnt += wrapCnt;
+                    readCnt += wrapCnt;
                 }
-                rxLevel = SC16IS7xx_readReg(SC16IS7xx_RXLVL_regAddr);
-                ASSERT(rxLevel < SC16IS7xx__FIFO_bufferSz / 4);                             // bail if UART still not empty: overflow imminent
 
-                iirVal.reg = SC16IS7xx_readReg(SC16IS7xx_IIR_regAddr);
-                rxLevel = SC16IS7xx_readReg(SC16IS7xx_RXLVL_regAddr);
-                PRINTF(dbgColor__white, "--rxLvl=%d,iir=%02X ", rxLevel, iirVal.reg);
+                if (bWrCnt < isrState.rxLevel)                                              // overflow: RX buffer full, drop newest chars
+                {
+                    S__rxDiscardISR(isrState.rxLevel - readCnt, isrState.rxLevel - bWrCnt);
+                    g_lqLTEM->iop->rxOverflowCnt++;
+                }
+                #endif
             }
         }
 
         // TX - write data to UART from txBuffer
-        if (iirVal.IRQ_SOURCE == 1)                                                         // priority 3 -- transmit THR (threshold) : TX ready for more data
+        else if (isrState.iir.IRQ_SOURCE == 1)                                              // priority 3 -- transmit THR (threshold) : TX ready for more data
         {
-            PRINTF(dbgColor__dYellow, "-txP(%d) ", g_lqLTEM.iop->txPending);
-
-            if (g_lqLTEM.iop->txPending > 0)
-            {
-                ASSERT(g_lqLTEM.iop->txPending < UINT16_MAX);
-                ASSERT(g_lqLTEM.iop->txBffr != NULL);
-
-                txLevel = SC16IS7xx_readReg(SC16IS7xx_TXLVL_regAddr);
-
-                uint8_t blockSz = MIN(g_lqLTEM.iop->txPending, txLevel);                        // send what bridge buffer allows
-                SC16IS7xx_write(g_lqLTEM.iop->txBffr, blockSz);
-                g_lqLTEM.iop->txPending -= blockSz;
-                g_lqLTEM.iop->txBffr += blockSz;
-            }
+            PRINTF(dbgColor__dYellow, "-txP(%d) ", g_lqLTEM->iop->txPending);
+            S__txServiceISR(isrState.txLevel);
         }
 
         /* -- NOT USED --
@@ -382,25 +671,369 @@ static void S_interruptCallbackISR()
         // priority 6 -- receive XOFF/SpecChar
         // priority 7 -- nCTS, nRTS state change:
         */
-
-        iirVal.reg = SC16IS7xx_readReg(SC16IS7xx_IIR_regAddr);
-
-    } while (iirVal.IRQ_nPENDING == 0);
+    }
 
     PRINTF(dbgColor__white, "]\r");
 
-    gpioPinValue_t irqPin = platform_readPin(g_lqLTEM.pinConfig.irqPin);
+    gpioPinValue_t irqPin = platform_readPin(g_lqLTEM->pinConfig.irqPin);
     if (irqPin == gpioValue_low)
     {
-        iirVal.reg = SC16IS7xx_readReg(SC16IS7xx_IIR_regAddr);
-        txLevel = SC16IS7xx_readReg(SC16IS7xx_TXLVL_regAddr);
-        rxLevel = SC16IS7xx_readReg(SC16IS7xx_RXLVL_regAddr);
-
-        PRINTF(dbgColor__yellow, "^IRQ: nIRQ=%d,iir=%d,txLvl=%d,rxLvl=%d^ ", iirVal.IRQ_nPENDING, iirVal.reg, txLevel, rxLevel);
+        PRINTF(dbgColor__yellow, "^IRQ: iir=%02X^ ", isrState.iir.reg);
         goto retryIsr;
     }
+
+    if (rxReceived)
+        S__rxSignalISR();                                                                   // wake foreground waiting on RX
+}
+
+
+/**
+ *	@brief Enter a foreground critical section with the ISR, an IRQ arriving while held is deferred to S__isrRelease().
+ *  @note Not nested, foreground only.
+ */
+static void S__isrHold()
+{
+    g_lqLTEM->iop->isrHeld = true;
+}
+
+
+/**
+ *	@brief Exit the foreground critical section with the ISR, servicing any IRQ deferred while held.
+ *  @details The bridge IRQ is edge triggered and stays asserted until serviced, a deferred IRQ raises no new edge.
+ */
+static void S__isrRelease()
+{
+    g_lqLTEM->iop->isrHeld = false;
+    while (g_lqLTEM->iop->isrPending)
+    {
+        g_lqLTEM->iop->isrHeld = true;                                                      // an IRQ during service is deferred again
+        g_lqLTEM->iop->isrPending = false;
+        S__isrService();
+        g_lqLTEM->iop->isrHeld = false;
+    }
+}
+
+
+/**
+ *	@brief Foreground enable/disable of the TX (THR) IRQ source, the bridgeIer update is protected from the ISR.
+ */
+static void S__setTxIrq(bool enabled)
+{
+    S__isrHold();
+    SC16IS7xx_setTxIrq(enabled);
+    S__isrRelease();
+}
+
+
+/**
+ *	@brief Signal foreground waiters (IOP_awaitRx) that chars were added to the RX buffer.
+ */
+static void S__rxSignalISR()
+{
+    g_lqLTEM->iop->rxSignalled = true;
+    if (g_lqLTEM->signalCB != NULL)
+        g_lqLTEM->signalCB();
+}
+
+
+/**
+ *	@brief Fill available TX FIFO space from the TX descriptor queue, continuing across descriptors (scatter-gather).
+ *  @param txLevel [in] Spaces available in bridge TX FIFO.
+ */
+static void S__txServiceISR(uint8_t txLevel)
+{
+    while (txLevel > 0)
+    {
+        if (g_lqLTEM->iop->txPending == 0)                                                   // current descriptor sent, load next
+        {
+            if (g_lqLTEM->iop->txQueueTail == g_lqLTEM->iop->txQueueHead)
+            {
+                SC16IS7xx_setTxIrq(false);                                                  // queue drained, IOP_startTx() re-enables
+                return;
+            }
+            iopTxDesc_t *txDesc = &g_lqLTEM->iop->txQueue[g_lqLTEM->iop->txQueueTail];
+            g_lqLTEM->iop->txBffr = (char *)txDesc->data;
+            g_lqLTEM->iop->txPending = txDesc->size;
+            g_lqLTEM->iop->txQueueTail = (g_lqLTEM->iop->txQueueTail + 1) % IOP__txQueueSz;
+        }
+
+        uint8_t blockSz = MIN(g_lqLTEM->iop->txPending, txLevel);                            // send what bridge buffer allows
+        SC16IS7xx_write((char *)g_lqLTEM->iop->txBffr, blockSz);
+        g_lqLTEM->iop->txPending -= blockSz;
+        g_lqLTEM->iop->txBffr += blockSz;
+        txLevel -= blockSz;
+    }
+}
+
+
+/**
+ *	@brief Commit FIFO chars read past the RX ring end (into slack) to the ring start.
+ *  @param spillSz [in] Number of chars in slack following the ring end.
+ *  @return Number of chars committed to rxBffr, less than spillSz if RX buffer is full.
+ */
+static uint16_t S__rxCommitSpill(uint16_t spillSz)
+{
+    char *bAddr;
+    uint16_t wrapCnt = cbffr_pushBlock(g_lqLTEM->iop->rxBffr, &bAddr, spillSz);
+    PRINTF(dbgColor__dYellow, "-Wrx(%p:%d) ", bAddr, wrapCnt);
+    memcpy(bAddr, g_lqLTEM->iop->rxRaw + ltem__bufferSz_rx, wrapCnt);
+    S__rxCommitISR(bAddr, wrapCnt);
+    return wrapCnt;
+}
+
+
+/**
+ *	@brief Commit the block written since cbffr_pushBlock() to rxBffr, URC classifier sees each char as it is committed.
+ */
+static void S__rxCommitISR(const char *block, uint16_t blockSz)
+{
+    cbffr_pushBlockFinalize(g_lqLTEM->iop->rxBffr, true);
+    S__urcClassifyISR(block, blockSz);
+    g_lqLTEM->iop->rxCommitCnt += blockSz;
+}
+
+
+/**
+ *	@brief URC classifier, matches RX lines against the registered URC prefixes (urcTable) in a single pass.
+ *  @details Prefixes are matched in parallel from line start, each char narrows the candidate set (bit per urcTable
+ *           entry); most lines fail on their first char, the rest of the line then costs a compare per char. Candidate
+ *           lines are captured into the URC queue head slot, when the line's \n is committed a line matching a prefix
+ *           (longest) is queued as a URC event for ltem_eventMgr().
+ */
+static void S__urcClassifyISR(const char *block, uint16_t blockSz)
+{
+    iop_t *iop = g_lqLTEM->iop;
+
+    if (iop->rxDataXfer)                                                                    // data transfer underway, data is not URC lines
+    {
+        iop->urcCandidates = 0;
+        iop->urcMatched = -1;
+    }
+
+    for (uint16_t i = 0; i < blockSz; i++)
+    {
+        if (block[i] == '\n')                                                              // line end: queue match, start next line
+        {
+            if (iop->urcMatched >= 0)
+                S__urcQueueISR();
+            iop->urcMatched = -1;
+            iop->urcCandidates = iop->rxDataXfer ? 0 : iop->urcActive;
+            iop->urcLinePos = 0;
+            iop->urcLineAt = iop->rxCommitCnt + i + 1;
+            continue;
+        }
+        if (iop->urcCandidates == 0 && (iop->urcMatched < 0 || iop->urcLinePos == IOP__urcDetectBufferSz - 1))
+            continue;                                                                       // line can't be a registered URC, or URC capture full
+
+        iop->urcQueue[iop->urcQueueHead].line[iop->urcLinePos] = block[i];                  // head slot is free (not yet queued)
+        for (uint8_t indx = 0; indx < ltem__urcPrefixCnt; indx++)
+        {
+            uint16_t candidate = 1 << indx;
+            if (!(iop->urcCandidates & candidate))
+                continue;
+            if (iop->urcTable[indx].prefix[iop->urcLinePos] != block[i])
+            {
+                iop->urcCandidates &= ~candidate;
+            }
+            else if (iop->urcLinePos + 1 == iop->urcTable[indx].prefixSz)                   // prefix complete, longer prefixes continue
+            {
+                iop->urcMatched = indx;
+                iop->urcCandidates &= ~candidate;
+            }
+        }
+        iop->urcLinePos++;
+    }
+}
+
+
+/**
+ *	@brief Queue the URC line captured in the URC queue head slot as a URC event, timestamped with its arrival.
+ */
+static void S__urcQueueISR()
+{
+    iop_t *iop = g_lqLTEM->iop;
+    uint8_t nextHead = (iop->urcQueueHead + 1) % ltem__urcQueueSz;
+    if (nextHead == iop->urcQueueTail)                                                      // queue full, ltem_eventMgr() not keeping up
+    {
+        iop->urcDroppedCnt++;
+        return;
+    }
+
+    urcEvent_t *urcEvent = &iop->urcQueue[iop->urcQueueHead];
+    uint8_t lineLen = iop->urcLinePos;
+    if (lineLen > 0 && urcEvent->line[lineLen - 1] == '\r')
+        lineLen--;
+    urcEvent->line[lineLen] = '\0';
+    urcEvent->urcIndx = iop->urcMatched;
+    urcEvent->prefix = iop->urcTable[iop->urcMatched].prefix;
+    urcEvent->arrivedAt = iop->lastRxAt;
+    urcEvent->rxAt = iop->urcLineAt;
+    urcEvent->inDataXfer = false;
+    iop->urcQueueHead = nextHead;
+}
+
+
+/**
+ *	@brief RX position of the rxBffr tail, the next char a reader pops.
+ *  @details Read until the ISR has not committed chars between the reads of rxCommitCnt and rxBffr occupied.
+ */
+static uint32_t S__rxTailAt()
+{
+    uint32_t commitCnt;
+    uint16_t occupied;
+    do
+    {
+        commitCnt = g_lqLTEM->iop->rxCommitCnt;
+        occupied = cbffr_getOccupied(g_lqLTEM->iop->rxBffr);
+    } while (commitCnt != g_lqLTEM->iop->rxCommitCnt);
+    return commitCnt - occupied;
 }
 
 
+/**
+ *	@brief RX drop policy: discard chars, account for them and resync RX stream at the next line boundary.
+ *  @details Chars already in rxBffr are kept (drop newest). The partial line following the drop is discarded by
+ *           S__rxResyncISR(), leaving an incomplete response that ATCMD reports as a timeout.
+ *  @param unreadCnt [in] Chars still in bridge FIFO to read and discard.
+ *  @param dropCnt [in] Total chars dropped, including any read but not committed to rxBffr.
+ */
+static void S__rxDiscardISR(uint8_t unreadCnt, uint16_t dropCnt)
+{
+    char discard[IOP__uartFIFOBufferSz];
+
+    if (unreadCnt > 0)
+        SC16IS7xx_read(discard, MIN(unreadCnt, sizeof(discard)));
+
+    PRINTF(dbgColor__warn, "-rxDrop(%d) ", dropCnt);
+    g_lqLTEM->iop->rxDroppedCnt += dropCnt;
+    g_lqLTEM->iop->urcCandidates = 0;                                                        // partial line is not classified, resync restarts at line start
+    g_lqLTEM->iop->urcMatched = -1;
+    g_lqLTEM->iop->rxResyncPending = true;
+    g_lqLTEM->iop->rxFaultNotifyPending = true;
+}
+
+
+/**
+ *	@brief Read FIFO discarding chars through the next \n, then resume normal RX with any chars following it.
+ *  @param rxLevel [in] Chars waiting in bridge FIFO.
+ */
+static void S__rxResyncISR(uint8_t rxLevel)
+{
+    char fifo[IOP__uartFIFOBufferSz];
+    rxLevel = MIN(rxLevel, sizeof(fifo));
+    SC16IS7xx_read(fifo, rxLevel);
+
+    char *eol = memchr(fifo, '\n', rxLevel);
+    if (eol == NULL)
+    {
+        g_lqLTEM->iop->rxDroppedCnt += rxLevel;
+        return;
+    }
+    uint8_t syncIndx = eol - fifo + 1;
+    g_lqLTEM->iop->rxDroppedCnt += syncIndx;
+    g_lqLTEM->iop->rxResyncPending = false;
+    g_lqLTEM->iop->urcCandidates = g_lqLTEM->iop->rxDataXfer ? 0 : g_lqLTEM->iop->urcActive;
+    g_lqLTEM->iop->urcLinePos = 0;
+    g_lqLTEM->iop->urcLineAt = g_lqLTEM->iop->rxCommitCnt;
+    PRINTF(dbgColor__warn, "-rxSync(%d) ", syncIndx);
+
+    uint8_t keepCnt = rxLevel - syncIndx;
+    char *src = fifo + syncIndx;
+    while (keepCnt > 0)                                                                     // commit chars following boundary, may wrap
+    {
+        char *bAddr;
+        uint16_t bWrCnt = cbffr_pushBlock(g_lqLTEM->iop->rxBffr, &bAddr, keepCnt);
+        memcpy(bAddr, src, bWrCnt);
+        S__rxCommitISR(bAddr, bWrCnt);
+        if (bWrCnt == 0)
+        {
+            S__rxDiscardISR(0, keepCnt);                                                    // RX buffer full
+            g_lqLTEM->iop->rxOverflowCnt++;
+            return;
+        }
+        src += bWrCnt;
+        keepCnt -= bWrCnt;
+    }
+}
+
+
+#ifdef LTEMC_SPI_DMA
+
+/**
+ *	@brief Start DMA transfer of the pending FIFO drain into the RX buffer.
+ *  @return True if transfer started, false if RX buffer is full (FIFO contents dropped).
+ */
+static bool S__rxDmaStart()
+{
+    char *bAddr;
+    uint16_t bWrCnt = cbffr_pushBlock(g_lqLTEM->iop->rxBffr, &bAddr, g_lqLTEM->iop->rxDmaPending);
+    g_lqLTEM->iop->rxDmaSpillSz = 0;
+    if (bWrCnt < g_lqLTEM->iop->rxDmaPending && bAddr + bWrCnt == g_lqLTEM->iop->rxRaw + ltem__bufferSz_rx)
+    {
+        g_lqLTEM->iop->rxDmaSpillSz = g_lqLTEM->iop->rxDmaPending - bWrCnt;                  // block ends at ring end, transfer remainder into slack
+    }
+
+    if (bWrCnt + g_lqLTEM->iop->rxDmaSpillSz == 0)                                          // overflow: RX buffer full, drop newest chars
+    {
+        cbffr_pushBlockFinalize(g_lqLTEM->iop->rxBffr, true);
+        S__rxDiscardISR(g_lqLTEM->iop->rxDmaPending, g_lqLTEM->iop->rxDmaPending);
+        g_lqLTEM->iop->rxOverflowCnt++;
+        g_lqLTEM->iop->rxDmaPending = 0;
+        return false;
+    }
+
+    PRINTF(dbgColor__dYellow, "-rxDMA(%p:%d+%d) ", bAddr, bWrCnt, g_lqLTEM->iop->rxDmaSpillSz);
+    g_lqLTEM->iop->rxDmaBlock = bAddr;
+    g_lqLTEM->iop->rxDmaBlockSz = bWrCnt;
+    SC16IS7xx_readAsync(bAddr, bWrCnt + g_lqLTEM->iop->rxDmaSpillSz, S__rxDmaCompleteISR);
+    return true;
+}
+
+
+/**
+ *	@brief DMA complete, commit block (and any slack spill) to RX buffer, drop what didn't fit, then resume IRQ servicing.
+ */
+static void S__rxDmaCompleteISR()
+{
+    S__rxCommitISR(g_lqLTEM->iop->rxDmaBlock, g_lqLTEM->iop->rxDmaBlockSz);
+    uint8_t unreadCnt = g_lqLTEM->iop->rxDmaPending - g_lqLTEM->iop->rxDmaBlockSz - g_lqLTEM->iop->rxDmaSpillSz;
+    uint16_t dropCnt = unreadCnt;
+
+    if (g_lqLTEM->iop->rxDmaSpillSz > 0)                                                     // ring wrapped, remainder landed in slack
+    {
+        dropCnt += g_lqLTEM->iop->rxDmaSpillSz - S__rxCommitSpill(g_lqLTEM->iop->rxDmaSpillSz);
+    }
+    if (dropCnt > 0)                                                                        // overflow: RX buffer full, drop newest chars
+    {
+        S__rxDiscardISR(unreadCnt, dropCnt);
+        g_lqLTEM->iop->rxOverflowCnt++;
+    }
+    g_lqLTEM->iop->rxDmaPending = 0;
+    S__rxSignalISR();
+    S_interruptCallbackISR();                                                               // IRQ still asserted for any remaining sources
+    S__isrServiceDeferred();
+}
+
+
+/**
+ *	@brief Service IRQs of other device instances deferred while the DMA transfer held the SPI bus.
+ *  @details A device IRQ is edge triggered and stays asserted while deferred, no new edge arrives to dispatch it.
+ */
+static void S__isrServiceDeferred()
+{
+    for (uint8_t slot = 0; slot < ltem__deviceMax; slot++)
+    {
+        if (SC16IS7xx_isXferActive())                                                       // service started a new transfer, its completion continues
+            return;
+
+        ltemDevice_t *device = s_isrDevices[slot];
+        if (device != NULL && device->iop->isrPending && !device->iop->isrHeld)             // held: foreground release services
+            S__isrDispatch(slot);
+    }
+}
+
+#endif
+
+
 #pragma endregion
 
@@ -59,21 +59,54 @@ void IOP_attachIrq();
 void IOP_detachIrq();
 
 
+/**
+ *	@brief Release the Input/Output Process subsystem, detaches the IRQ and frees the device's ISR dispatch slot.
+ */
+void IOP_destroy();
+
+
+/**
+ *	@brief Set the bridge FIFO trigger levels for the type of traffic expected.
+ *  @details Command profile uses low RX trigger for short responses, data profile uses high RX/TX triggers for bulk transfers.
+ *           ATCMD switches to the data profile while a dataMode handler is active. No action if profile is already applied.
+ *  @param profile [in] The traffic profile to apply.
+ */
+void IOP_setTrafficProfile(iopTrafficProfile_t profile);
+
+
 /**
  *	@brief Verify LTEm firmware has started and is ready for driver operations.
  */
 bool IOP_awaitAppReady();
 
 
+/**
+ *	@brief Queue a block of data for TX without starting TX. Used to chain blocks (prefix, payload, EOT) sent by a following IOP_startTx().
+ *  @details Data is not copied, the sendData buffer must remain valid until sent (see IOP_isTxIdle()).
+ *  @param sendData [in] Pointer to char data to send out.
+ *  @param sendSz [in] The number of characters to send.
+ *  @return False if the TX queue is full.
+ */
+bool IOP_enqueueTx(const char *sendData, uint16_t sendSz);
+
+
 /**
  *	@brief Perform a TX send operation. 
-    @details This call will block until TX is fully sent out to UART. The BGx module is synchronous, so no buffering is implemented (may change).
- *  @param sendData [in] Pointer to char data to send out, input buffer can be discarded following call.
+    @details Data is queued and sent by the ISR as bridge TX FIFO space is available, a partially full FIFO is topped up.
+             Blocks only while the TX queue is full. Data is not copied, the sendData buffer must remain valid until sent.
+ *  @param sendData [in] Pointer to char data to send out.
  *  @param sendSz [in] The number of characters to send.
  */
 void IOP_startTx(const char *sendData, uint16_t sendSz);
 
 
+/**
+ *	@brief Test for all queued TX data written to the bridge.
+ *  @return True if TX queue is empty and the current block is fully written to the bridge TX FIFO.
+ */
+bool IOP_isTxIdle();
+
+
 /**
  *	@brief Perform a forced TX send immediate operation. Intended for sending break type events to device.
  *  @details sendData must be less than 64 chars. This function aborts any TX and immediately posts data to UART.
@@ -83,6 +116,21 @@ void IOP_startTx(const char *sendData, uint16_t sendSz);
 void IOP_forceTx(const char *sendData, uint16_t sendSz);
 
 
+/**
+ *	@brief Set the bridge side UART baud rate. BGx rate must be changed (AT+IPR) prior to this call, see ltem_setBaudRate().
+ *  @details RX FIFO and RX buffer are cleared, chars received during the rate change are not valid.
+ *  @param baudRate [in] The new baud rate.
+ *  @return True if the bridge supports the rate and it was applied.
+ */
+bool IOP_setBaudRate(uint32_t baudRate);
+
+
+/**
+ *	@brief Get the time in milliseconds for the UART to fill the bridge FIFO at the current baud rate.
+ */
+uint16_t IOP_getFifoFillPeriod();
+
+
 /**
  *	@brief Check for RX progress/idle.
  *
@@ -114,9 +162,53 @@ uint32_t IOP_getRxIdleDuration();
 
 
 /**
- *	@brief Clear receive COMMAND/CORE response buffer.
+ *	@brief Clear receive COMMAND/CORE response buffer, restarting RX line resync and URC classification.
+ */
+void IOP_resetRxBuffer();
+
+
+/**
+ *	@brief Start a data transfer reading data from the RX buffer (RX data mode, streamed URC), URC classification is suspended.
+ *  @details Data is not classified as URC lines, events already queued for lines in the transfer are marked by IOP_endRxDataXfer().
+ */
+void IOP_beginRxDataXfer();
+
+
+/**
+ *	@brief End the data transfer started by IOP_beginRxDataXfer(), resuming URC classification at the next RX line.
+ *  @details Queued URC events for lines read by the transfer are marked inDataXfer and are not serviced.
+ */
+void IOP_endRxDataXfer();
+
+
+/**
+ *	@brief Resume draining the bridge RX FIFO if halted for flow control and the RX buffer has room (LTEMC_HW_FLOWCTRL).
+ *  @details Called by RX buffer consumers after removing data. No action if not built with LTEMC_HW_FLOWCTRL.
+ */
+void IOP_resumeRxFlow();
+
+
+/**
+ *	@brief Get a contiguous block of received chars from the RX buffer; blocks at the ring end continue through the RX buffer slack.
+ *  @param blockPtr [out] Pointer to the start of the block.
+ *  @param requestSz [in] Maximum number of chars requested.
+ *  @return Number of contiguous chars available at blockPtr.
+ */
+uint16_t IOP_rxPopBlock(char **blockPtr, uint16_t requestSz);
+
+
+/**
+ *	@brief Commit (remove) the block from the last IOP_rxPopBlock() and resume RX flow if halted.
+ */
+void IOP_rxPopBlockFinalize();
+
+
+/**
+ *	@brief Wait for new chars in the RX buffer. Returns immediately if chars were received since the last wait.
+ *  @details Sleeps in the application wait callback (see ltem_setWaitCallbacks()) or, if none registered, calls pYield() once.
+ *  @param timeoutMS [in] Maximum wait, callers wait again or time out per their own deadline.
  */
-void IOP_resetCoreRxBuffer();
+void IOP_awaitRx(uint32_t timeoutMS);
 
 
 // /**
@@ -44,8 +44,6 @@
 #define SRCFILE "MDM"                           // create SRCFILE (3 char) MACRO for lq-diagnostics ASSERT
 #include "ltemc-internal.h"
 
-extern ltemDevice_t g_lqLTEM;
-
 
 #define MIN(x, y) (((x)<(y)) ? (x):(y))
 #define MAX(x, y) (((x)>(y)) ? (x):(y))
@@ -53,6 +51,10 @@ extern ltemDevice_t g_lqLTEM;
 
 // private local declarations
 static cmdParseRslt_t S__iccidCompleteParser(ltemDevice_t *modem);
+static void S__imeiComplete(resultCode_t resultCode, const char *response);
+static void S__fwverComplete(resultCode_t resultCode, const char *response);
+static void S__mfgmodelComplete(resultCode_t resultCode, const char *response);
+static void S__iccidComplete(resultCode_t resultCode, const char *response);
 
 
 /* Public functions
@@ -62,61 +64,24 @@ static cmdParseRslt_t S__iccidCompleteParser(ltemDevice_t *modem);
 
 /**
  *  \brief Get the LTEm1 static device identification/provisioning information.
+ *  \details Missing values are queried with pipelined (queued) commands, each result is stored by its completion callback.
 */
 modemInfo_t *mdminfo_ltem()
 {
-    if (ATCMD_awaitLock(atcmd__defaultTimeout))
-    {
-        if (g_lqLTEM.modemInfo->imei[0] == 0)
-        {
-            atcmd_invokeReuseLock("AT+GSN");
-            if (atcmd_awaitResult() == resultCode__success)
-            {
-                strncpy(g_lqLTEM.modemInfo->imei, atcmd_getResponse(), ntwk__imeiSz);
-            }
-        }
+    if (g_lqLTEM->modemInfo->imei[0] == 0)
+        atcmd_enqueue(NULL, atcmd__noTimeoutChange, S__imeiComplete, "AT+GSN");
 
-        if (g_lqLTEM.modemInfo->fwver[0] == 0)
-        {
-            atcmd_invokeReuseLock("AT+QGMR");
-            if (atcmd_awaitResult() == resultCode__success)
-            {
-                char * eol;
-                if ((eol = strstr(atcmd_getResponse(), "\r\n")) != NULL)
-                {
-                    uint8_t sz = eol - atcmd_getResponse();
-                    memcpy(g_lqLTEM.modemInfo->fwver, atcmd_getResponse(), MIN(sz, ntwk__dvcFwVerSz));
-                }
-            }
-        }
+    if (g_lqLTEM->modemInfo->fwver[0] == 0)
+        atcmd_enqueue(NULL, atcmd__noTimeoutChange, S__fwverComplete, "AT+QGMR");
 
-        if (g_lqLTEM.modemInfo->mfgmodel[0] == 0)
-        {
-            atcmd_invokeReuseLock("ATI");
-            if (atcmd_awaitResult() == resultCode__success)
-            {
-                char * eol;
-                if ((eol = strstr(atcmd_getResponse(), "\r\nRevision")) != NULL)
-                {
-                    uint8_t sz = eol - atcmd_getResponse();
-                    memcpy(g_lqLTEM.modemInfo->mfgmodel, atcmd_getResponse(), MIN(sz, ntwk__dvcMfgSz));
-                    *(strchr(g_lqLTEM.modemInfo->mfgmodel, '\r')) = ':';
-                    *(strchr(g_lqLTEM.modemInfo->mfgmodel, '\n')) = ' ';
-                }
-            }
-        }
+    if (g_lqLTEM->modemInfo->mfgmodel[0] == 0)
+        atcmd_enqueue(NULL, atcmd__noTimeoutChange, S__mfgmodelComplete, "ATI");
 
-        if (g_lqLTEM.modemInfo->iccid[0] == 0)
-        {
-            atcmd_invokeReuseLock("AT+ICCID");
-            if (atcmd_awaitResultWithOptions(atcmd__defaultTimeout, S__iccidCompleteParser) == resultCode__success)
-            {
-                strncpy(g_lqLTEM.modemInfo->iccid, atcmd_getResponse(), ntwk__iccidSz);
-            }
-        }
-        atcmd_close();
-    }
-    return (modemInfo_t*)(g_lqLTEM.modemInfo);
+    if (g_lqLTEM->modemInfo->iccid[0] == 0)
+        atcmd_enqueue(S__iccidCompleteParser, atcmd__noTimeoutChange, S__iccidComplete, "AT+ICCID");
+
+    atcmd_awaitQueue();
+    return (modemInfo_t*)(g_lqLTEM->modemInfo);
 }
 
 
@@ -191,4 +156,54 @@ static cmdParseRslt_t S__iccidCompleteParser(ltemDevice_t *modem)
 }
 
 
+/**
+ *	\brief Queued AT+GSN completion, stores IMEI.
+ */
+static void S__imeiComplete(resultCode_t resultCode, const char *response)
+{
+    if (resultCode == resultCode__success)
+        strncpy(g_lqLTEM->modemInfo->imei, response, ntwk__imeiSz);
+}
+
+
+/**
+ *	\brief Queued AT+QGMR completion, stores firmware version (first response line).
+ */
+static void S__fwverComplete(resultCode_t resultCode, const char *response)
+{
+    const char *eol;
+    if (resultCode == resultCode__success && (eol = strstr(response, "\r\n")) != NULL)
+    {
+        uint8_t sz = eol - response;
+        memcpy(g_lqLTEM->modemInfo->fwver, response, MIN(sz, ntwk__dvcFwVerSz));
+    }
+}
+
+
+/**
+ *	\brief Queued ATI completion, stores manufacturer and model as "mfg: model".
+ */
+static void S__mfgmodelComplete(resultCode_t resultCode, const char *response)
+{
+    const char *eol;
+    if (resultCode == resultCode__success && (eol = strstr(response, "\r\nRevision")) != NULL)
+    {
+        uint8_t sz = eol - response;
+        memcpy(g_lqLTEM->modemInfo->mfgmodel, response, MIN(sz, ntwk__dvcMfgSz));
+        *(strchr(g_lqLTEM->modemInfo->mfgmodel, '\r')) = ':';
+        *(strchr(g_lqLTEM->modemInfo->mfgmodel, '\n')) = ' ';
+    }
+}
+
+
+/**
+ *	\brief Queued AT+ICCID completion, stores ICCID.
+ */
+static void S__iccidComplete(resultCode_t resultCode, const char *response)
+{
+    if (resultCode == resultCode__success)
+        strncpy(g_lqLTEM->modemInfo->iccid, response, ntwk__iccidSz);
+}
+
+
 #pragma endregion
@@ -43,8 +43,6 @@
 #include "ltemc-internal.h"
 #include "ltemc-mqtt.h"
 
-extern ltemDevice_t g_lqLTEM;
-
 
 #define MAX(x, y) (((x) > (y)) ? (x) : (y))
 #define MIN(x, y) (((x) < (y)) ? (x) : (y))
@@ -58,6 +56,18 @@ enum
     resultCode__parserPending = 0xFFFF
 };
 
+/* mqtt_startAsync() steps, in order of invoke
+ */
+enum mqttStartStep
+{
+    mqttStartStep_sslCfg = 0,
+    mqttStartStep_versionCfg,
+    mqttStartStep_open,
+    mqttStartStep_sessionCfg,
+    mqttStartStep_connect,
+    mqttStartStep_subscribe
+};
+
 // #define MQTT_ACTION_CMD_SZ 81
 // #define MQTT_CONNECT_CMD_SZ 300
 
@@ -67,7 +77,12 @@ enum
 
 static uint8_t S__findtopicIndx(mqttCtrl_t* mqttCntl, mqttTopicCtrl_t* topicCtrl);
 static resultCode_t S__notifyServerTopicChange(mqttCtrl_t* mqttCtrl, mqttTopicCtrl_t* topicCtrl, bool subscribe);
-static void S__mqttUrcHandler();
+static bool S__invokeTopicChange(mqttCtrl_t* mqttCtrl, mqttTopicCtrl_t* topicCtrl, bool subscribe);
+static resultCode_t S__mqttOpenResult(resultCode_t rslt);
+static resultCode_t S__mqttConnectResult(resultCode_t rslt);
+static resultCode_t S__mqttStartInvoke(mqttCtrl_t *mqttCtrl, ltemAsyncOp_t *asyncOp);
+static resultCode_t S__mqttStartStep(void *ctrl);
+static resultCode_t S__mqttUrcHandler(const urcEvent_t *urcEvent);
 
 //static cmdParseRslt_t S__mqttOpenStatusParser();
 static cmdParseRslt_t S__mqttOpenCompleteParser();
@@ -88,13 +103,16 @@ static cmdParseRslt_t S__mqttPublishCompleteParser();
 void mqtt_initControl(mqttCtrl_t *mqttCtrl, dataCntxt_t dataCntxt)
 {
     ASSERT(dataCntxt < dataCntxt__cnt);                         // valid streams index
-    ASSERT(g_lqLTEM.streams[dataCntxt] == 0);                   // context not already in use
+    ASSERT(g_lqLTEM->streams[dataCntxt] == 0);                   // context not already in use
 
     memset(mqttCtrl, 0, sizeof(mqttCtrl_t));
 
     mqttCtrl->streamType = streamType_MQTT;
     mqttCtrl->urcEvntHndlr = S__mqttUrcHandler;                 // for MQTT, URC handler performs all necessary functions
     mqttCtrl->dataRxHndlr = NULL;                               // marshalls data from buffer to app done by URC handler
+
+    ltem_registerUrcStream("+QMTRECV:", S__mqttUrcHandler);     // MQTT URCs dispatched by ltem_eventMgr(), message body streamed from rxBffr
+    ltem_registerUrc("+QMTSTAT:", S__mqttUrcHandler);
 }
 
 
@@ -159,50 +177,39 @@ resultCode_t mqtt_open(mqttCtrl_t *mqttCtrl)
     // if (mqttCtrl->state != mqttState_closed)                    // not in a closed state, (most) mqtt setting changes require closed connection
     //     return resultCode__preConditionFailed;
 
-    // set options prior to open
+    // set options prior to open, sent as one command line (skipped if in effect from prior open)
+    atcmdBatch_t batch;
+    atcmd_batchInit(&batch, atcmd__noTimeoutChange);
+
     if (mqttCtrl->useTls)
-    {
-        if (atcmd_tryInvoke("AT+QMTCFG=\"ssl\",%d,1,%d", mqttCtrl->dataCntxt, mqttCtrl->dataCntxt))
-        {
-            if (atcmd_awaitResult() != resultCode__success)
-                return resultCode__internalError;
-        }
-    }
+        atcmd_batchAddSetting(&batch, 2, "AT+QMTCFG=\"ssl\",%d,1,%d", mqttCtrl->dataCntxt, mqttCtrl->dataCntxt);
     // AT+QMTCFG="version",0,4
-    if (atcmd_tryInvoke("AT+QMTCFG=\"version\",%d,4", mqttCtrl->dataCntxt, mqttCtrl->mqttVersion))
-    {
-        if (atcmd_awaitResult() != resultCode__success)
-            return resultCode__internalError;
-    }
+    atcmd_batchAddSetting(&batch, 2, "AT+QMTCFG=\"version\",%d,4", mqttCtrl->dataCntxt, mqttCtrl->mqttVersion);
+
+    if (atcmd_batchExec(&batch) != resultCode__success)
+        return resultCode__internalError;
 
     // TYPICAL: AT+QMTOPEN=0,"iothub-dev-pelogical.azure-devices.net",8883
-    if (atcmd_tryInvoke("AT+QMTOPEN=%d,\"%s\",%d", mqttCtrl->dataCntxt, mqttCtrl->hostUrl, mqttCtrl->hostPort))
+    resultCode_t openRslt;
+    atcmdRetry_t retry;
+    atcmd_retryInit(&retry, atcmdRetryClass_mqttOpen);
+
+    do
     {
-        resultCode_t rslt = atcmd_awaitResultWithOptions(PERIOD_FROM_SECONDS(45), S__mqttOpenCompleteParser);
-        if (rslt == resultCode__success && atcmd_getValue() == 0)
-        {
-            mqttCtrl->state = mqttState_open;
-            // g_lqLTEM.atcmd->mqttMap |= 0x01 << mqttCtrl->dataCntxt;
-            // g_lqLTEM.atcmd->streamPeers[mqttCtrl->dataCntxt] = mqttCtrl;
-            // LTEM_registerDoWorker(S__mqttDoWork);                                // register background recv worker
-            return resultCode__success;
-        }
-        else
-        {
-            switch (atcmd_getValue())
-            {
-                case -1:
-                case 1:
-                    return resultCode__badRequest;
-                case 2:
-                    return resultCode__conflict;
-                case 4:
-                    return resultCode__notFound;
-                default:
-                    return resultCode__gtwyTimeout;
-            }
-        }
+        if (!atcmd_tryInvoke("AT+QMTOPEN=%d,\"%s\",%d", mqttCtrl->dataCntxt, mqttCtrl->hostUrl, mqttCtrl->hostPort))
+            return resultCode__conflict;
+        openRslt = atcmd_awaitResultWithOptions(PERIOD_FROM_SECONDS(45), S__mqttOpenCompleteParser);
+    } while (atcmd_retryAgain(&retry, openRslt));                               // open result 2/3 (network/PDP not ready) retried per policy
+
+    openRslt = S__mqttOpenResult(openRslt);
+    if (openRslt == resultCode__success)
+    {
+        mqttCtrl->state = mqttState_open;
+        // g_lqLTEM->atcmd->mqttMap |= 0x01 << mqttCtrl->dataCntxt;
+        // g_lqLTEM->atcmd->streamPeers[mqttCtrl->dataCntxt] = mqttCtrl;
+        // LTEM_registerDoWorker(S__mqttDoWork);                                // register background recv worker
     }
+    return openRslt;
 }
 
 
@@ -222,26 +229,7 @@ resultCode_t mqtt_connect(mqttCtrl_t *mqttCtrl, bool cleanSession)
 
     atcmd_tryInvoke("AT+QMTCONN=%d,\"%s\",\"%s\",\"%s\"", mqttCtrl->dataCntxt, mqttCtrl->clientId, mqttCtrl->username, mqttCtrl->password);
     rslt = atcmd_awaitResultWithOptions(PERIOD_FROM_SECONDS(60), S__mqttConnectCompleteParser);     // in autolock mode, so this will release lock
-
-    if (rslt == resultCode__success)                                    // COMMAND executed, outcome of CONNECTION may not be a success
-    {
-        switch (atcmd_getValue())
-        {
-            case 0:
-                return resultCode__success;
-            case 1:
-                return resultCode__methodNotAllowed;                    // invalid protocol version 
-            case 2:               
-            case 4:
-            case 5:
-                return resultCode__unauthorized;                        // bad user ID or password
-            case 3:
-                return resultCode__unavailable;                         // server unavailable
-            default:
-                return resultCode__internalError;
-        }
-    }
-    return resultCode__badRequest;                                      // command rejected by BGx
+    return S__mqttConnectResult(rslt);
 }
 
 
@@ -289,6 +277,33 @@ resultCode_t mqtt_start(mqttCtrl_t *mqttCtrl, bool cleanSession)
 }
 
 
+/**
+ *  @brief Start open, connect and topic subscribe to a remote MQTT server, returning without waiting for the server.
+ */
+bool mqtt_startAsync(mqttCtrl_t *mqttCtrl, bool cleanSession, ltemAsyncComplete_func completeCB)
+{
+    if (ltem_isAsyncPending() || ATCMD_isLockActive())
+        return false;
+
+    if (ltem_getStreamFromCntxt(mqttCtrl->dataCntxt, streamType_MQTT) == NULL)
+        ltem_addStream((streamCtrl_t *)mqttCtrl);                       // register stream for background receive operations (URC)
+
+    ltemAsyncOp_t *asyncOp = LTEM_startAsync(S__mqttStartStep, mqttCtrl, completeCB);
+    asyncOp->flag = cleanSession;
+    if (mqttCtrl->state == mqttState_connected)
+        asyncOp->step = mqttStartStep_subscribe;
+    else if (mqttCtrl->state == mqttState_open)
+        asyncOp->step = mqttStartStep_sessionCfg;
+    else
+        asyncOp->step = mqttStartStep_sslCfg;
+
+    resultCode_t rslt = S__mqttStartInvoke(mqttCtrl, asyncOp);
+    if (rslt != resultCode__unknown)                                    // nothing to do (or unable to), complete now
+        LTEM_completeAsync(rslt);
+    return true;
+}
+
+
 /**
  *  @brief Open and connect to a remote MQTT server.
  */
@@ -386,7 +401,7 @@ resultCode_t mqtt_publish(mqttCtrl_t *mqttCtrl, const char *topic, mqttQos_t qos
 
         atcmd_configDataMode(mqttCtrl->dataCntxt, "> ", atcmd_stdTxDataHndlr, message, messageSz, NULL, false); // send message with dataMode
 
-        if (atcmd_tryInvoke("AT+QMTPUB=%d,%d,%d,0,\"%s\",%d", mqttCtrl->dataCntxt, msgId, qos, topic, messageSz))
+        if (atcmd_tryInvokeCmd(atcmdCmd_qmtpub, mqttCtrl->dataCntxt, msgId, qos, topic, messageSz))
         {
             rslt = atcmd_awaitResultWithOptions(timeoutMS, S__mqttPublishCompleteParser);
             if (rslt == resultCode__success)                                        
@@ -543,6 +558,19 @@ static uint8_t S__findtopicIndx(mqttCtrl_t* mqttCntl, mqttTopicCtrl_t* topicCtrl
 
 
 static resultCode_t S__notifyServerTopicChange(mqttCtrl_t* mqttCtrl, mqttTopicCtrl_t* topicCtrl, bool subscribe)
+{
+    if (S__invokeTopicChange(mqttCtrl, topicCtrl, subscribe))
+    {
+        return atcmd_awaitResult();
+    }
+    return resultCode__conflict;
+}
+
+
+/**
+ *  @brief Invoke topic subscribe/unsubscribe, leaving the result pending.
+ */
+static bool S__invokeTopicChange(mqttCtrl_t* mqttCtrl, mqttTopicCtrl_t* topicCtrl, bool subscribe)
 {
     char topicName[mqtt__topic_nameSz + 1];
     strcpy(topicName, topicCtrl->topicName);
@@ -553,24 +581,165 @@ static resultCode_t S__notifyServerTopicChange(mqttCtrl_t* mqttCtrl, mqttTopicCt
 
     if (subscribe)
     {
-        if (atcmd_tryInvoke("AT+QMTSUB=%d,%d,\"%s\",%d", mqttCtrl->dataCntxt, ++mqttCtrl->sentMsgId, topicName, topicCtrl->Qos))
-        {
-            return atcmd_awaitResultWithOptions(PERIOD_FROM_SECONDS(30), S__mqttSubscribeCompleteParser);
-        }
+        return atcmd_invokeAsync(PERIOD_FROM_SECONDS(30), S__mqttSubscribeCompleteParser, 
+                                 "AT+QMTSUB=%d,%d,\"%s\",%d", mqttCtrl->dataCntxt, ++mqttCtrl->sentMsgId, topicName, topicCtrl->Qos);
     }
-    else
+    return atcmd_invokeAsync(atcmd__noTimeoutChange, NULL, "AT+QMTUNS=%d,%d,\"%s\"", mqttCtrl->dataCntxt, ++mqttCtrl->sentMsgId, topicName);
+}
+
+
+/**
+ *  @brief Map QMTOPEN command result and BGx open result value to a resultCode.
+ */
+static resultCode_t S__mqttOpenResult(resultCode_t rslt)
+{
+    if (rslt == resultCode__success && atcmd_getValue() == 0)
+        return resultCode__success;
+
+    switch (atcmd_getValue())
     {
-        if (atcmd_tryInvoke("AT+QMTUNS=%d,%d,\"%s\"", mqttCtrl->dataCntxt, ++mqttCtrl->sentMsgId, topicName))
+        case -1:
+        case 1:
+            return resultCode__badRequest;
+        case 2:
+            return resultCode__conflict;
+        case 4:
+            return resultCode__notFound;
+        default:
+            return resultCode__gtwyTimeout;
+    }
+}
+
+
+/**
+ *  @brief Map QMTCONN command result and BGx connect result value to a resultCode.
+ */
+static resultCode_t S__mqttConnectResult(resultCode_t rslt)
+{
+    if (rslt == resultCode__success)                                    // COMMAND executed, outcome of CONNECTION may not be a success
+    {
+        switch (atcmd_getValue())
         {
-            return atcmd_awaitResult();
+            case 0:
+                return resultCode__success;
+            case 1:
+                return resultCode__methodNotAllowed;                    // invalid protocol version 
+            case 2:               
+            case 4:
+            case 5:
+                return resultCode__unauthorized;                        // bad user ID or password
+            case 3:
+                return resultCode__unavailable;                         // server unavailable
+            default:
+                return resultCode__internalError;
         }
     }
+    return resultCode__badRequest;                                      // command rejected by BGx
 }
 
 
-static void S__mqttUrcHandler()
+/**
+ *  @brief Invoke the command for the current mqtt_startAsync() step, skipping steps not applicable.
+ *  @return resultCode__unknown if a command is pending, success if no steps remain, otherwise the invoke failure.
+ */
+static resultCode_t S__mqttStartInvoke(mqttCtrl_t *mqttCtrl, ltemAsyncOp_t *asyncOp)
 {
-    cbuffer_t* rxBffr = g_lqLTEM.iop->rxBffr;                                               // for convenience
+    bool invoked = false;
+
+    switch (asyncOp->step)
+    {
+        case mqttStartStep_sslCfg:
+            if (mqttCtrl->useTls)
+            {
+                invoked = atcmd_invokeAsync(atcmd__noTimeoutChange, NULL, "AT+QMTCFG=\"ssl\",%d,1,%d", mqttCtrl->dataCntxt, mqttCtrl->dataCntxt);
+                break;
+            }
+            asyncOp->step = mqttStartStep_versionCfg;
+            // fall through, no TLS config
+
+        case mqttStartStep_versionCfg:
+            invoked = atcmd_invokeAsync(atcmd__noTimeoutChange, NULL, "AT+QMTCFG=\"version\",%d,4", mqttCtrl->dataCntxt);
+            break;
+
+        case mqttStartStep_open:
+            invoked = atcmd_invokeAsync(PERIOD_FROM_SECONDS(45), S__mqttOpenCompleteParser, 
+                                        "AT+QMTOPEN=%d,\"%s\",%d", mqttCtrl->dataCntxt, mqttCtrl->hostUrl, mqttCtrl->hostPort);
+            break;
+
+        case mqttStartStep_sessionCfg:
+            invoked = atcmd_invokeAsync(atcmd__noTimeoutChange, NULL, "AT+QMTCFG=\"session\",%d,%d", mqttCtrl->dataCntxt, (uint8_t)asyncOp->flag);
+            break;
+
+        case mqttStartStep_connect:
+            invoked = atcmd_invokeAsync(PERIOD_FROM_SECONDS(60), S__mqttConnectCompleteParser, 
+                                        "AT+QMTCONN=%d,\"%s\",\"%s\",\"%s\"", mqttCtrl->dataCntxt, mqttCtrl->clientId, mqttCtrl->username, mqttCtrl->password);
+            break;
+
+        case mqttStartStep_subscribe:
+            while (asyncOp->index < mqtt__topicsCnt && mqttCtrl->topics[asyncOp->index] == NULL)
+            {
+                asyncOp->index++;
+            }
+            if (asyncOp->index == mqtt__topicsCnt)                      // all topics subscribed
+            {
+                PRINTF(dbgColor__green, "MQTT Started\r");
+                return resultCode__success;
+            }
+            invoked = S__invokeTopicChange(mqttCtrl, mqttCtrl->topics[asyncOp->index], true);
+            break;
+    }
+    return invoked ? resultCode__unknown : resultCode__conflict;
+}
+
+
+/**
+ *  @brief Async step for mqtt_startAsync(), collects the pending command result and invokes the next step.
+ */
+static resultCode_t S__mqttStartStep(void *ctrl)
+{
+    mqttCtrl_t *mqttCtrl = (mqttCtrl_t *)ctrl;
+    ltemAsyncOp_t *asyncOp = &g_lqLTEM->asyncOp;
+
+    resultCode_t rslt = atcmd_poll();
+    if (rslt == resultCode__unknown)                                    // command pending
+        return resultCode__unknown;
+
+    switch (asyncOp->step)
+    {
+        case mqttStartStep_open:
+            rslt = S__mqttOpenResult(rslt);
+            if (rslt == resultCode__success)
+                mqttCtrl->state = mqttState_open;
+            break;
+
+        case mqttStartStep_connect:
+            rslt = S__mqttConnectResult(rslt);
+            break;
+
+        case mqttStartStep_subscribe:
+            asyncOp->index++;
+            break;
+
+        default:                                                        // config steps
+            if (rslt != resultCode__success)
+                rslt = resultCode__internalError;
+            break;
+    }
+    if (rslt != resultCode__success)
+    {
+        PRINTF(dbgColor__warn, "MQTT start fail step=%d, status=%d\r", asyncOp->step, rslt);
+        return rslt;
+    }
+
+    if (asyncOp->step != mqttStartStep_subscribe)
+        asyncOp->step++;
+    return S__mqttStartInvoke(mqttCtrl, asyncOp);
+}
+
+
+static resultCode_t S__mqttUrcHandler(const urcEvent_t *urcEvent)
+{
+    cbuffer_t* rxBffr = g_lqLTEM->iop->rxBffr;                                               // for convenience
 
     /*
     +QMTRECV: <tcpconnectID>,<msgID>,"<topic>","<payload>"
@@ -578,12 +747,6 @@ static void S__mqttUrcHandler()
     +QMTSTAT: <tcpconnectID>,<err_code>
     */
 
-    if (CBFFR_NOTFOUND(cbffr_find(rxBffr, "+QMT", 0, 0, false)) ||                          // not a MQTT URC
-        cbffr_getOccupied(rxBffr) < 20)                                                     // -or- not sufficient chars to parse URC header
-    {
-        return;                                                     
-    }
-
     char workBffr[512] = {0};
     char* workPtr = workBffr;
     uint8_t dataCntxt;
@@ -591,13 +754,13 @@ static void S__mqttUrcHandler()
     /* MQTT Receive Message
      * -------------------------------------------------------------------------------------
      */
-    if (CBFFR_FOUND(cbffr_find(rxBffr, "+QMTRECV:", 0, 0, true)))                           // if recv, move tail to start of header
+    if (strcmp(urcEvent->prefix, "+QMTRECV:") == 0)                                         // rxBffr tail is at start of header
     {
         // separator: "topic","message"           ,"            search offset from URC prefix
         uint16_t findIndx = cbffr_find(rxBffr, "\",\"", sizeof("+QMTRECV: "), 2, false);        
         if (CBFFR_NOTFOUND(findIndx))
         {
-            return;
+            return resultCode__notFound;
         }
         ASSERT(findIndx < sizeof(workBffr));
         cbffr_pop(rxBffr, workBffr, findIndx + 3);                                          // rxBffr->tail now points to message, operate on header in workBffr
@@ -655,7 +818,7 @@ static void S__mqttUrcHandler()
         uint16_t reqstBlockSz = cbffr_getCapacity(rxBffr) / 4;
         do
         {
-            uint16_t blockSz = cbffr_popBlock(rxBffr, &streamPtr, reqstBlockSz);
+            uint16_t blockSz = IOP_rxPopBlock(&streamPtr, reqstBlockSz);
             eomFound = lq_strnstr(streamPtr, "\"\r\n", blockSz) != NULL;
             blockSz -= (eomFound) ? 3 : 0;                                                  // adjust blockSz to not include in app content
 
@@ -664,29 +827,41 @@ static void S__mqttUrcHandler()
             // signal new receive data available to host application
             ((mqttAppRecv_func)topicCtrl->appRecvDataCB)(dataCntxt, msgId, mqttMsgSegment_msgBody, streamPtr, blockSz, eomFound);
 
-            cbffr_popBlockFinalize(g_lqLTEM.iop->rxBffr, true);                             // commit POP
+            IOP_rxPopBlockFinalize();                                                       // commit POP
         } while (!eomFound);
     }
 
-    /* MQTT Status Change
+    /* Packet Network Lost (system URC forwarded by ltem_eventMgr(), contextID 0 is all)
      * ------------------------------------------------------------------------------------- */
-    else if (CBFFR_FOUND(cbffr_find(rxBffr, "+QMTSTAT", 0, 20, true)))                      // MQTT connection closed
+    else if (strstr(urcEvent->prefix, "\"pdpdeact\"") != NULL)
     {
-        uint16_t eopUrl = cbffr_find(rxBffr, "\r\n", 0, 0, false);
-        if (CBFFR_FOUND(eopUrl))
+        uint8_t pdpCntxt = strtol(urcEvent->line + strlen(urcEvent->prefix) + 1, NULL, 10);
+        if (pdpCntxt == 0 || pdpCntxt == 1)                                                 // MQTT uses BGx default PDP context (pdpcid=1)
         {
-            cbffr_pop(rxBffr, workBffr, eopUrl);
-            workPtr = lq_strnstr(workBffr, "+QMSTAT", sizeof(workBffr)) + 9;
+            for (uint8_t cntxt = 0; cntxt < dataCntxt__cnt; cntxt++)
+            {
+                streamCtrl_t* streamCtrl = ltem_getStreamFromCntxt(cntxt, streamType_MQTT);
+                if (streamCtrl != NULL)
+                    ((mqttCtrl_t*)streamCtrl)->state = mqttState_closed;
+            }
+        }
+    }
+
+    /* MQTT Status Change
+     * ------------------------------------------------------------------------------------- */
+    else                                                                                    // MQTT connection closed
+    {
+        workPtr = (char *)urcEvent->line + sizeof("+QMTSTAT: ") - 1;
 
-            uint8_t cntxt = strtol(workPtr, &workPtr, 10);
-            workPtr++;
+        uint8_t cntxt = strtol(workPtr, &workPtr, 10);
+        workPtr++;
 
-            streamCtrl_t* streamCtrl = ltem_getStreamFromCntxt(cntxt, streamType_MQTT);
-            ASSERT(streamCtrl != NULL);
-            ((mqttCtrl_t*)streamCtrl)->errCode = strtol(workPtr, NULL, 10);
-            ((mqttCtrl_t*)streamCtrl)->state = mqttState_closed;
-        }
+        streamCtrl_t* streamCtrl = ltem_getStreamFromCntxt(cntxt, streamType_MQTT);
+        ASSERT(streamCtrl != NULL);
+        ((mqttCtrl_t*)streamCtrl)->errCode = strtol(workPtr, NULL, 10);
+        ((mqttCtrl_t*)streamCtrl)->state = mqttState_closed;
     }
+    return resultCode__success;
 }
 
 
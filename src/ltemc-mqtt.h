@@ -254,6 +254,19 @@ void mqtt_setConnection(mqttCtrl_t *mqttCtrl, const char *hostUrl, uint16_t host
 resultCode_t mqtt_start(mqttCtrl_t *mqttCtrl, bool cleanSession);
 
 
+/**
+ *  @brief Start open, connect and topic subscriptions to a remote MQTT server, returning without waiting for the server.
+ *  @details The start sequence is advanced by ltem_eventMgr(), completeCB is called with mqttCtrl and a mqtt_start() style result.
+ *           Sequence resumes from current state: open connections skip open, connected skip to topic subscriptions.
+ *
+ *  @param [in] mqttCtrl MQTT stream control to operate with.
+ *  @param [in] cleanSession Clear server session history on connect.
+ *  @param [in] completeCB Application callback on start completion.
+ *  @return True if the start was initiated, false if another command or async operation is underway.
+*/
+bool mqtt_startAsync(mqttCtrl_t *mqttCtrl, bool cleanSession, ltemAsyncComplete_func completeCB);
+
+
 /**
  *  @brief Open a remote MQTT server for use.
  *  @details The recommended approach is to use mqtt_start() and mqtt_reset() for server connections. The 
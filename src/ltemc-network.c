@@ -43,18 +43,28 @@
 #include "ltemc-internal.h"
 #include "ltemc-network.h"
 
-extern ltemDevice_t g_lqLTEM;
-
 
 #define PROTOCOLS_CMD_BUFFER_SZ 80
 #define MIN(x, y) (((x)<(y)) ? (x):(y))
 #define STREMPTY(charvar)  (charvar == NULL || charvar[0] == 0 )
 
 
+/* ntwkDIAG_getProviders() line streaming destination
+ */
+typedef struct providersList_tag
+{
+    char *list;                                 /// caller's buffer
+    uint16_t listSz;                            /// caller's buffer size
+    uint16_t listLen;                           /// chars copied to list
+} providersList_t;
+
+
 // local static functions
 static cmdParseRslt_t S__contextStatusCompleteParser(void * atcmd, const char *response);
 static char *S__grabToken(char *source, int delimiter, char *tokenBuf, uint8_t tokenBufSz);
 static void S__clearProviderInfo();
+static void S__providersLineRecv(void *lineCntxt, const char *line, uint16_t lineSz, bool isPartial);
+static bool S__isRegistered(ntwkRegStatus_t regStatus);
 
 
 /* public tcpip functions
@@ -68,7 +78,7 @@ void ntwk_create()
 {
     providerInfo_t *providerInfoPtr = (providerInfo_t*)calloc(1, sizeof(providerInfo_t));
     ASSERT(providerInfoPtr != NULL);
-    g_lqLTEM.providerInfo = providerInfoPtr;
+    g_lqLTEM->providerInfo = providerInfoPtr;
 }
 
 
@@ -77,10 +87,10 @@ void ntwk_create()
  */
 void ntwk_setDefaulNetworkConfig(uint8_t pdpContextId, const char *protoType, const char *apn)
 {
-    ASSERT(g_lqLTEM.providerInfo != NULL);                                             // ASSERT g_lqLTEM.providerInfo has been initialized
+    ASSERT(g_lqLTEM->providerInfo != NULL);                                             // ASSERT g_lqLTEM->providerInfo has been initialized
     ASSERT_W(strcmp(protoType, PDP_PROTOCOL_IPV4) == 0, "OnlyIPV4SupportedCurrently"); // warn on not IPv4 and IPv4 override
 
-    snprintf(g_lqLTEM.modemSettings->defaultNtwkConfig, sizeof(g_lqLTEM.modemSettings->defaultNtwkConfig), "AT+CGDCONT=%d,\"%s\",\"%s\"\r", pdpContextId, PDP_PROTOCOL_IPV4, apn);
+    snprintf(g_lqLTEM->modemSettings->defaultNtwkConfig, sizeof(g_lqLTEM->modemSettings->defaultNtwkConfig), "AT+CGDCONT=%d,\"%s\",\"%s\"\r", pdpContextId, PDP_PROTOCOL_IPV4, apn);
 }
 
 
@@ -90,9 +100,19 @@ void ntwk_setDefaulNetworkConfig(uint8_t pdpContextId, const char *protoType, co
  */
 void NTWK_initRatOptions()
 {
-    ltem_setProviderScanSeq(g_lqLTEM.modemSettings->scanSequence);
-    ltem_setProviderScanMode(g_lqLTEM.modemSettings->scanMode);
-    ltem_setIotMode(g_lqLTEM.modemSettings->iotMode);
+    /* same settings as ltem_setProviderScanSeq(), ltem_setProviderScanMode() and ltem_setIotMode(), sent as one command line
+     */
+    atcmdBatch_t batch;
+    atcmd_batchInit(&batch, atcmd__noTimeoutChange);
+
+    if (strlen(g_lqLTEM->modemSettings->scanSequence) > 0)
+        atcmd_batchAddSetting(&batch, 1, "AT+QCFG=\"nwscanseq\",%s", g_lqLTEM->modemSettings->scanSequence);
+    atcmd_batchAddSetting(&batch, 1, "AT+QCFG=\"nwscanmode\",%d", g_lqLTEM->modemSettings->scanMode);
+    atcmd_batchAddSetting(&batch, 1, "AT+QCFG=\"iotopmode\",%d", g_lqLTEM->modemSettings->iotMode);
+
+    resultCode_t rslt = atcmd_batchExec(&batch);
+    if (rslt != resultCode__success)
+        PRINTF(dbgColor__cyan, "RAT Options Failed: cmd=%d, rslt=%d\r", batch.failedCmd, rslt);
 }
 
 
@@ -102,8 +122,8 @@ void NTWK_initRatOptions()
 void NTWK_applyDefaulNetwork()
 {
     resultCode_t rslt;
-    if(strlen(g_lqLTEM.modemSettings->defaultNtwkConfig) > 0 &&
-        atcmd_tryInvoke(g_lqLTEM.modemSettings->defaultNtwkConfig))
+    if(strlen(g_lqLTEM->modemSettings->defaultNtwkConfig) > 0 &&
+        atcmd_tryInvoke(g_lqLTEM->modemSettings->defaultNtwkConfig))
     {
         rslt = atcmd_awaitResult();
         if (rslt != resultCode__success)
@@ -115,11 +135,11 @@ void NTWK_applyDefaulNetwork()
 
 void ntwk_setNetworkConfig(uint8_t pdpContextId, const char *protoType, const char *apn)
 {
-    ASSERT(g_lqLTEM.providerInfo != NULL);                                             // ASSERT g_lqLTEM.providerInfo has been initialized
+    ASSERT(g_lqLTEM->providerInfo != NULL);                                             // ASSERT g_lqLTEM->providerInfo has been initialized
     ASSERT_W(strcmp(protoType, PDP_PROTOCOL_IPV4) == 0, "OnlyIPV4SupportedCurrently"); // warn on not IPv4 and IPv4 override
     // protoType = pdpProtocolType_IPV4;
 
-    snprintf(g_lqLTEM.modemSettings->defaultNtwkConfig, sizeof(g_lqLTEM.modemSettings->defaultNtwkConfig), "AT+CGDCONT=%d,%d,\"%s\"\r", pdpContextId, protoType, apn);
+    snprintf(g_lqLTEM->modemSettings->defaultNtwkConfig, sizeof(g_lqLTEM->modemSettings->defaultNtwkConfig), "AT+CGDCONT=%d,%d,\"%s\"\r", pdpContextId, protoType, apn);
 
     resultCode_t rslt;
     if(atcmd_tryInvoke("AT+CGDCONT=%d,%d,\"%s\"\r", pdpContextId, protoType, apn))
@@ -153,7 +173,7 @@ void ntwk_setNetworkConfig(uint8_t pdpContextId, const char *protoType, const ch
 */
 providerInfo_t *ntwk_awaitProvider(uint16_t waitSec)
 {
-    ASSERT(g_lqLTEM.providerInfo != NULL);         // ASSERT g_lqLTEM.providerInfo has been initialized
+    ASSERT(g_lqLTEM->providerInfo != NULL);         // ASSERT g_lqLTEM->providerInfo has been initialized
 
     uint32_t startMillis, endMillis;
     startMillis = endMillis = pMillis();
@@ -171,21 +191,21 @@ providerInfo_t *ntwk_awaitProvider(uint16_t waitSec)
                 pContinue = strchr(atcmd_getResponse(), '"');
                 if (pContinue != NULL)
                 {
-                    pContinue = S__grabToken(pContinue + 1, '"', g_lqLTEM.providerInfo->name, ntwk__providerNameSz);
+                    pContinue = S__grabToken(pContinue + 1, '"', g_lqLTEM->providerInfo->name, ntwk__providerNameSz);
 
                     uint8_t ntwkMode = (uint8_t)strtol(pContinue + 1, &pContinue, 10);
                     if (ntwkMode == 8)
-                        strcpy(g_lqLTEM.providerInfo->iotMode, "M1");
+                        strcpy(g_lqLTEM->providerInfo->iotMode, "M1");
                     else
-                        strcpy(g_lqLTEM.providerInfo->iotMode, "NB1");
+                        strcpy(g_lqLTEM->providerInfo->iotMode, "NB1");
                 }
             }
-            if (!STREMPTY(g_lqLTEM.providerInfo->name))
+            if (!STREMPTY(g_lqLTEM->providerInfo->name))
                 break;
 
             pDelay(1000);                                                                   // this yields, allowing alternate execution
             endMillis = pMillis();
-        } while (endMillis - startMillis < waitDuration || g_lqLTEM.cancellationRequest);   // timed out waiting OR global cancellation
+        } while (endMillis - startMillis < waitDuration || g_lqLTEM->cancellationRequest);   // timed out waiting OR global cancellation
 
 
         // got PROVIDER, get networks 
@@ -193,7 +213,7 @@ providerInfo_t *ntwk_awaitProvider(uint16_t waitSec)
         /* NOTE: BGx will not return response for AT+CGPADDR *OVER THE SERIAL PORT*, unless it is suffixed with the contextID
          * This is one of a handfull of commands that exhibit this behavior; AT+CGPADDR works perfectly over the USB AT port.
         */
-        if (!STREMPTY(g_lqLTEM.providerInfo->name))
+        if (!STREMPTY(g_lqLTEM->providerInfo->name))
         {
             char *pContinue;
             uint8_t ntwkIndx = 0;
@@ -204,10 +224,10 @@ providerInfo_t *ntwk_awaitProvider(uint16_t waitSec)
                 pContinue = strstr(atcmd_getResponse(), "+CGACT: ");
                 while (pContinue != NULL && ntwkIndx < ntwk__pdpContextCnt)
                 {
-                    g_lqLTEM.providerInfo->networks[ntwkIndx].pdpContextId = strtol(pContinue + 8, &pContinue, 10);
-                    g_lqLTEM.providerInfo->networks[ntwkIndx].isActive = *(++pContinue) == '1';
+                    g_lqLTEM->providerInfo->networks[ntwkIndx].pdpContextId = strtol(pContinue + 8, &pContinue, 10);
+                    g_lqLTEM->providerInfo->networks[ntwkIndx].isActive = *(++pContinue) == '1';
                     // only supported protocol now is IPv4, alias IP
-                    strcpy(g_lqLTEM.providerInfo->networks[ntwkIndx].pdpProtocolType, PDP_PROTOCOL_IPV4);
+                    strcpy(g_lqLTEM->providerInfo->networks[ntwkIndx].pdpProtocolType, PDP_PROTOCOL_IPV4);
                     pContinue = strstr(pContinue, "+CGACT: ");
                     if (pContinue == NULL)
                         break;
@@ -217,27 +237,27 @@ providerInfo_t *ntwk_awaitProvider(uint16_t waitSec)
             // get IP addresses
             for (size_t i = 0; i <= ntwkIndx; i++)
             {
-                if (g_lqLTEM.providerInfo->networks[i].isActive)
+                if (g_lqLTEM->providerInfo->networks[i].isActive)
                 {
-                    atcmd_invokeReuseLock("AT+CGPADDR=%d", g_lqLTEM.providerInfo->networks[i].pdpContextId);
+                    atcmd_invokeReuseLock("AT+CGPADDR=%d", g_lqLTEM->providerInfo->networks[i].pdpContextId);
                     if (atcmd_awaitResult() == resultCode__success)
                     {
                         pContinue = strstr(atcmd_getResponse(), "+CGPADDR: ");
                         pContinue = strchr(pContinue + 10, ',') + 1;
                         char *pLineEnd = strchr(pContinue, '\r');
-                        strncpy(g_lqLTEM.providerInfo->networks[i].ipAddress, pContinue, MIN(pLineEnd - pContinue, ntwk__ipAddressSz));
+                        strncpy(g_lqLTEM->providerInfo->networks[i].ipAddress, pContinue, MIN(pLineEnd - pContinue, ntwk__ipAddressSz));
                     }
                 }
                 else
                 {
-                    strcpy(g_lqLTEM.providerInfo->networks[i].ipAddress, "0.0.0.0");
+                    strcpy(g_lqLTEM->providerInfo->networks[i].ipAddress, "0.0.0.0");
                 }
             }
-            g_lqLTEM.providerInfo->networkCnt = ++ntwkIndx;
+            g_lqLTEM->providerInfo->networkCnt = ++ntwkIndx;
         }
     }
     atcmd_close();
-    return g_lqLTEM.providerInfo;
+    return g_lqLTEM->providerInfo;
 }
 
 
@@ -246,12 +266,19 @@ providerInfo_t *ntwk_awaitProvider(uint16_t waitSec)
  */
 void ntwk_activateNetwork(uint8_t cntxtId)
 {
-    if (atcmd_tryInvoke("AT+CGACT=1,%d", cntxtId))
+    resultCode_t rslt;
+    atcmdRetry_t retry;
+    atcmd_retryInit(&retry, atcmdRetryClass_attach);
+
+    do
     {
-        resultCode_t rslt = atcmd_awaitResultWithOptions(atcmd__defaultTimeout, S__contextStatusCompleteParser);
-        if ( rslt == resultCode__success)
-            ntwk_awaitProvider(5);
-    }
+        if (!atcmd_tryInvoke("AT+CGACT=1,%d", cntxtId))
+            return;
+        rslt = atcmd_awaitResultWithOptions(atcmd__defaultTimeout, S__contextStatusCompleteParser);
+    } while (atcmd_retryAgain(&retry, rslt));                                   // CME 3/4 while network attach in progress retried per policy
+
+    if ( rslt == resultCode__success)
+        ntwk_awaitProvider(5);
 }
 
 
@@ -275,8 +302,8 @@ void ntwk_deactivateNetwork(uint8_t cntxtId)
 */
 providerInfo_t *ntwk_getProviderInfo()
 {
-    if (strlen(g_lqLTEM.providerInfo->name) > 0)
-        return &g_lqLTEM.providerInfo;
+    if (strlen(g_lqLTEM->providerInfo->name) > 0)
+        return &g_lqLTEM->providerInfo;
     return NULL;
 }
 
@@ -286,7 +313,7 @@ providerInfo_t *ntwk_getProviderInfo()
  */
 uint8_t ntwk_getActiveNetworkCount()
 {
-    return g_lqLTEM.providerInfo->networkCnt;
+    return g_lqLTEM->providerInfo->networkCnt;
 }
 
 
@@ -295,11 +322,11 @@ uint8_t ntwk_getActiveNetworkCount()
  */
 networkInfo_t *ntwk_getNetworkInfo(uint8_t pdpContextId)
 {
-    for (size_t i = 0; i < g_lqLTEM.providerInfo->networkCnt; i++)
+    for (size_t i = 0; i < g_lqLTEM->providerInfo->networkCnt; i++)
     {
-        if (g_lqLTEM.providerInfo->networks[i].pdpContextId == pdpContextId)
+        if (g_lqLTEM->providerInfo->networks[i].pdpContextId == pdpContextId)
         {
-            return &g_lqLTEM.providerInfo->networks[i];
+            return &g_lqLTEM->providerInfo->networks[i];
         }
     }
     return NULL;
@@ -312,16 +339,23 @@ networkInfo_t *ntwk_getNetworkInfo(uint8_t pdpContextId)
  */
 uint8_t ntwk_getRegistrationStatus()
 {
-    if (atcmd_tryInvoke("AT+CREG?"))
-    {
-        // TODO need a parser wrapper to grab <stat> (pos 2)
-        resultCode_t rslt = atcmd_awaitResult();
-        return 0;
-    }
-    else
+    providerInfo_t *providerInfo = g_lqLTEM->providerInfo;
+
+    if (providerInfo->regStatusAt == 0)                                         // no +CEREG URC since start, query BGx
     {
-        return 255;
+        if (!atcmd_tryInvoke("AT+CEREG?"))
+            return 255;
+        if (atcmd_awaitResult() == resultCode__success)
+        {
+            const char *regReport = strstr(atcmd_getResponse(), "+CEREG: ");
+            if (regReport != NULL)
+                NTWK_regStatusReport(regReport);
+        }
     }
+
+    if (!S__isRegistered(providerInfo->epsRegStatus) && S__isRegistered(providerInfo->gprsRegStatus))
+        return providerInfo->gprsRegStatus;
+    return providerInfo->epsRegStatus;
 }
 
 
@@ -349,13 +383,14 @@ void ntwkDIAG_getProviders(char *providersList, uint16_t listSz)
 
     if (ATCMD_awaitLock(atcmd__defaultTimeout))
     {
-        if (g_lqLTEM.modemInfo->imei[0] == 0)
+        if (g_lqLTEM->modemInfo->imei[0] == 0)
         {
+            providersList_t providers = { providersList, listSz, 0 };
+            providersList[0] = '\0';
+
             atcmd_invokeReuseLock("AT+COPS=?");
-            if (atcmd_awaitResultWithOptions(PERIOD_FROM_SECONDS(180), NULL) == resultCode__success)
-            {
-                strncpy(providersList, atcmd_getResponse() + 9, listSz - 1);
-            }
+            atcmd_setLineStreaming(S__providersLineRecv, &providers);   // +COPS: list is a single line, typically exceeding atcmd response buffer
+            atcmd_awaitResultWithOptions(PERIOD_FROM_SECONDS(180), NULL);
         }
     }
     atcmd_close();
@@ -365,15 +400,114 @@ void ntwkDIAG_getProviders(char *providersList, uint16_t listSz)
 #pragma endregion
 
 
+/* LTEmC internal network functions
+ * --------------------------------------------------------------------------------------------- */
+#pragma region internal functions
+
+
+/**
+ *	\brief Update network registration status from a +CEREG/+CGREG report (URC or query response).
+ */
+void NTWK_regStatusReport(const char *regReport)
+{
+    /* URC: +CEREG: <stat>[,<tac>,<ci>[,<AcT>]]   query response: +CEREG: <n>,<stat>[,...]  (same for +CGREG)
+     */
+    providerInfo_t *providerInfo = g_lqLTEM->providerInfo;
+    bool isEps = regReport[2] == 'E';                                          // +CEREG vs +CGREG
+
+    char *pContinue;
+    uint8_t regStatus = strtol(regReport + sizeof("+CEREG: ") - 1, &pContinue, 10);
+    if (*pContinue == ',' && pContinue[1] >= '0' && pContinue[1] <= '9')                   // query response, <stat> follows <n>
+        regStatus = strtol(pContinue + 1, NULL, 10);
+
+    ntwkRegStatus_t *regStatusPtr = isEps ? &providerInfo->epsRegStatus : &providerInfo->gprsRegStatus;
+    if (*regStatusPtr != regStatus)
+        PRINTF(dbgColor__info, "%sReg=%d\r", isEps ? "EPS" : "GPRS", regStatus);
+
+    *regStatusPtr = (ntwkRegStatus_t)regStatus;
+    providerInfo->regStatusAt = pMillis();
+}
+
+
+/**
+ *	\brief Mark a PDP context inactive following network deactivation (pdpContextId 0 is all contexts).
+ */
+void NTWK_setNetworkInactive(uint8_t pdpContextId)
+{
+    for (size_t i = 0; i < g_lqLTEM->providerInfo->networkCnt; i++)
+    {
+        networkInfo_t *network = &g_lqLTEM->providerInfo->networks[i];
+        if (pdpContextId == 0 || network->pdpContextId == pdpContextId)
+        {
+            network->isActive = false;
+            strcpy(network->ipAddress, "0.0.0.0");
+        }
+    }
+}
+
+
+/**
+ *	\brief Clear provider and network state, SIM is unavailable.
+ */
+void NTWK_clearProviderInfo()
+{
+    S__clearProviderInfo();
+    g_lqLTEM->providerInfo->epsRegStatus = ntwkRegStatus_notRegistered;
+    g_lqLTEM->providerInfo->gprsRegStatus = ntwkRegStatus_notRegistered;
+    g_lqLTEM->providerInfo->regStatusAt = pMillis();
+}
+
+
+#pragma endregion
+
+
 /* private functions
  * --------------------------------------------------------------------------------------------- */
 #pragma region private functions
 
 
+/**
+ *	@brief Line streaming receiver for ntwkDIAG_getProviders(), copies the +COPS: list (less prefix) into caller's buffer.
+ */
+static void S__providersLineRecv(void *lineCntxt, const char *line, uint16_t lineSz, bool isPartial)
+{
+    providersList_t *providers = (providersList_t *)lineCntxt;
+
+    if (providers->listLen == 0)                                            // start of list
+    {
+        if (strncmp(line, "+COPS: ", 7) != 0)
+            return;
+        line += 7;
+        lineSz -= 7;
+    }
+    uint16_t copySz = MIN(lineSz, providers->listSz - 1 - providers->listLen);
+    memcpy(providers->list + providers->listLen, line, copySz);
+    providers->listLen += copySz;
+    providers->list[providers->listLen] = '\0';
+}
+
+
 static void S__clearProviderInfo()
 {
-    memset((void*)g_lqLTEM.providerInfo->networks, 0, g_lqLTEM.providerInfo->networkCnt * sizeof(networkInfo_t));
-    memset((void*)g_lqLTEM.providerInfo, 0, sizeof(providerInfo_t));
+    ntwkRegStatus_t epsRegStatus = g_lqLTEM->providerInfo->epsRegStatus;    // registration is pushed by BGx (URC), not part of provider query
+    ntwkRegStatus_t gprsRegStatus = g_lqLTEM->providerInfo->gprsRegStatus;
+    uint32_t regStatusAt = g_lqLTEM->providerInfo->regStatusAt;
+
+    memset((void*)g_lqLTEM->providerInfo->networks, 0, g_lqLTEM->providerInfo->networkCnt * sizeof(networkInfo_t));
+    memset((void*)g_lqLTEM->providerInfo, 0, sizeof(providerInfo_t));
+
+    g_lqLTEM->providerInfo->epsRegStatus = epsRegStatus;
+    g_lqLTEM->providerInfo->gprsRegStatus = gprsRegStatus;
+    g_lqLTEM->providerInfo->regStatusAt = regStatusAt;
+}
+
+
+/**
+ *	@brief Test registration status for registered to a network (home or roaming).
+ */
+static bool S__isRegistered(ntwkRegStatus_t regStatus)
+{
+    return regStatus == ntwkRegStatus_home || regStatus == ntwkRegStatus_roaming;
 }
 
 
@@ -88,6 +88,15 @@ providerInfo_t *ntwk_awaitProvider(uint16_t waitSec);
 // void ntwk_setProviderDefaultContext(uint8_t defaultContext);
 
 
+/**
+ *	@brief Configure the default PDP context (data context) the modem uses on startup.
+ *  @param [in] pdpContextId The PDP context number to configure.
+ *  @param [in] protoType The PDP protocol type ("IP", "IPV6", "IPV4V6").
+ *  @param [in] apn The provider APN for the context.
+ */
+void ntwk_setDefaulNetworkConfig(uint8_t pdpContextId, const char *protoType, const char *apn);
+
+
 /**
  *	@brief Deactivate PDP Context/APN.
  *  @param [in] contextId The APN number to operate on.
@@ -121,7 +130,8 @@ networkInfo_t *ntwk_getNetworkInfo(uint8_t contxtId);
 
 /**
  *	@brief Get current network registration status.
- *  @return The current network operator registration status.
+ *  @details Status is kept current by +CEREG (and +CGREG if enabled) URCs, BGx is queried only if none reported since start.
+ *  @return The current network operator registration status (ntwkRegStatus_t), LTE status unless only GSM is registered. 255 if BGx busy.
  */
 uint8_t ntwk_getRegistrationStatus();
 
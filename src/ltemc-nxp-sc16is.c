@@ -45,8 +45,6 @@
 #include "lq-platform.h"
 #include "ltemc-nxp-sc16is.h"
 
-extern ltemDevice_t g_lqLTEM;
-
 
 #define REG_MODIFY(REG_NAME, MODIFY_ACTION)                 \
 REG_NAME REG_NAME##_reg = {0};                              \
@@ -66,6 +64,15 @@ SC16IS7xx_writeReg(REG_NAME##_regAddr, REG_NAME##_reg.reg);
 /* Static Local Functions Declarations
 ------------------------------------------------------------------------------------------------ */
 void S_displayFifoStatus(const char *dispMsg);
+static inline void S__awaitXferIdle();
+
+#ifdef LTEMC_SPI_DMA
+static void S__xferCompleteISR();
+
+static volatile bool s_xferActive = false;                  // DMA FIFO transfer in progress, SPI bus is held (transfers serialized across devices)
+static SC16IS7xx_xferComplete_func s_xferCompleteCB = NULL;
+static ltemDevice_t *s_xferDevice = NULL;                   // device owning transfer, bound for completion callback
+#endif
 
 
 #pragma region Bridge Initialization
@@ -89,14 +96,87 @@ void SC16IS7xx_start()
     fcrRegister.TX_TRIGGER_LVL = (int)TX_LVL_56SPACES;
 	SC16IS7xx_writeReg(SC16IS7xx_FCR_regAddr, fcrRegister.reg);
 
-	// set baudrate => starts clock and UART
-	SC16IS7xx_writeReg(SC16IS7xx_LCR_regAddr, SC16IS7xx__LCR_REGSET_special);
-	SC16IS7xx_writeReg(SC16IS7xx_DLL_regAddr, SC16IS7xx__DLL_baudClockDivisorLOW);
-	SC16IS7xx_writeReg(SC16IS7xx_DLH_regAddr, SC16IS7xx__DLH_baudClockDivisorHIGH);
-	SC16IS7xx_writeReg(SC16IS7xx_LCR_regAddr, SC16IS7xx__LCR_REGSET_general);
-
 	// set byte framing on the wire:  8 data, no parity, 1 stop required by BGx
 	SC16IS7xx_writeReg(SC16IS7xx_LCR_regAddr, SC16IS7xx__LCR_UARTframing);
+
+	// set baudrate => starts clock and UART, BGx is at default rate following reset
+    SC16IS7xx_setBaudRate(IOP__uartBaudRate);
+
+    #ifdef LTEMC_HW_FLOWCTRL
+    SC16IS7xx_enableHwFlowCtrl();
+    #endif
+}
+
+
+/**
+ *	@brief Configure automatic RTS/CTS hardware flow control with TCR halt/resume levels.
+ */
+void SC16IS7xx_enableHwFlowCtrl()
+{
+    uint8_t lcrReg = SC16IS7xx_readReg(SC16IS7xx_LCR_regAddr);
+
+    // EFR[4] enhanced functions (required for TCR/TLR), EFR[6] auto-RTS, EFR[7] auto-CTS
+    SC16IS7xx_writeReg(SC16IS7xx_LCR_regAddr, SC16IS7xx__LCR_REGSET_enhanced);
+    REG_MODIFY(SC16IS7xx_EFR, 
+        SC16IS7xx_EFR_reg.ENHANCED_FNS_EN = 1;
+        SC16IS7xx_EFR_reg.AUTO_nRTS = 1;
+        SC16IS7xx_EFR_reg.AUTO_nCTS = 1;
+    )
+    SC16IS7xx_writeReg(SC16IS7xx_LCR_regAddr, lcrReg);
+
+    // MCR[2]=1 maps TCR/TLR over MSR/SPR addresses
+    {
+        REG_MODIFY(SC16IS7xx_MCR, SC16IS7xx_MCR_reg.TCR_TLR_EN = 1;)
+    }
+
+	SC16IS7xx_TCR tcrRegister = {0};
+    tcrRegister.HALT_LVL = SC16IS7xx__TCR_haltLevel;
+    tcrRegister.RESUME_LVL = SC16IS7xx__TCR_resumeLevel;
+	SC16IS7xx_writeReg(SC16IS7xx_TCR_regAddr, tcrRegister.reg);
+
+    // TCR settings remain in effect, restore MSR/SPR access (SPR used by isAvailable())
+    {
+        REG_MODIFY(SC16IS7xx_MCR, SC16IS7xx_MCR_reg.TCR_TLR_EN = 0;)
+    }
+}
+
+
+/**
+ *	@brief Set the bridge UART baud rate (DLL/DLH divisor), preserving the line control (framing) settings.
+ */
+bool SC16IS7xx_setBaudRate(uint32_t baudRate)
+{
+    if (baudRate == 0 || baudRate > SC16IS7xx__baudRateMax || SC16IS7xx__XTAL_frequency % (16 * baudRate) != 0)
+        return false;
+
+    uint16_t divisor = SC16IS7xx__XTAL_frequency / (16 * baudRate);
+    uint8_t lcrReg = SC16IS7xx_readReg(SC16IS7xx_LCR_regAddr);
+
+	SC16IS7xx_writeReg(SC16IS7xx_LCR_regAddr, SC16IS7xx__LCR_REGSET_special);
+	SC16IS7xx_writeReg(SC16IS7xx_DLL_regAddr, divisor & 0xFF);
+	SC16IS7xx_writeReg(SC16IS7xx_DLH_regAddr, divisor >> 8);
+	SC16IS7xx_writeReg(SC16IS7xx_LCR_regAddr, lcrReg);
+    return true;
+}
+
+
+/**
+ *	@brief Set RX/TX FIFO interrupt trigger levels through TLR, overriding the FCR trigger levels.
+ */
+void SC16IS7xx_setTriggerLevels(uint8_t rxLevel, uint8_t txLevel)
+{
+	SC16IS7xx_TLR tlrRegister = {0};
+    tlrRegister.RX_TRIGGER_LVL = rxLevel / SC16IS7xx__TLR_granularity;
+    tlrRegister.TX_TRIGGER_LVL = txLevel / SC16IS7xx__TLR_granularity;
+
+    // EFR[4]=1 set in start(), MCR[2]=1 maps TLR over SPR address
+    {
+        REG_MODIFY(SC16IS7xx_MCR, SC16IS7xx_MCR_reg.TCR_TLR_EN = 1;)
+    }
+	SC16IS7xx_writeReg(SC16IS7xx_TLR_regAddr, tlrRegister.reg);
+    {
+        REG_MODIFY(SC16IS7xx_MCR, SC16IS7xx_MCR_reg.TCR_TLR_EN = 0;)
+    }
 }
 
 
@@ -126,12 +206,31 @@ void SC16IS7xx_enableIrqMode()
     // SC16IS7xx_writeReg(SC16IS7xx_TLR_regAddr, 0xDF);                // RX=0xD (52 chars), TX=0xF (60 spaces)
     // // EFR[4]=1 (enhanced functions) and MCR[2]=1 (TCR/TLR enable) remain set
 
-   	// IRQ to enable: RX chars available, TX spaces available, UART framing error : reg = 0x07
-	SC16IS7xx_IER ierSetting = {0};
-	ierSetting.RHR_DATA_AVAIL_INT_EN = 1;
-	ierSetting.THR_EMPTY_INT_EN = 1; 
-    ierSetting.RECEIVE_LINE_STAT_INT_EN = 1;
-	SC16IS7xx_writeReg(SC16IS7xx_IER_regAddr, ierSetting.reg);
+   	// IRQ to enable: RX chars available, UART framing error : reg = 0x05, TX spaces available enabled when TX is queued
+	g_lqLTEM->bridgeIer.reg = 0;
+	g_lqLTEM->bridgeIer.RHR_DATA_AVAIL_INT_EN = 1;
+    g_lqLTEM->bridgeIer.RECEIVE_LINE_STAT_INT_EN = 1;
+	SC16IS7xx_writeReg(SC16IS7xx_IER_regAddr, g_lqLTEM->bridgeIer.reg);
+}
+
+
+/**
+ *	@brief Enable or disable the TX (THR) interrupt source.
+ */
+void SC16IS7xx_setTxIrq(bool enabled)
+{
+	g_lqLTEM->bridgeIer.THR_EMPTY_INT_EN = enabled; 
+	SC16IS7xx_writeReg(SC16IS7xx_IER_regAddr, g_lqLTEM->bridgeIer.reg);
+}
+
+
+/**
+ *	@brief Enable or disable the RX (RHR/time-out) interrupt source.
+ */
+void SC16IS7xx_setRxIrq(bool enabled)
+{
+	g_lqLTEM->bridgeIer.RHR_DATA_AVAIL_INT_EN = enabled;
+	SC16IS7xx_writeReg(SC16IS7xx_IER_regAddr, g_lqLTEM->bridgeIer.reg);
 }
 
 
@@ -161,7 +260,8 @@ uint8_t SC16IS7xx_readReg(uint8_t reg_addr)
 	reg_payload.reg_addr.A = reg_addr;
 	reg_payload.reg_addr.RnW = SC16IS7xx__FIFO_readRnW;
 
-	reg_payload.reg_payload = spi_transferWord(g_lqLTEM.spi, reg_payload.reg_payload);
+    S__awaitXferIdle();
+	reg_payload.reg_payload = spi_transferWord(g_lqLTEM->spi, reg_payload.reg_payload);
 	return reg_payload.reg_data;
 }
 
@@ -176,7 +276,39 @@ void SC16IS7xx_writeReg(uint8_t reg_addr, uint8_t reg_data)
 	reg_payload.reg_addr.RnW = SC16IS7xx__FIFO_writeRnW;
 	reg_payload.reg_data = reg_data;
 
-	spi_transferWord(g_lqLTEM.spi, reg_payload.reg_payload);
+    S__awaitXferIdle();
+	spi_transferWord(g_lqLTEM->spi, reg_payload.reg_payload);
+}
+
+
+/**
+ *	@brief Read the bridge registers needed to service the pending interrupt.
+ */
+bool SC16IS7xx_readIsrState(SC16IS7xx_isrState_t *isrState)
+{
+    isrState->iir.reg = SC16IS7xx_readReg(SC16IS7xx_IIR_regAddr);
+    isrState->lsr.reg = 0;
+    isrState->rxLevel = 0;
+    isrState->txLevel = 0;
+
+    if (isrState->iir.IRQ_nPENDING == 1)
+        return false;
+
+    switch (isrState->iir.IRQ_SOURCE)
+    {
+        case 3:                                                                     // receiver line status error
+            isrState->lsr.reg = SC16IS7xx_readReg(SC16IS7xx_LSR_regAddr);
+            isrState->rxLevel = SC16IS7xx_readReg(SC16IS7xx_RXLVL_regAddr);
+            break;
+        case 2:                                                                     // RHR trigger level
+        case 6:                                                                     // RX time-out
+            isrState->rxLevel = SC16IS7xx_readReg(SC16IS7xx_RXLVL_regAddr);
+            break;
+        case 1:                                                                     // THR trigger level
+            isrState->txLevel = SC16IS7xx_readReg(SC16IS7xx_TXLVL_regAddr);
+            break;
+    }
+    return true;
 }
 
 
@@ -189,7 +321,8 @@ void SC16IS7xx_read(void* dest, uint8_t dest_len)
     reg_addr.A = SC16IS7xx_FIFO_regAddr;
     reg_addr.RnW = SC16IS7xx__FIFO_readRnW;
 
-    spi_transferBuffer(g_lqLTEM.spi, reg_addr.reg_address, dest, dest_len);
+    S__awaitXferIdle();
+    spi_transferBuffer(g_lqLTEM->spi, reg_addr.reg_address, dest, dest_len);
 }
 
 
@@ -202,10 +335,41 @@ void SC16IS7xx_write(const void* src, uint8_t src_len)
     reg_addr.A = SC16IS7xx_FIFO_regAddr;
     reg_addr.RnW = SC16IS7xx__FIFO_writeRnW;
 
-    spi_transferBuffer(g_lqLTEM.spi, reg_addr.reg_address, src, src_len);
+    S__awaitXferIdle();
+    spi_transferBuffer(g_lqLTEM->spi, reg_addr.reg_address, src, src_len);
 }
 
 
+#ifdef LTEMC_SPI_DMA
+
+/**
+ *	@brief Starts a DMA read through the SC16IS741A bridge (its RX FIFO).
+ */
+void SC16IS7xx_readAsync(void* dest, uint8_t dest_len, SC16IS7xx_xferComplete_func completeCB)
+{
+    union __SC16IS7xx_reg_addr_byte__ reg_addr = { 0 };
+    reg_addr.A = SC16IS7xx_FIFO_regAddr;
+    reg_addr.RnW = SC16IS7xx__FIFO_readRnW;
+
+    S__awaitXferIdle();
+    s_xferCompleteCB = completeCB;
+    s_xferDevice = g_lqLTEM;
+    s_xferActive = true;
+    spi_transferBufferAsync(g_lqLTEM->spi, reg_addr.reg_address, dest, dest_len, S__xferCompleteISR);
+}
+
+
+/**
+ *	@brief Test for a DMA FIFO transfer in progress.
+ */
+bool SC16IS7xx_isXferActive()
+{
+    return s_xferActive;
+}
+
+#endif
+
+
 /**
  *	@brief Perform reset on bridge FIFO
  */
@@ -250,6 +414,41 @@ void SC16IS7xx_flushRxFifo()
 /* ----------------------------------------------------------------------------------------------------------------- */
 
 
+#pragma region Static Local Functions
+
+/**
+ *	@brief Block register/FIFO access until any DMA FIFO transfer completes (no-op without LTEMC_SPI_DMA).
+ *  @note Waits only in the foreground, the IOP ISR defers its service while a transfer is active (SC16IS7xx_isXferActive).
+ */
+static inline void S__awaitXferIdle()
+{
+    #ifdef LTEMC_SPI_DMA
+    while (s_xferActive) {}                                 // DMA complete interrupt clears
+    #endif
+}
+
+
+#ifdef LTEMC_SPI_DMA
+/**
+ *	@brief Platform DMA complete handler, releases bridge access and signals transfer requestor.
+ */
+static void S__xferCompleteISR()
+{
+    s_xferActive = false;
+    if (s_xferCompleteCB != NULL)
+    {
+        ltemDevice_t *isrBound = g_lqLTEMIsrBinding.device;
+        g_lqLTEMIsrBinding.device = s_xferDevice;
+        s_xferCompleteCB();
+        g_lqLTEMIsrBinding.device = isrBound;
+    }
+}
+#endif
+
+#pragma endregion
+/* ----------------------------------------------------------------------------------------------------------------- */
+
+
 /**
  *	@brief DEBUG: Show FIFO buffers fill level
  */
@@ -59,8 +59,9 @@ typedef uint8_t rw8;
 enum SC16IS7xx__constants
 {
     // BGx default baudrate is 115200, LTEm-OSC raw clock is 7.378MHz (SC16IS740 section 7.8)
-    SC16IS7xx__DLL_baudClockDivisorLOW = 0x04U,
-    SC16IS7xx__DLH_baudClockDivisorHIGH = 0x00U,
+    // divisor = XTAL / (16 * baudrate): 115200=4, 230400=2, 460800=1 (max)
+    SC16IS7xx__XTAL_frequency = 7372800,
+    SC16IS7xx__baudRateMax = SC16IS7xx__XTAL_frequency / 16,
 
     // Bridge<>BG96 UART framing - 8 data, no parity, 1 stop (bits)
     SC16IS7xx__LCR_UARTframing = 0x03U,
@@ -92,7 +93,13 @@ enum SC16IS7xx__constants
     SC16IS7xx__LSR_RHR_dataReady = 0x01U,
     SC16IS7xx__LSR_THR_empty = 0x02U,
     SC16IS7xx__LSR_FIFO_dataError = 0x80U,
-    SC16IS7xx__LSR_FIFO_overrun = 0x02U
+    SC16IS7xx__LSR_FIFO_overrun = 0x02U,
+
+    // TCR Register [7:4] resume, [3:0] halt auto-RTS levels (MCR[2]=1 and EFR[4]=1 required for access), field = level / 4
+    SC16IS7xx__TCR_haltLevel = 0x0FU,                           // 60 chars in RX FIFO, deassert RTS
+    SC16IS7xx__TCR_resumeLevel = 0x0CU,                         // 48 chars in RX FIFO, reassert RTS (RX trigger levels must be below halt)
+
+    SC16IS7xx__TLR_granularity = 4                              // TLR trigger levels are set in 4 char/space steps, 0 = use FCR levels
 };
 
 
@@ -376,7 +383,16 @@ DEF_SC16IS7xx_REG(EFCR,
 
 
 /**
- *  @brief Modem status register.
+ *  @brief Transmission control register (auto-RTS halt/resume levels).
+ */
+DEF_SC16IS7xx_REG(TCR,
+    rw8 HALT_LVL : 4;
+    rw8 RESUME_LVL : 4;
+)
+
+
+/**
+ *  @brief Trigger level register.
  */
 DEF_SC16IS7xx_REG(TLR,
     rw8 TX_TRIGGER_LVL : 4;
@@ -395,6 +411,25 @@ DEF_SC16IS7xx_REG(EFR,
     rw8 AUTO_nCTS : 1;
 )
 
+
+/**
+ *  @brief Snapshot of the bridge registers required to service one pass of the IRQ.
+ *  @details Only the registers relevant to the pending interrupt source are read, registers not read are left 0.
+ */
+typedef struct SC16IS7xx_isrState_tag
+{
+    SC16IS7xx_IIR iir;                          /// interrupt identification (always read)
+    SC16IS7xx_LSR lsr;                          /// line status, read only for receiver line status errors (source 3)
+    uint8_t rxLevel;                            /// chars waiting in RX FIFO, read for RX sources (2, 6) and line status errors
+    uint8_t txLevel;                            /// spaces available in TX FIFO, read only for THR source (1)
+} SC16IS7xx_isrState_t;
+
+
+/**
+ *  @brief Callback signalling completion of an asynchronous (DMA) FIFO transfer (LTEMC_SPI_DMA).
+ */
+typedef void (*SC16IS7xx_xferComplete_func)();
+
 #pragma endregion
 /* ----------------------------------------------------------------------------------------------------------------- */
 
@@ -411,12 +446,53 @@ extern "C"
 void SC16IS7xx_start();
 
 
+/**
+ *	@brief Set the bridge UART baud rate (DLL/DLH divisor), preserving the line control (framing) settings
+ *	\param baudRate [in] - Baud rate, must divide evenly into the bridge clock: 460800, 230400, 115200, 57600, etc.
+ *  \return True if baud rate was applied, false if rate is not supported by the bridge clock
+ */
+bool SC16IS7xx_setBaudRate(uint32_t baudRate);
+
+
 /**
  *	@brief Enable IRQ servicing for communications between SC16IS741 and BG96
  */
 void SC16IS7xx_enableIrqMode();
 
 
+/**
+ *	@brief Enable or disable the TX (THR) interrupt source. Enabled while IOP has TX data queued.
+ *  @details Enabling THR IRQ with TX FIFO spaces above trigger level raises the interrupt, this starts ISR TX servicing.
+ *           Read-modify-write of the bridgeIer shadow, foreground callers hold off the ISR around the call.
+ *	\param enabled [in] - True to enable TX interrupts
+ */
+void SC16IS7xx_setTxIrq(bool enabled);
+
+
+/**
+ *	@brief Enable or disable the RX (RHR/time-out) interrupt source, TX and line status IRQ settings are unchanged.
+ *  @details With auto-RTS enabled, disabling RX IRQ allows the RX FIFO to fill to the TCR halt level pausing the BGx.
+ *           Read-modify-write of the bridgeIer shadow, foreground callers hold off the ISR around the call.
+ *	\param enabled [in] - True to enable RX interrupts
+ */
+void SC16IS7xx_setRxIrq(bool enabled);
+
+
+/**
+ *	@brief Configure automatic RTS/CTS hardware flow control with TCR halt/resume levels.
+ */
+void SC16IS7xx_enableHwFlowCtrl();
+
+
+/**
+ *	@brief Set RX/TX FIFO interrupt trigger levels through TLR, overriding the FCR trigger levels.
+ *  @details Levels are rounded down to the TLR granularity of 4 (4 to 60).
+ *	\param rxLevel [in] - Number of chars in RX FIFO to raise RHR interrupt
+ *	\param txLevel [in] - Number of spaces in TX FIFO to raise THR interrupt
+ */
+void SC16IS7xx_setTriggerLevels(uint8_t rxLevel, uint8_t txLevel);
+
+
 /**
  *	@brief Perform simple write/read using SC16IS741A scratchpad register. Used to test SPI communications.
  */
@@ -439,6 +515,16 @@ uint8_t SC16IS7xx_readReg(uint8_t reg_addr);
 void SC16IS7xx_writeReg(uint8_t reg_addr, uint8_t reg_data);
 
 
+/**
+ *	@brief Read the bridge registers needed to service the pending interrupt with the minimum number of SPI transactions.
+ *  @details The SC16IS7xx SPI interface does not auto-increment register addresses, so each register is a separate
+ *           transfer. IIR is always read; RXLVL, TXLVL and LSR are read only when the interrupt source requires them.
+ *	\param isrState [out] - Snapshot of the registers read
+ *  \return True if an interrupt is pending (IIR[0] == 0)
+ */
+bool SC16IS7xx_readIsrState(SC16IS7xx_isrState_t *isrState);
+
+
 /**
  *	@brief Reads through the SC16IS741A bridge (its RX FIFO)
  *	\param dest [out] - The destination buffer
@@ -455,6 +541,33 @@ void SC16IS7xx_read(void* dest, uint8_t dest_len);
 void SC16IS7xx_write(const void * src, uint8_t src_len);
 
 
+#ifdef LTEMC_SPI_DMA
+/**
+ *	@brief Platform DMA SPI transfer, provided by the host platform port when LTEMC_SPI_DMA is defined.
+ *  @details Performs the same transfer as spi_transferBuffer() but returns once the transfer is started. The platform must
+ *           keep the SPI bus (and chip-select) held for the transfer and invoke completeCB from its DMA complete interrupt.
+ */
+void spi_transferBufferAsync(void *spi, uint8_t addressByte, void *buffer, uint16_t xferLen, SC16IS7xx_xferComplete_func completeCB);
+
+
+/**
+ *	@brief Starts a DMA read through the SC16IS741A bridge (its RX FIFO), returns without waiting for transfer completion.
+ *  @details Register and FIFO accesses made while the transfer is active wait for its completion.
+ *	\param dest [out] - The destination buffer, must remain valid until completeCB is invoked
+ *	\param dest_len [in] - The number of chars to read
+ *	\param completeCB [in] - Function invoked (interrupt context) when transfer completes
+ */
+void SC16IS7xx_readAsync(void* dest, uint8_t dest_len, SC16IS7xx_xferComplete_func completeCB);
+
+
+/**
+ *	@brief Test for a DMA FIFO transfer in progress.
+ *  \return True if a SC16IS7xx_readAsync() transfer has not yet completed
+ */
+bool SC16IS7xx_isXferActive();
+#endif
+
+
 /**
  *	@brief Perform reset on bridge FIFO
  *  \param resetAction [in] - What to reset TX, RX or both
@@ -42,6 +42,18 @@ Also add information on how to contact you by electronic and paper mail.
 
 //#define STATUS_LOW_PULLDOWN
 
+/* Define LTEMC_SPI_DMA if the host platform provides spi_transferBufferAsync() (DMA backed SPI). The IOP ISR will then
+ * start bridge RX FIFO drains and return, completing the RX buffer bookkeeping in the transfer complete callback.
+ * Without the define, FIFO transfers are performed blocking within the ISR.
+ */
+//#define LTEMC_SPI_DMA
+
+/* Define LTEMC_HW_FLOWCTRL if the host LTEm board connects the bridge RTS/CTS lines to the BGx. The bridge is configured
+ * for automatic RTS/CTS and the BGx for hardware flow control (AT+IFC=2,2). When the IOP RX buffer nears full the ISR stops
+ * draining the bridge FIFO, the FIFO fills to the halt level and RTS pauses the BGx until the buffer consumers catch up.
+ */
+//#define LTEMC_HW_FLOWCTRL
+
 #ifdef HOST_FEATHER_UXPLOR_L
 const ltemPinConfig_t ltem_pinConfig =
 {
@@ -44,9 +44,7 @@
 #define SRCFILE "BGX"                           // create SRCFILE (3 char) MACRO for lq-diagnostics ASSERT
 #include "ltemc-internal.h"
 #include "ltemc-quectel-bg.h"
-#include "platform\lqPlatform-gpio.h"
-
-extern ltemDevice_t g_lqLTEM;
+#include "platform/lqPlatform-gpio.h"
 
 extern const char* const qbg_initCmds[];
 extern int8_t qbg_initCmdsCnt;
@@ -68,25 +66,25 @@ bool S__statusFix();
  */
 bool QBG_isPowerOn()
 {
-    gpioPinValue_t statusPin = platform_readPin(g_lqLTEM.pinConfig.statusPin);
+    gpioPinValue_t statusPin = platform_readPin(g_lqLTEM->pinConfig.statusPin);
 
     #ifdef STATUS_LOW_PULLDOWN
     if (statusPin)                     // if pin high, assume latched
     {
-        platform_closePin(g_lqLTEM.pinConfig.statusPin);
-        platform_openPin(g_lqLTEM.pinConfig.statusPin, gpioMode_output);    // open status for write, set low
-        platform_writePin(g_lqLTEM.pinConfig.statusPin, gpioValue_low);     // set low
+        platform_closePin(g_lqLTEM->pinConfig.statusPin);
+        platform_openPin(g_lqLTEM->pinConfig.statusPin, gpioMode_output);    // open status for write, set low
+        platform_writePin(g_lqLTEM->pinConfig.statusPin, gpioValue_low);     // set low
         //pDelay(1);
-        platform_closePin(g_lqLTEM.pinConfig.statusPin);
-        platform_openPin(g_lqLTEM.pinConfig.statusPin, gpioMode_input);     // reopen for normal usage (read)
+        platform_closePin(g_lqLTEM->pinConfig.statusPin);
+        platform_openPin(g_lqLTEM->pinConfig.statusPin, gpioMode_input);     // reopen for normal usage (read)
 
-        statusPin = platform_readPin(g_lqLTEM.pinConfig.statusPin);                     // perform 2nd read, after pull-down sequence
+        statusPin = platform_readPin(g_lqLTEM->pinConfig.statusPin);                     // perform 2nd read, after pull-down sequence
     }
     #else
-    statusPin = platform_readPin(g_lqLTEM.pinConfig.statusPin);
+    statusPin = platform_readPin(g_lqLTEM->pinConfig.statusPin);
     #endif
 
-    g_lqLTEM.deviceState = statusPin ? MAX(deviceState_powerOn, g_lqLTEM.deviceState) : deviceState_powerOff;
+    g_lqLTEM->deviceState = statusPin ? MAX(deviceState_powerOn, g_lqLTEM->deviceState) : deviceState_powerOff;
     return statusPin;
 }
 
@@ -99,15 +97,15 @@ void QBG_powerOn()
     if (QBG_isPowerOn())
     {
         PRINTF(dbgColor__none, "LTEm found powered on\r");
-        g_lqLTEM.deviceState = deviceState_appReady;                    // APP READY msg comes only once, shortly after chip start, would have missed it 
+        g_lqLTEM->deviceState = deviceState_appReady;                    // APP READY msg comes only once, shortly after chip start, would have missed it 
         return;
     }
-    g_lqLTEM.deviceState = deviceState_powerOff;
+    g_lqLTEM->deviceState = deviceState_powerOff;
 
     PRINTF(dbgColor__none, "Powering LTEm On...");
-    platform_writePin(g_lqLTEM.pinConfig.powerkeyPin, gpioValue_high);  // toggle powerKey pin to power on/off
+    platform_writePin(g_lqLTEM->pinConfig.powerkeyPin, gpioValue_high);  // toggle powerKey pin to power on/off
     pDelay(BGX__powerOnDelay);
-    platform_writePin(g_lqLTEM.pinConfig.powerkeyPin, gpioValue_low);
+    platform_writePin(g_lqLTEM->pinConfig.powerkeyPin, gpioValue_low);
 
     uint8_t waitAttempts = 0;
     while (!QBG_isPowerOn())
@@ -119,7 +117,7 @@ void QBG_powerOn()
         }
         pDelay(100);                                                    // allow background tasks to operate
     }
-    g_lqLTEM.deviceState = deviceState_powerOn;
+    g_lqLTEM->deviceState = deviceState_powerOn;
     PRINTF(dbgColor__none, "DONE\r");
 }
 
@@ -132,14 +130,14 @@ void QBG_powerOff()
     if (!QBG_isPowerOn())
     {
         PRINTF(dbgColor__none, "LTEm found powered off\r");
-        g_lqLTEM.deviceState = deviceState_powerOff;
+        g_lqLTEM->deviceState = deviceState_powerOff;
         return;
     }
 
     PRINTF(dbgColor__none, "Powering LTEm Off...");
-	platform_writePin(g_lqLTEM.pinConfig.powerkeyPin, gpioValue_high);  // toggle powerKey pin to power on/off
+	platform_writePin(g_lqLTEM->pinConfig.powerkeyPin, gpioValue_high);  // toggle powerKey pin to power on/off
 	pDelay(BGX__powerOffDelay);
-	platform_writePin(g_lqLTEM.pinConfig.powerkeyPin, gpioValue_low);
+	platform_writePin(g_lqLTEM->pinConfig.powerkeyPin, gpioValue_low);
 
     uint8_t waitAttempts = 0;
     while (QBG_isPowerOn())
@@ -151,7 +149,7 @@ void QBG_powerOff()
         }
         pDelay(100);                                                    // allow background tasks to operate
     }
-    g_lqLTEM.deviceState = deviceState_powerOff;
+    g_lqLTEM->deviceState = deviceState_powerOff;
     PRINTF(dbgColor__none, "DONE\r");
 }
 
@@ -171,12 +169,12 @@ void QBG_reset(resetAction_t resetAction)
         // atcmd_sendCmdData("AT\r", 3, "");                                // clear cmd state
 
         char cmdData[] = "AT+CFUN=1,1\r";                                   // DMA SPI DMA may not tolerate Flash source
-        IOP_startTx(cmdData, sizeof(cmdData));                              // soft-reset command: performs a module internal HW reset and cold-start
+        IOP_forceTx(cmdData, strlen(cmdData));                              // soft-reset command: performs a module internal HW reset and cold-start (IRQ may not be attached)
 
         uint32_t waitStart = pMillis();                                     // start timer to wait for status pin == OFF
         while (QBG_isPowerOn())
         {
-            yield();                                                        // give application some time back for processing
+            pYield();                                                       // give application some time back for processing
             if (pMillis() - waitStart > PERIOD_FROM_SECONDS(3))
             {
                 PRINTF(dbgColor__warn, "LTEm swReset:OFF timeout\r");
@@ -190,7 +188,7 @@ void QBG_reset(resetAction_t resetAction)
         waitStart = pMillis();                                              // start timer to wait for status pin == ON
         while (!QBG_isPowerOn())
         {
-            yield();                                                        // give application some time back for processing
+            pYield();                                                       // give application some time back for processing
             if (pMillis() - waitStart > PERIOD_FROM_SECONDS(3))
             {
                 PRINTF(dbgColor__warn, "LTEm swReset:ON timeout\r");
@@ -201,9 +199,9 @@ void QBG_reset(resetAction_t resetAction)
     }
     else if (resetAction == resetAction_hwReset)
     {
-        platform_writePin(g_lqLTEM.pinConfig.resetPin, gpioValue_high);     // hardware reset: reset pin (LTEm inverts)
+        platform_writePin(g_lqLTEM->pinConfig.resetPin, gpioValue_high);     // hardware reset: reset pin (LTEm inverts)
         pDelay(4000);                                                       // BG96: active for 150-460ms , BG95: 2-3.8s
-        platform_writePin(g_lqLTEM.pinConfig.resetPin, gpioValue_low);
+        platform_writePin(g_lqLTEM->pinConfig.resetPin, gpioValue_low);
         PRINTF(dbgColor__white, "LTEm hwReset\r");
     }
     else // if (resetAction == powerReset)
@@ -224,28 +222,25 @@ void QBG_setOptions()
     PRINTF(dbgColor__none, "BGx Init:\r");
     bool initError = false;
     uint8_t tries = 0;
-    char cmdBffr[120];
 
     do
     {
         tries++;
 
-        for (size_t i = 0; i < qbg_initCmdsCnt; i++)                                    // sequence through list of start cmds
+        atcmdBatch_t batch;
+        atcmd_batchInit(&batch, 2000);                                                  // somewhat unknown cmd list for modem initialization, relax timeout
+
+        for (size_t i = 0; i < qbg_initCmdsCnt; i++)                                    // batch list of start cmds, AT+ settings sent joined
         {
             PRINTF(dbgColor__none, " > %s\r", qbg_initCmds[i]);
-            strcpy(cmdBffr, qbg_initCmds[i]);
-
-            if (atcmd_tryInvoke(cmdBffr))
-            {
-                if (atcmd_awaitResultWithOptions(2000, NULL) == resultCode__success)    // somewhat unknown cmd list for modem initialization, relax timeout
-                {
-                    continue;
-                }
-            }
+            atcmd_batchAdd(&batch, "%s", qbg_initCmds[i]);
+        }
 
-            PRINTF(dbgColor__error, "BGx Init CmdError: %s\r", qbg_initCmds[i]);
+        resultCode_t initRslt = atcmd_batchExec(&batch);
+        if (initRslt != resultCode__success)
+        {
+            PRINTF(dbgColor__error, "BGx Init CmdError: cmd=%d, rslt=%d\r", batch.failedCmd, initRslt);
             initError = true;
-            break;
         }
         PRINTF(dbgColor__none, " -End BGx Init-\r");
         if (initError)
@@ -289,7 +284,7 @@ bool QBG_clearDataState()
  */
 const char *QBG_getModuleType()
 {
-    return g_lqLTEM.moduleType;
+    return g_lqLTEM->moduleType;
 }
 
 
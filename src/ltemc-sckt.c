@@ -43,21 +43,22 @@
 #include "ltemc-internal.h"
 #include "ltemc-sckt.h"
 
-extern ltemDevice_t g_lqLTEM;
-
 
 #define MIN(x, y) (((x) < (y)) ? (x) : (y))
 #define MAX(x, y) (((x) < (y)) ? (y) : (x))
 
 #define DETECT_STALL(tick, threshold)  if (pMillis() - tick > threshold) return resultCode__timeout
-#define ASSERT_NOTSTALLED(tick, threshold)  ASSERT(pMillis() - tick > threshold)
+#define ASSERT_NOTSTALLED(tick, threshold)  ASSERT(pMillis() - tick <= threshold)
 
 
 
 // file scope local function declarations
 static resultCode_t S__scktTxDataHndlr();
-static void S__scktUrcHndlr();
+static resultCode_t S__scktUrcHndlr(const urcEvent_t *urcEvent);
 static resultCode_t S__scktRxHndlr();
+static bool S__scktOpenInvoke(scktCtrl_t *scktCtrl);
+static resultCode_t S__scktOpenStep(void *ctrl);
+static resultCode_t S__scktOpenResult(resultCode_t rslt);
 
 static cmdParseRslt_t S__irdResponseHeaderParser();
 static cmdParseRslt_t S__sslrecvResponseHeaderParser();
@@ -89,8 +90,12 @@ void sckt_initControl(scktCtrl_t *scktCtrl, dataCntxt_t dataCntxt, streamType_t
     scktCtrl->statsRxCnt = 0;
     scktCtrl->statsTxCnt = 0;
     scktCtrl->appRecvDataCB = recvCallback;
+    scktCtrl->urcEvntHndlr = S__scktUrcHndlr;
 
-    g_lqLTEM.streams[dataCntxt] = (streamCtrl_t*)scktCtrl;
+    ltem_registerUrc("+QIURC: \"recv\"", S__scktUrcHndlr);                    // socket URCs dispatched by ltem_eventMgr()
+    ltem_registerUrc("+QIURC: \"closed\"", S__scktUrcHndlr);
+    ltem_registerUrc("+QSSLURC: \"recv\"", S__scktUrcHndlr);
+    ltem_registerUrc("+QSSLURC: \"closed\"", S__scktUrcHndlr);                   // stream is added to streams table on open, removed on close
 }
 
 
@@ -111,35 +116,41 @@ void sckt_setConnection(scktCtrl_t *scktCtrl, uint8_t pdpCntxt, const char *host
  */
 resultCode_t sckt_open(scktCtrl_t *scktCtrl, bool cleanSession)
 {
-    uint8_t pdpCntxt = (scktCtrl->pdpCntxt == 0) ? g_lqLTEM.providerInfo->defaultContext : scktCtrl->pdpCntxt;
     resultCode_t rslt;
+    atcmdRetry_t retry;
+    atcmd_retryInit(&retry, atcmdRetryClass_scktOpen);
 
-    if (scktCtrl->streamType == 'U')                    // protocol == UDP
+    do
     {
-        atcmd_tryInvoke("AT+QIOPEN=%d,%d,\"UDP\",\"%s\",%d,%d", pdpCntxt, scktCtrl->dataCntxt, scktCtrl->hostUrl, scktCtrl->hostPort, scktCtrl->lclPort);
-        rslt = atcmd_awaitResultWithOptions(sckt__defaultOpenTimeoutMS, S__udptcpOpenCompleteParser);
-    }
-
-    else if (scktCtrl->streamType == 'T')               // protocol == TCP
-    {
-        atcmd_tryInvoke("AT+QIOPEN=%d,%d,\"TCP\",\"%s\",%d,%d", pdpCntxt, scktCtrl->dataCntxt, scktCtrl->hostUrl, scktCtrl->hostPort, scktCtrl->lclPort);
-        rslt = atcmd_awaitResultWithOptions(sckt__defaultOpenTimeoutMS, S__udptcpOpenCompleteParser);
-    }
-
-    else if (scktCtrl->streamType == 'S')               // protocol == SSL/TLS
-    {
-        atcmd_tryInvoke("AT+QSSLOPEN=%d,%d,\"SSL\",\"%s\",%d,%d", pdpCntxt, scktCtrl->dataCntxt, scktCtrl->hostUrl, scktCtrl->hostPort, scktCtrl->lclPort);
-        rslt = atcmd_awaitResultWithOptions(sckt__defaultOpenTimeoutMS, S__sslOpenCompleteParser);
-    }
+        if (!S__scktOpenInvoke(scktCtrl))
+            return resultCode__conflict;
+        rslt = atcmd_awaitResult();
+    } while (atcmd_retryAgain(&retry, rslt));                                   // transient open failures (ex: 565 DNS) retried per policy
 
+    rslt = S__scktOpenResult(rslt);
     if (rslt == resultCode__success)
     {
+        scktCtrl->state = scktState_open;
         ltem_addStream(scktCtrl);
     }
     return rslt;
 }
 
 
+/**
+ *	@brief Start opening a data connection (socket), returns without waiting. Completion is signaled by ltem_eventMgr() to completeCB.
+ */
+bool sckt_openAsync(scktCtrl_t *scktCtrl, bool cleanSession, ltemAsyncComplete_func completeCB)
+{
+    if (ltem_isAsyncPending() || !S__scktOpenInvoke(scktCtrl))
+        return false;
+
+    ltemAsyncOp_t *asyncOp = LTEM_startAsync(S__scktOpenStep, scktCtrl, completeCB);
+    asyncOp->flag = cleanSession;
+    return true;
+}
+
+
 
 /**
  *	@brief Close an established (open) connection socket
@@ -149,12 +160,13 @@ void sckt_close(scktCtrl_t *scktCtrl)
     if (scktCtrl->state == scktState_closed)                                    // not open
         return;
 
+    bool invoked;
     if (scktCtrl->useTls)
-        atcmd_tryInvokeDefaults("AT+QSSLCLOSE=%d", scktCtrl->dataCntxt);        // BGx syntax different for SSL
+        invoked = atcmd_tryInvoke("AT+QSSLCLOSE=%d", scktCtrl->dataCntxt);     // BGx syntax different for SSL
     else
-        atcmd_tryInvokeDefaults("AT+QICLOSE=%d", scktCtrl->dataCntxt);          // BGx syntax different for TCP/UDP
+        invoked = atcmd_tryInvoke("AT+QICLOSE=%d", scktCtrl->dataCntxt);       // BGx syntax different for TCP/UDP
     
-    if (atcmd_awaitResult() == resultCode__success)
+    if (invoked && atcmd_awaitResult() == resultCode__success)
     {
         scktCtrl->state = scktState_closed;
         ltem_deleteStream(scktCtrl);
@@ -210,45 +222,63 @@ bool sckt_getState(scktCtrl_t *scktCtrl)
  */
 resultCode_t sckt_send(scktCtrl_t *scktCtrl, const char *data, uint16_t dataSz)
 {
-    resultCode_t rslt;
+    return sckt_sendWithPrefix(scktCtrl, NULL, 0, data, dataSz);
+}
+
+
+/**
+ *	@brief Send a prefix block followed by data, prefix and data are chained TX blocks sent as one +QISEND.
+ */
+resultCode_t sckt_sendWithPrefix(scktCtrl_t *scktCtrl, const char *prefix, uint16_t prefixSz, const char *data, uint16_t dataSz)
+{
+    resultCode_t rslt = resultCode__conflict;
+    atcmdRetry_t retry;
+    atcmd_retryInit(&retry, atcmdRetryClass_scktSend);
 
-    atcmd_configDataMode(scktCtrl->dataCntxt, "> ", atcmd_stdTxDataHndlr, data, dataSz, NULL, true);
-    atcmd_configDataModeEot(0x1A);
+    prefixSz = (prefix != NULL) ? prefixSz : 0;
+    ASSERT(prefixSz + dataSz < 1501);
 
-    if (atcmd_tryInvoke("AT+QISEND=%d,%d", scktCtrl->dataCntxt, dataSz))
+    do
     {
+        atcmd_configDataMode(scktCtrl->dataCntxt, "> ", atcmd_stdTxDataHndlr, data, dataSz, NULL, true);
+        atcmd_configDataModePrefix(prefix, prefixSz);
+        atcmd_configDataModeEot(0x1A);
+
+        if (!atcmd_tryInvokeCmd(atcmdCmd_qisend, scktCtrl->dataCntxt, prefixSz + dataSz))
+            break;
         rslt = atcmd_awaitResultWithOptions(atcmd__defaultTimeout, S__socketSendCompleteParser);
-        if (rslt == resultCode__success)
-        {
-            scktCtrl->statsTxCnt++;
-        }
+        atcmd_close();
+    } while (atcmd_retryAgain(&retry, rslt));                                   // SEND FAIL (BGx send buffer full) retried per policy
+
+    if (rslt == resultCode__success)
+    {
+        scktCtrl->statsTxCnt++;
     }
-    atcmd_close();
     return rslt;                                                            // return sucess -OR- failure from sendRequest\sendRaw action
 }
 
 
 // static resultCode_t S__scktTxDataHndlr()
 // {
-//     IOP_startTx(g_lqLTEM.atcmd->dataMode.txDataLoc, g_lqLTEM.atcmd->dataMode.txDataSz);
+//     IOP_startTx(g_lqLTEM->atcmd->dataMode.txDataLoc, g_lqLTEM->atcmd->dataMode.txDataSz);
 
 //     uint32_t startTime = pMillis();
 
-//     while (pMillis() - startTime < g_lqLTEM.atcmd->timeout)
+//     while (pMillis() - startTime < g_lqLTEM->atcmd->timeout)
 //     {
-//         if (CBFFR_FOUND(cbffr_find(g_lqLTEM.iop->rxBffr, "SEND OK", 0, 0, true)))
+//         if (CBFFR_FOUND(cbffr_find(g_lqLTEM->iop->rxBffr, "SEND OK", 0, 0, true)))
 //         {
-//             cbffr_skipTail(g_lqLTEM.iop->rxBffr, sizeof("SEND OK") + 1);
+//             cbffr_skipTail(g_lqLTEM->iop->rxBffr, sizeof("SEND OK") + 1);
 //             return resultCode__success;
 //         }
-//         else if(CBFFR_FOUND(cbffr_find(g_lqLTEM.iop->rxBffr, "SEND FAIL", 0, 0, true)))
+//         else if(CBFFR_FOUND(cbffr_find(g_lqLTEM->iop->rxBffr, "SEND FAIL", 0, 0, true)))
 //         {
-//             cbffr_skipTail(g_lqLTEM.iop->rxBffr, sizeof("SEND FAIL") + 1);
+//             cbffr_skipTail(g_lqLTEM->iop->rxBffr, sizeof("SEND FAIL") + 1);
 //             return resultCode__tooManyRequests;
 //         }
-//         else if(CBFFR_FOUND(cbffr_find(g_lqLTEM.iop->rxBffr, "ERROR", 0, 0, true)))
+//         else if(CBFFR_FOUND(cbffr_find(g_lqLTEM->iop->rxBffr, "ERROR", 0, 0, true)))
 //         {
-//             cbffr_skipTail(g_lqLTEM.iop->rxBffr, sizeof("SEND FAIL") + 1);
+//             cbffr_skipTail(g_lqLTEM->iop->rxBffr, sizeof("SEND FAIL") + 1);
 //             return resultCode__internalError;
 //         }
 
@@ -261,6 +291,48 @@ resultCode_t sckt_send(scktCtrl_t *scktCtrl, const char *data, uint16_t dataSz)
 #pragma region private local static functions
 /*-----------------------------------------------------------------------------------------------*/
 
+/**
+ *   @brief Invoke the protocol specific socket open command, leaving the result pending.
+ *   @return True if the open command was sent.
+*/
+static bool S__scktOpenInvoke(scktCtrl_t *scktCtrl)
+{
+    uint8_t pdpCntxt = (scktCtrl->pdpCntxt == 0) ? g_lqLTEM->providerInfo->defaultContext : scktCtrl->pdpCntxt;
+
+    if (scktCtrl->streamType == 'U')                    // protocol == UDP
+    {
+        return atcmd_invokeAsync(sckt__defaultOpenTimeoutMS, S__udptcpOpenCompleteParser, 
+                                 "AT+QIOPEN=%d,%d,\"UDP\",\"%s\",%d,%d", pdpCntxt, scktCtrl->dataCntxt, scktCtrl->hostUrl, scktCtrl->hostPort, scktCtrl->lclPort);
+    }
+    else if (scktCtrl->streamType == 'T')               // protocol == TCP
+    {
+        return atcmd_invokeAsync(sckt__defaultOpenTimeoutMS, S__udptcpOpenCompleteParser, 
+                                 "AT+QIOPEN=%d,%d,\"TCP\",\"%s\",%d,%d", pdpCntxt, scktCtrl->dataCntxt, scktCtrl->hostUrl, scktCtrl->hostPort, scktCtrl->lclPort);
+    }
+    else if (scktCtrl->streamType == 'S')               // protocol == SSL/TLS
+    {
+        return atcmd_invokeAsync(sckt__defaultOpenTimeoutMS, S__sslOpenCompleteParser, 
+                                 "AT+QSSLOPEN=%d,%d,\"SSL\",\"%s\",%d,%d", pdpCntxt, scktCtrl->dataCntxt, scktCtrl->hostUrl, scktCtrl->hostPort, scktCtrl->lclPort);
+    }
+    return false;
+}
+
+
+/**
+ *   @brief Async step for sckt_openAsync(), completes when the socket open result is received.
+*/
+static resultCode_t S__scktOpenStep(void *ctrl)
+{
+    resultCode_t rslt = S__scktOpenResult(atcmd_poll());                      // pending (unknown) passes through
+    if (rslt == resultCode__success)
+    {
+        ((scktCtrl_t *)ctrl)->state = scktState_open;
+        ltem_addStream((streamCtrl_t *)ctrl);
+    }
+    return rslt;
+}
+
+
 #define SCKT_URC_HEADERSZ 30
 
 /**
@@ -277,82 +349,57 @@ resultCode_t sckt_send(scktCtrl_t *scktCtrl, const char *data, uint16_t dataSz)
      * +QSSLURC: "closed",<clientID>
 
      * NOTE:
-     * +QIURC: "pdpdeact",<contextID>   // not handled here, falls through to global URC handler
+     * +QIURC: "pdpdeact",<contextID>   // not registered here, system URC forwarded by ltem_eventMgr() (contextID 0 is all)
     */
 
-static void S__scktUrcHndlr()
+static resultCode_t S__scktUrcHndlr(const urcEvent_t *urcEvent)
 {
-    cbuffer_t *rxBffr = g_lqLTEM.iop->rxBffr;                           // for convenience
-
-    // not a socket URC or insufficient chars to parse URC header
-    if (cbffr_find(rxBffr, "\"pdpdeact\"", 0, 0, false) >= 0)           // +QIURC: "pdpdeact" handled at higher level, +QIURC overlaps with UDP/TCP
+    // "pdpdeact" = packet network lost, close sockets opened on the PDP context
+    if (strstr(urcEvent->prefix, "\"pdpdeact\"") != NULL)
     {
-        return;
-    }
+        uint8_t pdpCntxt = strtol(urcEvent->line + strlen(urcEvent->prefix) + 1, NULL, 10);
+        for (uint8_t dataCntxt = 0; dataCntxt < dataCntxt__cnt; dataCntxt++)
+        {
+            scktCtrl_t* scktCtrl = (scktCtrl_t*)ltem_getStreamFromCntxt(dataCntxt, streamType__SCKT);
+            if (scktCtrl == NULL)
+                continue;
 
-    bool isUdpTcp = CBFFR_FOUND(cbffr_find(rxBffr, "+QIURC", 0, 0, false));
-    bool isSslTls = CBFFR_FOUND(cbffr_find(rxBffr, "+QSSLURC", 0, 0, false));
-    if (!isUdpTcp && !isSslTls)
-    {
-        return;
+            uint8_t scktPdpCntxt = (scktCtrl->pdpCntxt == 0) ? g_lqLTEM->providerInfo->defaultContext : scktCtrl->pdpCntxt;
+            if (pdpCntxt == 0 || scktPdpCntxt == pdpCntxt)
+                scktCtrl->state = scktState_closed;
+        }
+        return resultCode__success;
     }
 
-    /* UDP/TCP/SSL/TLS URC
-     * ----------------------------------------------------------------------------------------- */
-
-    char workBffr[80] = {0};
-    char *workPtr = workBffr;
+    bool isUdpTcp = urcEvent->prefix[2] == 'I';                         // +QIURC: / +QSSLURC:
+    uint8_t dataCntxt = strtol(urcEvent->line + strlen(urcEvent->prefix) + 1, NULL, 10);     // prefix ends with event name, followed by ,<connectID>
+    ASSERT(dataCntxt < dataCntxt__cnt);
 
-    int16_t nextIndx = cbffr_find(rxBffr, "+QIURC", 0, 0, true);            // advance bffr-tail ptr to starting point
-    if (isUdpTcp) 
-    {
-        cbffr_skip(rxBffr, 9);                                              // UDP/TCP: + QIURC: "
-    }
-    else 
-    {
-        cbffr_skip(rxBffr, 11);                                             // SSL/TLS: +QSSLURC: "
-    }
-    uint16_t eolIndx = cbffr_find(rxBffr, "\r\n", 0, 30, false);
-    if (CBFFR_FOUND(eolIndx))                                               // got full line, work on URC
-    {
-        cbffr_skipTail(rxBffr, 9);                                          // ignore prefix
-        cbffr_pop(rxBffr, workBffr, eolIndx - 9);
-    }
-    else
+    scktCtrl_t* scktCtrl = (scktCtrl_t*)ltem_getStreamFromCntxt(dataCntxt, streamType__SCKT);
+    if (scktCtrl == NULL)                                                       // socket closed locally, URC crossed close
     {
-        return;                                                             // don't have full URC line yet, come back later
+        return resultCode__notFound;
     }
-    
+
     /* URC ready to process
      ----------------------------------------------------------------------- */
-    uint8_t dataCntxt;
 
-    uint16_t irdAvailSz = 0;
     // "recv" = socket new data receive
-    if (workBffr[0] == 'r')
+    if (strstr(urcEvent->prefix, "\"recv\"") != NULL)
     {
-        dataCntxt = strtol(workPtr + sizeof("recv\""), NULL, 10);           // valid for both UDP/TCP and SSL
-        ASSERT(dataCntxt < dataCntxt__cnt);
-
-        streamCtrl_t* streamCtrl = ltem_getStreamFromCntxt(dataCntxt, streamType__ANY);
-        ASSERT(streamCtrl->streamType == streamType_UDP ||
-               streamCtrl->streamType == streamType_TCP ||
-               streamCtrl->streamType == streamType_SSLTLS);
-        scktCtrl_t* scktCtrl = (scktCtrl_t*)streamCtrl;
-
         uint16_t irdRemain = 0;
         do
         {
-            uint16_t irdRqstSz = cbffr_getVacant(g_lqLTEM.iop->rxBffr) / 2;     // request up to half of available buffer space
+            uint16_t irdRqstSz = cbffr_getVacant(g_lqLTEM->iop->rxBffr) / 2;     // request up to half of available buffer space
             if (isUdpTcp)
             {
                 atcmd_configDataMode(scktCtrl->dataCntxt, "+QIRD: ", S__scktRxHndlr, NULL, 0, scktCtrl->appRecvDataCB, true);
-                atcmd_tryInvoke("AT+QIRD=%d,%d", (uint8_t)dataCntxt, irdRqstSz);
+                atcmd_tryInvokeCmd(atcmdCmd_qird, (uint8_t)dataCntxt, irdRqstSz);
             }
             else
             {
                 atcmd_configDataMode(scktCtrl->dataCntxt, "+QSSLRECV: ", S__scktRxHndlr, NULL, 0, scktCtrl->appRecvDataCB, true);
-                atcmd_tryInvoke("AT+QSSLRECV=%d,%d", (uint8_t)dataCntxt, irdRqstSz);
+                atcmd_tryInvokeCmd(atcmdCmd_qsslrecv, (uint8_t)dataCntxt, irdRqstSz);
             }
             atcmd_awaitResult();
             irdRemain = atcmd_getValue();
@@ -361,16 +408,11 @@ static void S__scktUrcHndlr()
     }
 
     // "closed" = socket closed
-    if (workBffr[0] == 'c')                                                
+    else
     {
-        dataCntxt = strtol(workPtr + sizeof("closed\"") , NULL, 10);
-        ASSERT(dataCntxt < dataCntxt__cnt);
-
-        uint8_t indx = LTEM__getStreamIndx(dataCntxt);
-        ((scktCtrl_t*)g_lqLTEM.streams[indx])->state = scktState_closed;
+        scktCtrl->state = scktState_closed;
     }
-
-    return;
+    return resultCode__success;
 }    
 
 
@@ -385,7 +427,7 @@ static resultCode_t S__scktRxHndlr()
 
     char wrkBffr[32] = {0};
     char *wrkPtr = wrkBffr;
-    streamCtrl_t* streamCtrl = ltem_getStreamFromCntxt(g_lqLTEM.atcmd->dataMode.contextKey, streamType__ANY);
+    streamCtrl_t* streamCtrl = ltem_getStreamFromCntxt(g_lqLTEM->atcmd->dataMode.contextKey, streamType__ANY);
 
     ASSERT(streamCtrl->streamType == streamType_UDP ||                                                          // assert that the stream config is consistent
            streamCtrl->streamType == streamType_TCP || 
@@ -393,47 +435,45 @@ static resultCode_t S__scktRxHndlr()
     scktCtrl_t *scktCtrl = (scktCtrl_t*)streamCtrl;
     
     pDelay(1);                                                                                                  // ugly, but creating loop to wait 500uS seems silly
-    uint8_t popCnt = cbffr_find(g_lqLTEM.iop->rxBffr, "\r", 0, 0, false);
+    uint8_t popCnt = cbffr_find(g_lqLTEM->iop->rxBffr, "\r", 0, 0, false);
     if (CBFFR_NOTFOUND(popCnt))
     {
         return resultCode__internalError;
     }
     
-    cbffr_pop(g_lqLTEM.iop->rxBffr, wrkBffr, popCnt + 2);                                                       // pop preamble phrase to parse data length
+    cbffr_pop(g_lqLTEM->iop->rxBffr, wrkBffr, popCnt + 2);                                                       // pop preamble phrase to parse data length
     wrkPtr = memchr(wrkBffr, ':', popCnt) + 2;
     uint16_t irdSz = strtol(wrkPtr, NULL, 10);
-    g_lqLTEM.atcmd->retValue = irdSz;
+    g_lqLTEM->atcmd->retValue = irdSz;
 
     PRINTF(dbgColor__cyan, "scktRxHndlr() cntxt=%d irdSz=%d\r", scktCtrl->dataCntxt, irdSz);
 
+    uint32_t readTimeout = pMillis();
     while (irdSz > 0)
     {
-        uint32_t readTimeout = pMillis();
+        readTimeout = pMillis();
         uint16_t bffrCnt;
-        do                                                                                                      // wait for buffer to recv IRD data
+        while ((bffrCnt = cbffr_getOccupied(g_lqLTEM->iop->rxBffr)) < MIN(irdSz, sckt__irdRequestPageSz))    // wait for buffer to recv IRD data
         {
-            bffrCnt = cbffr_getOccupied(g_lqLTEM.iop->rxBffr);
+            IOP_awaitRx(sckt__readTimeoutMs);
             ASSERT_NOTSTALLED(readTimeout, sckt__readTimeoutMs);
-        } while (bffrCnt < sckt__irdRequestPageSz);
+        }
         
         char* streamPtr;
-        uint16_t blockSz = cbffr_popBlock(g_lqLTEM.iop->rxBffr, &streamPtr, irdSz);                             // get data ptr from rxBffr
+        uint16_t blockSz = IOP_rxPopBlock(&streamPtr, irdSz);                                                    // get data ptr from rxBffr
         PRINTF(dbgColor__cyan, "scktRxHndlr() ptr=%p, blkSz=%d, availSz=%d\r", streamPtr, blockSz, irdSz);
 
         irdSz -= blockSz;
         ((scktAppRecv_func)(*scktCtrl->appRecvDataCB))(scktCtrl->dataCntxt, streamPtr, blockSz, irdSz == 0);    // forward to application
-        cbffr_popBlockFinalize(g_lqLTEM.iop->rxBffr, true);                                                     // commit POP
+        IOP_rxPopBlockFinalize();                                                                               // commit POP
+    }
 
-        if (irdSz == 0)                                                                                         // done with data
-        {
-            while (cbffr_getOccupied(g_lqLTEM.iop->rxBffr) < sckt__readTrailerSz)
-            {
-                pDelay(1);                                                                                      // yield
-                ASSERT_NOTSTALLED(readTimeout, sckt__readTimeoutMs);
-            }
-            cbffr_skipTail(g_lqLTEM.iop->rxBffr, sckt__readTrailerSz);
-        }
+    while (cbffr_getOccupied(g_lqLTEM->iop->rxBffr) < sckt__readTrailerSz)                                     // done with data (or none), OK trailer follows
+    {
+        IOP_awaitRx(sckt__readTimeoutMs);                                                                       // sleep until RX
+        ASSERT_NOTSTALLED(readTimeout, sckt__readTimeoutMs);
     }
+    cbffr_skipTail(g_lqLTEM->iop->rxBffr, sckt__readTrailerSz);
     return resultCode__success;
 }
 
@@ -467,20 +507,47 @@ static cmdParseRslt_t S__sslrecvResponseHeaderParser()
 
 
 /**
- *	@brief [private] TCP/UDP wrapper for open connection parser.
+ *	@brief [private] Map the socket open result and BGx <err> (atcmd_getValue()) to a result code, <err> 0 is success.
+ */
+static resultCode_t S__scktOpenResult(resultCode_t rslt)
+{
+    if (rslt != resultCode__success)
+        return rslt;
+
+    switch (atcmd_getValue())
+    {
+        case 0:
+            return resultCode__success;
+        case 552:                                                               // invalid parameters
+            return resultCode__badRequest;
+        case 563:                                                               // socket identity in use
+        case 574:                                                               // port busy
+            return resultCode__conflict;
+        case 565:                                                               // DNS parse failed
+            return resultCode__notFound;
+        default:                                                                // connect failed/timeout, PDP, etc.
+            return resultCode__gtwyTimeout;
+    }
+}
+
+
+/**
+ *	@brief [private] TCP/UDP wrapper for open connection parser, +QIOPEN: <connectID>,<err> captures <err> (atcmd_getValue()).
+ *  @note The result line follows OK, preamble is not required ahead of it: parser stays pending until the line arrives.
  */
 static cmdParseRslt_t S__udptcpOpenCompleteParser(const char *response, char **endptr) 
 {
-    return atcmd_stdResponseParser("+QIOPEN: ", true, ",", 1, 1, "", 0);
+    return atcmd_stdResponseParser("+QIOPEN: ", false, ",", 2, 2, "\r\n", 0);
 }
 
 
 /**
- *	@brief [private] SSL wrapper for open connection parser.
+ *	@brief [private] SSL wrapper for open connection parser, +QSSLOPEN: <clientID>,<err> captures <err> (atcmd_getValue()).
+ *  @note The result line follows OK, see S__udptcpOpenCompleteParser().
  */
 static cmdParseRslt_t S__sslOpenCompleteParser(const char *response, char **endptr) 
 {
-    return atcmd_stdResponseParser("+QSSLOPEN: ", true, ",", 1, 1, "", 0);
+    return atcmd_stdResponseParser("+QSSLOPEN: ", false, ",", 2, 2, "\r\n", 0);
 }
 
 
@@ -502,8 +569,8 @@ static cmdParseRslt_t S__socketSendCompleteParser(const char *response, char **e
  */
 static cmdParseRslt_t S__socketStatusParser(const char *response, char **endptr) 
 {
-    // BGx +QMTCONN Read returns Status = 3 for connected, service parser returns 203
-    return atcmd_serviceResponseParser(response, "+QISTATE: ", 5, endptr) == 202 ? resultCode__success : resultCode__unavailable;
+    // +QISTATE: <connectID>,"<service_type>","<IP>",<remote_port>,<local_port>,<socket_state>,... socket_state 2 = connected (atcmd_getValue())
+    return atcmd_stdResponseParser("+QISTATE: ", true, ",", 6, 6, "", 0);
 }
 
 #pragma endregion
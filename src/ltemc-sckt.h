@@ -138,6 +138,17 @@ void sckt_setConnection(scktCtrl_t *scktCtrl, uint8_t pdpCntxt, const char *host
 resultCode_t sckt_open(scktCtrl_t *scktCtrl, bool cleanSession);
 
 
+/**
+ *	@brief Start opening a data connection (socket), returning without waiting for the BGx open result.
+ *  @details Open is completed by ltem_eventMgr(), which calls completeCB with the scktCtrl and the sckt_open() style result code.
+ *  @param scktCtrl [in/out] Pointer to socket control structure
+ *  @param cleanSession [in] - If the port is found already open, TRUE: flushes any previous data from the socket session
+ *  @param completeCB [in] - Application callback on open completion
+ *  @return True if the open was started, false if another command or async operation is underway
+ */
+bool sckt_openAsync(scktCtrl_t *scktCtrl, bool cleanSession, ltemAsyncComplete_func completeCB);
+
+
 /**
  *	@brief Close an established (open) connection socket
  *	@param scktCtrl [in] - Pointer to socket control struct governing the sending socket's operation
@@ -181,6 +192,18 @@ bool sckt_getState(scktCtrl_t *scktCtrl);
 resultCode_t sckt_send(scktCtrl_t *scktCtrl, const char *data, uint16_t dataSz);
 
 
+/**
+ *	@brief Send a prefix block (ex: application framing header) followed by data as one send, neither is copied.
+ 
+ *	@param scktCtrl [in] - Pointer to socket control struct governing the sending socket's operation
+ *	@param prefix [in] - A character pointer containing the prefix to send ahead of data
+ *  @param prefixSz [in] - The size of the prefix
+ *	@param data [in] - A character pointer containing the data to send
+ *  @param dataSz [in] - The size of the buffer (prefixSz + dataSz < 1501 bytes)
+ */
+resultCode_t sckt_sendWithPrefix(scktCtrl_t *scktCtrl, const char *prefix, uint16_t prefixSz, const char *data, uint16_t dataSz);
+
+
 /**
  *	@brief Fetch receive data by host application
  
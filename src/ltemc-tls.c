@@ -46,32 +46,17 @@
 
 bool tls_configure(uint8_t dataCntxt, tlsVersion_t version, tlsCipher_t cipherSuite, tlsCertExpiration_t certExpirationCheck, tlsSecurityLevel_t securityLevel)
 {
-    if (atcmd_tryInvoke("AT+QSSLCFG=\"sslversion\",%d,%d", dataCntxt, version))                   // set SSL/TLS version
-    {
-        if (atcmd_awaitResult() != resultCode__success)                                         // return on failure, continue on success
-            return false;
-    }
-
-
-    if (atcmd_tryInvoke("AT+QSSLCFG=\"ciphersuite\",%d,0X%X", dataCntxt, cipherSuite))            // set cipher suite
-    {
-        if (atcmd_awaitResult() != resultCode__success)                                         // return on failure, continue on success
-            return false;
-    }
+    /* settings are independent, batch all and send as one command line; settings already in effect are skipped
+     */
+    atcmdBatch_t batch;
+    atcmd_batchInit(&batch, atcmd__noTimeoutChange);
 
-    if (atcmd_tryInvoke("AT+QSSLCFG=\"ignorelocaltime\",%d,%d", dataCntxt, certExpirationCheck))  // set certificate expiration check
-    {
-        if (atcmd_awaitResult() != resultCode__success)                                         // return on failure, continue on success
-            return false;
-    }
-
-    if (atcmd_tryInvoke("AT+QSSLCFG=\"seclevel\",%d,%d", dataCntxt, securityLevel))               // set security level, aka what is checked
-    {
-        if (atcmd_awaitResult() != resultCode__success)                                         // return on failure, continue on success
-            return false;
-    }
+    atcmd_batchAddSetting(&batch, 2, "AT+QSSLCFG=\"sslversion\",%d,%d", dataCntxt, version);                    // set SSL/TLS version
+    atcmd_batchAddSetting(&batch, 2, "AT+QSSLCFG=\"ciphersuite\",%d,0X%X", dataCntxt, cipherSuite);             // set cipher suite
+    atcmd_batchAddSetting(&batch, 2, "AT+QSSLCFG=\"ignorelocaltime\",%d,%d", dataCntxt, certExpirationCheck);   // set certificate expiration check
+    atcmd_batchAddSetting(&batch, 2, "AT+QSSLCFG=\"seclevel\",%d,%d", dataCntxt, securityLevel);                // set security level, aka what is checked
 
-    return true;
+    return atcmd_batchExec(&batch) == resultCode__success;
 }
 
 
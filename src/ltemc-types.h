@@ -51,10 +51,21 @@ enum ltem__constants
     ltem__moduleTypeSz = 8,
 
     ltem__streamCnt = 4,            /// 6 SSL/TLS capable data contexts + file system allowable, 4 concurrent seams reasonable
-    //ltem__urcHandlersCnt = 4        /// max number of concurrent protocol URC handlers (today only http, mqtt, sockets, filesystem)
+    ltem__deviceMax = 2,            /// number of concurrent LTEm device instances (ISR dispatch slots)
+    ltem__shadowSz = 12,            /// modem settings shadowed (last applied value), least recently written are evicted
+    ltem__shadowTextSz = 96,        /// shadowed setting key + value chars, longer settings are not shadowed (always written)
+    ltem__arbiterSlots = 6,         /// tasks concurrently waiting for modem access (ltem_acquire)
+    ltem__urcPrefixCnt = 14,        /// URC prefixes registered for dispatch (ltem_registerUrc), max 16 (classifier bit mask)
+    ltem__urcQueueSz = 8,           /// URC events received awaiting service by ltem_eventMgr() (1 slot kept open)
 };
 
 
+/** 
+ *  @brief Handle to an LTEm device instance, returned by ltem_create() and selected for LTEmC calls with ltem_bind().
+ */
+typedef struct ltemDevice_tag *ltemHandle_t;
+
+
 /** 
  *  @brief Typed numeric constants for stream peers subsystem (sockets, mqtt, http)
  */
@@ -118,6 +129,50 @@ typedef enum dataCntxt_tag
 
 typedef void (*doWork_func)();                                           // module background worker
 typedef void (*powerSaveCallback_func)(uint8_t newPowerSaveState);
+typedef resultCode_t (*ltemAsyncStep_func)(void *ctrl);                  // async operation step, resultCode__unknown while in progress
+typedef void (*ltemAsyncComplete_func)(void *ctrl, resultCode_t resultCode);    // async operation completion callback into application
+typedef void (*ltemWait_func)(uint32_t timeoutMS);                      // block until signalled (ltemSignal_func) or timeout: semaphore take, event flag wait, WFI
+typedef void (*ltemSignal_func)();                                      // wake waiter, called from ISR after RX chars are added to RX buffer
+typedef void (*ltemCritical_func)(bool enter);                          // enter/exit critical section (RTOS mutex or scheduler lock) protecting LTEmC lock state
+
+
+/** 
+ *  @brief Modem access priority for ltem_acquire(), higher priority waiters are granted access first.
+ */
+typedef enum ltemPriority_tag
+{
+    ltemPriority_low = 0,                       /// background polling (ex: signal quality, GNSS)
+    ltemPriority_normal = 1,
+    ltemPriority_high = 2                       /// latency sensitive (ex: MQTT publish)
+} ltemPriority_t;
+
+
+/** 
+ *  @brief Task request for modem access, carries the task's priority and cancellation token (see ltem_acquire()).
+ */
+typedef struct ltemRequest_tag
+{
+    ltemPriority_t priority;                    /// access priority
+    volatile bool cancel;                       /// cancellation token, set by ltem_cancel(): abandons wait or in-flight command
+    volatile bool granted;                      /// request holds modem access
+    uint32_t arrival;                           /// arrival sequence, equal priority requests granted in order
+    void *waitCntxt;                            /// application wait context for request wait callbacks (ex: task handle), set by application
+} ltemRequest_t;
+
+typedef void (*ltemRequestWait_func)(ltemRequest_t *request, uint32_t timeoutMS);  // block requesting task until signalled or timeout: task notify take, per-task semaphore
+typedef void (*ltemRequestSignal_func)(ltemRequest_t *request);         // wake task waiting on request (granted or cancelled), called within critical section
+
+
+/** 
+ *  @brief Task's LTEmC binding: the device its calls operate on and its request holding access (see ltem_setTaskBindingCallback()).
+ */
+typedef struct ltemTaskBinding_tag
+{
+    ltemHandle_t device;                        /// device bound with ltem_bind()
+    ltemRequest_t *request;                     /// request granted by ltem_acquire(), NULL once released
+} ltemTaskBinding_t;
+
+typedef ltemTaskBinding_t *(*ltemTaskBinding_func)();                   // calling task's binding in thread-local storage
 
 
 /* Modem/Provider/Network Type Definitions
@@ -151,6 +206,20 @@ typedef enum ntwkIotMode_tag
 } ntwkIotMode_t;
 
 
+/** 
+ *  \brief Enum of network registration status, <stat> reported by +CEREG (LTE) and +CGREG (GSM/GPRS).
+*/
+typedef enum ntwkRegStatus_tag
+{
+    ntwkRegStatus_notRegistered = 0U,   /// Not registered, BGx is not searching for an operator.
+    ntwkRegStatus_home = 1U,            /// Registered, home network.
+    ntwkRegStatus_searching = 2U,       /// Not registered, BGx is searching for an operator to register to.
+    ntwkRegStatus_denied = 3U,          /// Registration denied.
+    ntwkRegStatus_unknown = 4U,         /// Unknown, ex: out of coverage.
+    ntwkRegStatus_roaming = 5U          /// Registered, roaming.
+} ntwkRegStatus_t;
+
+
 /** 
  *  \brief Typed numeric constants for network subsystem.
 */
@@ -206,6 +275,7 @@ typedef struct modemSettings_tag
     ntwkScanMode_t scanMode;
     ntwkIotMode_t iotMode;
     char defaultNtwkConfig[ntwk__ntwkConfigSz]; /// Invoke ready default context config
+    uint32_t baudRate;                          /// Requested BGx UART baud rate (0=default), reapplied following BGx reset
 } modemSettings_t;
 
 
@@ -244,6 +314,9 @@ typedef struct providerInfo_tag
     uint8_t defaultContext;
     uint8_t networkCnt;                             /// The number of networks in networks[]
     networkInfo_t networks[ntwk__pdpContextCnt];    /// Collection of contexts with network carrier. This is typically only 1, but some carriers implement more (ex VZW).
+    ntwkRegStatus_t epsRegStatus;                   /// LTE (EPS) registration status, kept current by +CEREG URCs
+    ntwkRegStatus_t gprsRegStatus;                  /// GSM/GPRS registration status, kept current by +CGREG URCs
+    uint32_t regStatusAt;                           /// tick count of last registration status report, 0 if none reported yet
 } providerInfo_t;
 
 
@@ -262,15 +335,37 @@ enum IOP__Constants
     // IOP__txCmdBufferSize = 192,
     // IOP__rxCoreBufferSize = 192,
 
-    IOP__uartBaudRate = 115200,     // baud rate between BGx and NXP UART
+    IOP__uartBaudRate = 115200,     // default (BGx reset) baud rate between BGx and NXP UART, see ltem_setBaudRate()
     IOP__uartFIFOBufferSz = 64,
-    IOP__uartFIFOFillPeriod = (int)(1 / (double)IOP__uartBaudRate * 10 * IOP__uartFIFOBufferSz * 1000) + 1,
+    IOP__uartFIFOFillPeriod = (int)(1 / (double)IOP__uartBaudRate * 10 * IOP__uartFIFOBufferSz * 1000) + 1,    // at default rate, see IOP_getFifoFillPeriod()
 
     IOP__rxDefaultTimeout = IOP__uartFIFOFillPeriod * 2,
-    IOP__urcDetectBufferSz = 40
+    IOP__baudProbeAttempts = 3,     // link verification attempts following a baud rate change
+    IOP__baudProbeTimeout = 500,
+
+    IOP__txQueueSz = 4,             // TX descriptors: command/prefix, payload, EOT + 1 open slot
+
+    IOP__cmdRxTriggerLevel = 8,     // command profile: short responses raise RX IRQ without waiting for RX time-out
+    IOP__cmdTxTriggerLevel = 32,
+    IOP__dataRxTriggerLevel = 52,   // data profile: fewer, larger FIFO drains (below flow control halt level of 60)
+    IOP__dataTxTriggerLevel = 56,
+    IOP__rxFlowResumeVacancy = IOP__uartFIFOBufferSz * 2,   // LTEMC_HW_FLOWCTRL: RX buffer vacancy required to resume draining bridge FIFO
+    IOP__rxBufferSlackSz = IOP__uartFIFOBufferSz,           // contiguous slack past RX ring end: FIFO drains and pops span the wrap without splitting
+    IOP__urcDetectBufferSz = 40     // URC line chars captured in a URC event, longer lines are truncated
 };
 
 
+/**
+ *	\brief IOP bridge FIFO trigger level profiles.
+ */
+typedef enum iopTrafficProfile_tag
+{
+    iopTrafficProfile_none = 0,             /// not yet applied (following bridge start/reset)
+    iopTrafficProfile_command,              /// low-latency: AT command/response exchanges
+    iopTrafficProfile_data                  /// high-throughput: stream data mode transfers
+} iopTrafficProfile_t;
+
+
 /** 
  *  @brief Streams 
  *  @details Structures for stream control/processing
@@ -290,8 +385,22 @@ typedef enum streamType_tag
 } streamType_t;
 
 
+/** 
+ *  @brief URC event, a URC line classified and captured by the RX ISR, queued for service by ltem_eventMgr() between commands.
+ */
+typedef struct urcEvent_tag
+{
+    const char *prefix;                             /// registered prefix matched (ex: "+QMTSTAT:")
+    uint8_t urcIndx;                                /// URC dispatch table entry
+    uint32_t arrivedAt;                             /// tick count URC line was received (iop->lastRxAt)
+    uint32_t rxAt;                                  /// RX position of line start (iop->rxCommitCnt), locates line in a data transfer
+    bool inDataXfer;                                /// line was read by a data transfer (not a URC), event is not serviced
+    char line[IOP__urcDetectBufferSz];              /// URC line without line end, NUL terminated (truncated if longer)
+} urcEvent_t;
+
+
 // function prototypes
-typedef resultCode_t (*urcEvntHndlr_func)();        // data comes from rxBuffer, this function parses and forwards to application via appRcvProto_func
+typedef resultCode_t (*urcEvntHndlr_func)(const urcEvent_t *urcEvent);  // URC dispatched by prefix, handler parses URC event line and forwards to application
 typedef resultCode_t (*dataRxHndlr_func)();         // data comes from rxBuffer, this function parses and forwards to application via appRcvProto_func
 typedef void (*appRcvProto_func)();                 // prototype func() for stream recvData callback
 
@@ -305,9 +414,31 @@ typedef struct streamCtrl_tag
 } streamCtrl_t;
 
 
+/** 
+ *  @brief URC dispatch table entry, a URC line prefix and the handler servicing it (see ltem_registerUrc()).
+ */
+typedef struct urcDispatch_tag
+{
+    const char *prefix;                             /// URC prefix, matched from start of line (ex: "+QMTSTAT:")
+    uint8_t prefixSz;
+    urcEvntHndlr_func urcHndlr;                     /// called by ltem_eventMgr() with the URC event
+    bool isStream;                                  /// URC content is streamed from rxBffr by handler (tail at URC), otherwise line is removed
+} urcDispatch_t;
+
+
 /*
  * ============================================================================================= */
 
+/** 
+ *  \brief TX descriptor, a block of data queued for sending. Data is not copied, it must remain valid until sent.
+ */
+typedef struct iopTxDesc_tag
+{
+    const char *data;
+    uint16_t size;
+} iopTxDesc_t;
+
+
 /** 
  *  \brief Struct for the IOP subsystem state. During initialization a pointer to this structure is reference in g_ltem1.
  * 
@@ -317,12 +448,52 @@ typedef struct streamCtrl_tag
  */
 typedef struct iop_tag
 {
-    volatile char* txBffr;
-    volatile uint16_t txPending;
+    volatile char* txBffr;                  /// next char to send from current TX descriptor
+    volatile uint16_t txPending;            /// chars remaining in current TX descriptor
+    iopTxDesc_t txQueue[IOP__txQueueSz];    /// queued TX descriptors, sent in order by ISR without copying
+    volatile uint8_t txQueueHead;           /// next txQueue slot to fill (IOP_enqueueTx)
+    volatile uint8_t txQueueTail;           /// next txQueue descriptor to send (ISR)
+    volatile bool isrHeld;                  /// foreground critical section with the ISR (bridgeIer update), IRQ service deferred
+    volatile bool isrPending;               /// IRQ arrived while isrHeld, serviced when the foreground releases
 
     cbuffer_t *rxBffr;                      /// receive buffer
-    char txEot;                             /// if not NULL, char to output on empty TX FIFO; clears automatically on use.
+    char *rxRaw;                            /// rxBffr memory: ltem__bufferSz_rx ring followed by IOP__rxBufferSlackSz slack
+    uint16_t rxPopWrapSz;                   /// chars of current IOP_rxPopBlock() mirrored from ring start into slack
+    char txEot;                             /// if not NULL, char sent following dataMode TX data; cleared after use.
+
+    volatile uint8_t rxDmaPending;          /// LTEMC_SPI_DMA: chars of the current FIFO drain not yet committed to rxBffr, 0 = no DMA drain active
+    char *rxDmaBlock;                       /// LTEMC_SPI_DMA: rxBffr block receiving the DMA transfer currently in flight
+    uint8_t rxDmaBlockSz;                   /// LTEMC_SPI_DMA: chars in the DMA transfer currently in flight
+    uint8_t rxDmaSpillSz;                   /// LTEMC_SPI_DMA: chars of the DMA transfer in flight landing in RX buffer slack
+    volatile bool rxFlowHalted;             /// LTEMC_HW_FLOWCTRL: RX IRQ masked, bridge FIFO left to fill and halt BGx with RTS
+
+    volatile uint16_t rxOverflowCnt;        /// FIFO drains that did not fit in rxBffr, newest chars dropped
+    volatile uint16_t rxLineErrorCnt;       /// RX line status errors (overrun, parity, framing, break), FIFO contents dropped
+    volatile uint32_t rxDroppedCnt;         /// chars dropped by overflow, line errors and resync
+    volatile bool rxResyncPending;          /// following a drop, RX chars are discarded through the next \n boundary
+    volatile bool rxFaultNotifyPending;     /// RX drop occurred since last application notification (ltem_eventMgr)
+    volatile bool rxSignalled;              /// RX chars added to rxBffr since last IOP_awaitRx() (ISR sets, awaitRx clears)
+    volatile uint32_t rxCommitCnt;          /// chars committed to rxBffr since start (wraps), RX position of the rxBffr head
+    volatile bool rxDataXfer;               /// data transfer reading rxBffr (data mode, URC stream), URC classification suspended
+    uint32_t rxDataXferAt;                  /// RX position of rxBffr tail at data transfer start
+
+    urcDispatch_t urcTable[ltem__urcPrefixCnt];  /// URC prefix to handler dispatch table, see ltem_registerUrc()
+    volatile uint16_t urcActive;            /// urcTable entries in use, bit per entry
+    urcEvent_t urcQueue[ltem__urcQueueSz];  /// URC events: ISR captures at head, ltem_eventMgr() services from tail
+    volatile uint8_t urcQueueHead;
+    volatile uint8_t urcQueueTail;
+    volatile uint16_t urcDroppedCnt;        /// URC events lost to a full urcQueue (ISR)
+    uint16_t urcDroppedReported;            /// urcDroppedCnt added to metrics
+    bool urcServicing;                      /// reentrancy guard, URC handlers invoke commands
+    uint16_t urcCandidates;                 /// URC classifier (ISR): urcTable entries matching current RX line so far
+    uint8_t urcLinePos;                     /// URC classifier (ISR): chars received in current RX line
+    int8_t urcMatched;                      /// URC classifier (ISR): urcTable entry matched by current RX line, -1 = none
+    uint32_t urcLineAt;                     /// URC classifier (ISR): RX position of current RX line start
  
+    uint32_t baudRate;                      /// current BGx<>bridge UART baud rate
+    iopTrafficProfile_t trafficProfile;     /// current bridge FIFO trigger level profile
+    uint8_t isrSlot;                        /// ISR dispatch slot for this device instance, see IOP_attachIrq()
+
     volatile uint32_t lastTxAt;             /// tick count when TX send started, used for response timeout detection
     volatile uint32_t lastRxAt;             /// tick count when RX buffer fill level was known to have change
 } iop_t;
@@ -331,6 +502,11 @@ typedef struct iop_tag
 /* ATCMD Module Type Definitions
  * ------------------------------------------------------------------------------------------------------------------------------*/
 
+/* Define LTEMC_CMDMIRROR (project wide build flag, changes atcmd_t layout) to keep a copy of the last command sent in 
+ * atcmd->CMDMIRROR. Debug aid for detecting SPI TX overwrite of the command buffer, omit for production builds.
+ */
+//#define LTEMC_CMDMIRROR
+
 /** 
  *  \brief Typed constants for AT-CMD module.
 */
@@ -345,10 +521,117 @@ enum atcmd__constants
     atcmd__cmdBufferSz = 448,                       // prev=120, mqtt(Azure) connect=384, new=512 for universal cmd coverage, data mode to us dynamic TX bffr switching
     atcmd__respBufferSz = 120,
     atcmd__streamPrefixSz = 12,                     // obsolete with universal data mode switch
-    atcmd__dataModeTriggerSz = 13
+    atcmd__dataModeTriggerSz = 13,
+
+    atcmd__queueSz = 6,                             // pipelined command queue slots (queue holds atcmd__queueSz - 1 commands)
+    atcmd__queueCmdSz = 80,                         // max queued command length, longer commands use atcmd_tryInvoke()
+    atcmd__lineBufferSz = 128,                      // line streaming: lines longer are delivered in segments
+    atcmd__batchCmdMax = 12,                        // max commands joined in one batch command line
+    atcmd__batchLineSz = 160,                       // batch command line, 4 TLS settings join in ~115 chars; a full line is sent, batch continues on next
+    atcmd__retryCodesMax = 6,                       // max transient error codes in a retry policy
+
+    atcmd__slotInt = 0x01,                          // command descriptor argument slot: int
+    atcmd__slotStr = 0x02                           // command descriptor argument slot: char*
+};
+
+
+/* Command descriptor argument slots, for compile-time template concatenation. Slots are emitted by the atcmd integer/string
+ * formatter without format parsing or printf. 
+ */
+#define ATCMD_INT "\x01"
+#define ATCMD_STR "\x02"
+
+
+/* Define LTEMC_NO_PRINTF (project wide build flag) to format all AT command templates with the atcmd formatter instead of 
+ * vsnprintf(). Formatter supports the template subset used by LTEmC: %d %u %lu %ld %X %s %c %%, no width/precision.
+ */
+//#define LTEMC_NO_PRINTF
+
+
+/** 
+ *  \brief Precompiled AT command descriptors, high frequency (data path) commands. See atcmd_tryInvokeCmd().
+*/
+typedef enum atcmdCmd_tag
+{
+    atcmdCmd_qird = 0,                              /// AT+QIRD=<cntxt>,<readSz>
+    atcmdCmd_qsslrecv,                              /// AT+QSSLRECV=<cntxt>,<readSz>
+    atcmdCmd_qisend,                                /// AT+QISEND=<cntxt>,<sendSz>
+    atcmdCmd_qmtpub,                                /// AT+QMTPUB=<cntxt>,<msgId>,<qos>,0,"<topic>",<msgSz>
+    atcmdCmd_qhttpread,                             /// AT+QHTTPREAD=<timeoutSec>
+    atcmdCmd_qfread,                                /// AT+QFREAD=<handle>,<readSz>
+    atcmdCmd_qfwrite,                               /// AT+QFWRITE=<handle>,<writeSz>
+    atcmdCmd_qfseek,                                /// AT+QFSEEK=<handle>,<offset>,<seekFrom>
+    atcmdCmd_qfclose,                               /// AT+QFCLOSE=<handle>
+
+    atcmdCmd_cnt
+} atcmdCmd_t;
+
+
+/** 
+ *  \brief AT command verbs with individual metrics, commands not listed are collected as atcmdVerb_other.
+*/
+typedef enum atcmdVerb_tag
+{
+    atcmdVerb_other = 0,
+    atcmdVerb_qiopen,
+    atcmdVerb_qiclose,
+    atcmdVerb_qisend,
+    atcmdVerb_qird,
+    atcmdVerb_qsslopen,
+    atcmdVerb_qsslsend,
+    atcmdVerb_qsslrecv,
+    atcmdVerb_qmtopen,
+    atcmdVerb_qmtconn,
+    atcmdVerb_qmtsub,
+    atcmdVerb_qmtpub,
+    atcmdVerb_qhttpurl,
+    atcmdVerb_qhttpget,
+    atcmdVerb_qhttppost,
+    atcmdVerb_qhttpread,
+
+    atcmdVerb_cnt
+} atcmdVerb_t;
+
+
+/* Metric Type Definitions
+ * ------------------------------------------------------------------------------------------------------------------------------*/
+
+enum metrics__constants
+{
+    metrics__durationBuckets = 16               /// log2 buckets: [0]=0ms, [n]=2^(n-1) to 2^n-1 ms, [15]=16384ms and longer
 };
 
 
+/** 
+ *  \brief Execution metrics for one AT command verb.
+*/
+typedef struct ltemVerbMetrics_tag
+{
+    uint32_t completed;                                 /// commands completed (any result)
+    uint16_t timeouts;                                  /// commands timed out waiting on BGx response
+    uint16_t cmErrors;                                  /// commands completed with BGx ERROR or +CME/+CMS ERROR
+    uint16_t retries;                                   /// commands invoked again following a failure of the same verb (includes retry policy attempts)
+    uint32_t maxDuration;                               /// longest execution in milliseconds
+    uint16_t durationHist[metrics__durationBuckets];    /// execution duration histogram (log2 milliseconds)
+} ltemVerbMetrics_t;
+
+
+/** 
+ *  \brief LTEmC operational metrics, see ltem_getMetrics().
+*/
+typedef struct ltemMetrics_tag
+{
+    uint32_t cmdInvokes;                                /// commands completed successfully
+    ltemVerbMetrics_t verbs[atcmdVerb_cnt];             /// per verb execution metrics
+    atcmdVerb_t lastVerb;                               /// verb of last completed command (retry detection)
+    bool lastFailed;                                    /// last completed command failed (retry detection)
+    uint32_t urcServiced;                               /// URC events serviced by ltem_eventMgr()
+    uint32_t urcDropped;                                /// URC events lost: event queue full, streamed URC consumed with a command response
+    uint32_t urcDelayTotalMS;                           /// URC arrival to service delay, sum (average = urcDelayTotalMS / urcServiced)
+    uint32_t urcDelayMaxMS;                             /// URC arrival to service delay, maximum
+} ltemMetrics_t;
+
+
 /** 
  *  \brief AT command response parser result codes.
 */
@@ -364,12 +647,33 @@ typedef enum cmdParseRslt_tag
     cmdParseRslt_error = 0x80,
 } cmdParseRslt_t;
 
+
+/** 
+ *  \brief BGx final result codes, matched as response chars are received (single pass).
+*/
+typedef enum atcmdFinalRslt_tag
+{
+    atcmdFinalRslt_none = 0,
+    atcmdFinalRslt_sendOk,                              /// "SEND OK\r\n", ordered before OK: longer pattern completing on same char
+    atcmdFinalRslt_ok,                                  /// "OK\r\n"
+    atcmdFinalRslt_cmeError,                            /// "+CME ERROR", ordered before ERROR: longer pattern completing on same char
+    atcmdFinalRslt_cmsError,                            /// "+CMS ERROR"
+    atcmdFinalRslt_error,                               /// "ERROR"
+    atcmdFinalRslt_noCarrier,                           /// "NO CARRIER"
+    atcmdFinalRslt_sendFail,                            /// "SEND FAIL\r\n", BGx send buffer full
+
+    atcmdFinalRslt_cnt,
+    atcmdFinalRslt_firstError = atcmdFinalRslt_cmeError
+} atcmdFinalRslt_t;
+
 typedef struct dataMode_tag
 {
     uint16_t contextKey;                                /// unique identifier for data flow, could be dataContext(proto), handle(files), etc.
     char trigger[atcmd__dataModeTriggerSz];             /// char sequence that signals the transition to data mode, data mode starts at the following character
     dataRxHndlr_func dataHndlr;                         /// data handler function (TX/RX)
     char* txDataLoc;                                    /// location of data buffer (TX only)
+    const char *txPrefixLoc;                            /// optional block sent ahead of TX data, chained without copying (TX only)
+    uint16_t txPrefixSz;                                /// size of TX prefix block, 0 = no prefix
     uint16_t txDataSz;                                  /// size of TX data or RX request
     bool skipParser;                                    /// true = no invoke of response parser after successul datamode, error always skips parser
     appRcvProto_func applRecvDataCB;                    /// callback into app for received data delivery
@@ -377,6 +681,80 @@ typedef struct dataMode_tag
 
 
 typedef cmdParseRslt_t (*cmdResponseParser_func)();                             // AT response parser template
+typedef void (*atcmdCompletion_func)(resultCode_t resultCode, const char *response);  // queued AT command completion callback
+typedef void (*atcmdLineRecv_func)(void *lineCntxt, const char *line, uint16_t lineSz, bool isPartial);    // line streaming callback
+
+
+/** 
+ *  \brief Queued AT command, transmitted by queue servicing as soon as the prior command's final result is received.
+*/
+typedef struct atcmdQueueEntry_tag
+{
+    char cmdStr[atcmd__queueCmdSz];                     /// AT command string, with trailing \r
+    cmdResponseParser_func responseParserFunc;          /// parser function to analyze the command response
+    uint32_t timeout;                                   /// command timeout in milliseconds
+    atcmdCompletion_func completionCB;                  /// optional callback invoked with the command result
+} atcmdQueueEntry_t;
+
+
+/** 
+ *  \brief AT command batch, settings commands joined with ';' and sent as one command line (one round trip).
+*/
+typedef struct atcmdBatch_tag
+{
+    char cmdLine[atcmd__batchLineSz];                   /// joined command line: AT+<cmd>;+<cmd>;... (\r appended at send)
+    uint16_t lineLen;                                   /// chars in cmdLine
+    uint8_t lineCmdCnt;                                 /// commands joined in cmdLine, not yet sent
+    uint8_t lineKeyParams[atcmd__batchCmdMax];          /// per joined command: setting key parameter count (shadowed), 0 if not a shadowed setting
+    uint8_t cmdCnt;                                     /// commands added since atcmd_batchInit()
+    uint32_t timeout;                                   /// timeout per command, a joined line is allowed lineCmdCnt * timeout
+    resultCode_t resultCode;                            /// result code of first failed command, success if none
+    uint8_t failedCmd;                                  /// ordinal (1 = first added) of first failed command, 0 if none
+} atcmdBatch_t;
+
+
+/** 
+ *  \brief Command classes with a retry policy for transient BGx errors, see atcmd_retryInit().
+*/
+typedef enum atcmdRetryClass_tag
+{
+    atcmdRetryClass_none = 0,                           /// no retries
+    atcmdRetryClass_attach,                             /// PDP context activation (CGACT)
+    atcmdRetryClass_scktOpen,                           /// socket open (QIOPEN/QSSLOPEN)
+    atcmdRetryClass_scktSend,                           /// socket send (QISEND)
+    atcmdRetryClass_mqttOpen,                           /// MQTT server open (QMTOPEN)
+
+    atcmdRetryClass_cnt
+} atcmdRetryClass_t;
+
+
+/** 
+ *  \brief Retry policy for a command class. 
+ *  \details Retry codes are matched against the attempt's error code: the +CME/+CMS error number, the command's reported 
+ *           result value (ex: +QIOPEN: 0,565) or the resultCode_t (ex: 408 timeout, 429 SEND FAIL).
+*/
+typedef struct atcmdRetryPolicy_tag
+{
+    uint8_t maxAttempts;                                /// attempts including the first, 1 = no retry
+    uint16_t backoffMS;                                 /// base delay before the first retry, doubled for each following retry
+    uint16_t backoffMaxMS;                              /// cap on the base delay
+    uint32_t deadlineMS;                                /// total time for all attempts, no retry is started that would end its backoff past the deadline
+    uint8_t retryCodesCnt;                              /// count of codes in retryCodes
+    uint16_t retryCodes[atcmd__retryCodesMax];          /// error codes considered transient
+} atcmdRetryPolicy_t;
+
+
+/** 
+ *  \brief Retry state for a command sequence, see atcmd_retryInit() and atcmd_retryAgain().
+*/
+typedef struct atcmdRetry_tag
+{
+    atcmdRetryClass_t retryClass;                       /// command class, selects the retry policy
+    uint8_t attempt;                                    /// attempts completed
+    uint16_t backoffMS;                                 /// base delay for the next retry
+    uint32_t startedAt;                                 /// start of the first attempt (deadline reference)
+    uint16_t lastCode;                                  /// error code of the last attempt, 0 = success
+} atcmdRetry_t;
 
 
 /** 
@@ -386,16 +764,27 @@ typedef struct atcmd_tag
 {
     char cmdStr[atcmd__cmdBufferSz];                    /// AT command string to be passed to the BGx module.
 
-    // temporary                                        /// waiting on fix to SPI TX overright
+    #ifdef LTEMC_CMDMIRROR                              /// debug: waiting on fix to SPI TX overright
     char CMDMIRROR[atcmd__cmdBufferSz];
+    #endif
 
     uint32_t timeout;                                   /// Timout in milliseconds for the command, defaults to 300mS. BGx documentation indicates cmds with longer timeout.
     bool isOpenLocked;                                  /// True if the command is still open, AT commands are single threaded and this blocks a new cmd initiation.
     bool autoLock;                                      /// last invoke was auto and should be closed automatically on complete
     uint32_t invokedAt;                                 /// Tick value at the command invocation, used for timeout detection.
     
-    char rawResponse[atcmd__respBufferSz + 1];          /// response buffer, allows for post cmd execution review of received text (0-filled).
+    char rawResponse[atcmd__respBufferSz + 1];          /// response buffer, allows for post cmd execution review of received text (terminated at rawResponseLen, not 0-filled).
     char* response;                                     /// PTR variable section of response.
+    uint16_t rawResponseLen;                            /// chars in rawResponse, avoids strlen() on each parser pass
+    uint16_t parseIndx;                                 /// rawResponse chars searched by prior parser passes (preamble/finale scan cursor)
+    uint8_t finalMatchLen[atcmdFinalRslt_cnt];          /// final result matcher state: chars matched per pattern, carried across received chunks
+    atcmdFinalRslt_t finalRslt;                         /// final result code matched in response (an error is not superseded)
+    uint16_t finalRsltAt;                               /// rawResponse offset of the matched final result code
+
+    atcmdLineRecv_func lineRecvCB;                      /// line streaming: response lines delivered from rxBffr to callback, not accumulated in rawResponse
+    void *lineCntxt;                                    /// line streaming: callback context (caller's result struct)
+    uint16_t lineScanIndx;                              /// line streaming: rxBffr chars (from tail) already searched for line end
+    bool lineContinues;                                 /// line streaming: last segment delivered was a partial line
 
     uint32_t execDuration;                              /// duration of command's execution in milliseconds
     resultCode_t resultCode;                            /// consumer API result value (HTTP style), success=200, timeout=408, single digit BG errors are expected to be offset by 1000
@@ -410,6 +799,16 @@ typedef struct atcmd_tag
     // appRcvProto_func applDataCB;
 
     dataMode_t dataMode;                                /// controls for automatic data mode servicing - both TX (out) and RX (in). Std functions or extensions supported.
+
+    atcmdQueueEntry_t queue[atcmd__queueSz];            /// pipelined command queue, serviced by ltem_eventMgr() and atcmd_awaitQueue()
+    uint8_t queueHead;                                  /// next queue slot to fill (atcmd_enqueue)
+    uint8_t queueTail;                                  /// next queued command to send
+    bool queueActive;                                   /// a queued command is in flight, queue holds the command lock
+    bool queueServicing;                                /// queue servicing underway (reentrancy guard, eventMgr is called within result processing)
+    resultCode_t queueResult;                           /// first unsuccessful result of the current queue run, success if none
+
+    atcmdRetryPolicy_t retryPolicies[atcmdRetryClass_cnt];  /// retry policy by command class, defaults replaced by atcmd_setRetryPolicy()
+    uint32_t retryJitterSeed;                           /// retry backoff jitter generator state
 } atcmd_t;
 
 
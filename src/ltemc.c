@@ -26,6 +26,7 @@
 
 
 #define SRCFILE "LTE"                               // create SRCFILE (3 char) MACRO for lq-diagnostics ASSERT
+#include <inttypes.h>
 #include "ltemc-internal.h"
 
 #define _DEBUG 2                                    // set to non-zero value for PRINTF debugging output, 
@@ -43,14 +44,18 @@
 #endif
 
 /* ------------------------------------------------------------------------------------------------
- * GLOBAL LTEm Device Objects, One LTEmX supported
+ * GLOBAL LTEm Device Binding, g_lqLTEM (see ltemc-internal.h) resolves to the bound device; up to ltem__deviceMax LTEmX supported
  * --------------------------------------------------------------------------------------------- */
-ltemDevice_t g_lqLTEM;
+ltemTaskBinding_t g_lqLTEMBinding = {0};                    // process-wide binding, used without a task binding callback
+ltemTaskBinding_t g_lqLTEMIsrBinding = {0};                 // device of the interrupt service in progress, overrides binding
+ltemTaskBinding_func g_lqLTEMTaskBindingCB = NULL;          // application thread-local binding slot
 
 
 #define MIN(x, y) (((x) < (y)) ? (x) : (y))
 #define MAX(X, Y) (((X) > (Y)) ? (X) : (Y))
 
+#define URC_PDPDEACT "+QIURC: \"pdpdeact\""              // system URC prefix, forwarded to stream URC handlers
+
 
 /* BGx module initialization commands (start script)
  * ---------------------------------------------------------------------------------------------
@@ -61,7 +66,11 @@ ltemDevice_t g_lqLTEM;
 const char* const qbg_initCmds[] = 
 { 
     "ATE0",                                         // don't echo AT commands on serial
-    "AT+QURCCFG=\"urcport\",\"uart1\""              // URC events are reported to UART1
+    "AT+QURCCFG=\"urcport\",\"uart1\"",             // URC events are reported to UART1
+    "AT+CEREG=1",                                   // LTE registration changes reported as +CEREG: <stat> URC
+    #ifdef LTEMC_HW_FLOWCTRL
+    "AT+IFC=2,2"                                    // RTS/CTS hardware flow control with NXP bridge
+    #endif
 };
 
 // makes for compile time automatic sz determination
@@ -71,60 +80,116 @@ int8_t qbg_initCmdsCnt = sizeof(qbg_initCmds)/sizeof(const char* const);
 /* Static Function Declarations
 ------------------------------------------------------------------------------------------------ */
 void S__initLTEmDevice(bool ltemReset);
+static bool S__probeLink();
+static void S__serviceAsync();
+static void S__serviceUrcQueue();
+static bool S__isLineEndsAhead(uint16_t charCnt);
+static void S__registerUrc(const char *urcPrefix, urcEvntHndlr_func urcHndlr, bool isStream);
+static resultCode_t S__ltemUrcHandler(const urcEvent_t *urcEvent);
+static void S__notifyStreams(const urcEvent_t *urcEvent);
+static ltemShadowEntry_t *S__shadowFind(const char *key, uint16_t keySz);
+static void S__arbiterGrant();
+static void S__arbiterRemove(ltemRequest_t *request);
 
 
 #pragma region Public Functions
 /*-----------------------------------------------------------------------------------------------*/
 
 /**
- *	@brief Initialize the LTEm1 modem.
+ *	@brief Initialize an LTEm modem device instance.
  */
-void ltem_create(const ltemPinConfig_t ltem_config, yield_func yieldCallback, appEvntNotify_func eventNotifCallback)
+ltemHandle_t ltem_create(const ltemPinConfig_t ltem_config, yield_func yieldCallback, appEvntNotify_func eventNotifCallback)
 {
-    ASSERT(g_lqLTEM.atcmd == NULL);                 // prevent multiple calls, memory leak calloc()
+    ltemDevice_t *device = calloc(1, sizeof(ltemDevice_t));
+    ASSERT(device != NULL);
+    ltem_bind(device);                              // device setup below operates on new device
 
-	g_lqLTEM.pinConfig = ltem_config;
-    g_lqLTEM.spi = spi_create(g_lqLTEM.pinConfig.spiCsPin);
+	g_lqLTEM->pinConfig = ltem_config;
+    g_lqLTEM->spi = spi_create(g_lqLTEM->pinConfig.spiCsPin);
 
-    g_lqLTEM.modemSettings =  calloc(1, sizeof(modemSettings_t));
-    ASSERT(g_lqLTEM.modemSettings != NULL);
+    g_lqLTEM->modemSettings =  calloc(1, sizeof(modemSettings_t));
+    ASSERT(g_lqLTEM->modemSettings != NULL);
 
-    g_lqLTEM.modemInfo = calloc(1, sizeof(modemInfo_t));
-    ASSERT(g_lqLTEM.modemInfo != NULL);
+    g_lqLTEM->modemInfo = calloc(1, sizeof(modemInfo_t));
+    ASSERT(g_lqLTEM->modemInfo != NULL);
 
     IOP_create();
     
-    g_lqLTEM.atcmd = calloc(1, sizeof(atcmd_t));
-    ASSERT(g_lqLTEM.atcmd != NULL);
-    atcmd_reset(true);
+    ATCMD_create();
 
-    g_lqLTEM.fileCtrl = calloc(1, sizeof(fileCtrl_t));
-    ASSERT(g_lqLTEM.fileCtrl != NULL);
+    g_lqLTEM->fileCtrl = calloc(1, sizeof(fileCtrl_t));
+    ASSERT(g_lqLTEM->fileCtrl != NULL);
 
     ntwk_create();
 
-    g_lqLTEM.cancellationRequest = false;
-    g_lqLTEM.appEvntNotifyCB = eventNotifCallback;
+    ltem_registerUrc("+CEREG:", S__ltemUrcHandler);                                 // system URCs: network state kept current by ltem_eventMgr()
+    ltem_registerUrc("+CGREG:", S__ltemUrcHandler);
+    ltem_registerUrc(URC_PDPDEACT, S__ltemUrcHandler);
+    ltem_registerUrc("+QIND:", S__ltemUrcHandler);
+    ltem_registerUrc("+CPIN:", S__ltemUrcHandler);
+    ltem_registerUrc("APP RDY", S__ltemUrcHandler);
+
+    g_lqLTEM->cancellationRequest = false;
+    g_lqLTEM->appEvntNotifyCB = eventNotifCallback;
+    return device;
 }
 
 
+/**
+ *	@brief Bind an LTEm device instance, subsequent LTEmC calls operate on this device.
+ */
+ltemHandle_t ltem_bind(ltemHandle_t device)
+{
+    ltemDevice_t *prevDevice = g_lqLTEM;
+    g_lqLTEM = device;
+    return prevDevice;
+}
+
 
 /**
- *	@brief Uninitialize the LTEm device structures.
+ *	@brief Get the currently bound LTEm device instance.
  */
-void ltem_destroy()
+ltemHandle_t ltem_getBound()
 {
-	ltem_stop(false);
+    return g_lqLTEM;
+}
 
-	gpio_pinClose(g_lqLTEM.pinConfig.irqPin);
-	gpio_pinClose(g_lqLTEM.pinConfig.powerkeyPin);
-	gpio_pinClose(g_lqLTEM.pinConfig.resetPin);
-	gpio_pinClose(g_lqLTEM.pinConfig.statusPin);
 
-    ip_destroy();
-    free(g_lqLTEM.atcmd);
-    iop_destroy();
-    spi_destroy(g_lqLTEM.spi);
+/**
+ *	@brief Registers the application task binding callback, ltem_bind() then binds a device for the calling task only.
+ */
+void ltem_setTaskBindingCallback(ltemTaskBinding_func bindingCB)
+{
+    ltemTaskBinding_t binding = *LTEM_binding();
+    g_lqLTEMTaskBindingCB = bindingCB;
+    if (bindingCB != NULL && g_lqLTEM == NULL)
+        *LTEM_binding() = binding;                  // registering task keeps its binding
+}
+
+
+
+/**
+ *	@brief Uninitialize the bound LTEm device structures and release the device instance.
+ */
+void ltem_destroy()
+{
+	ltem_stop();
+    IOP_destroy();                                  // IRQ detached and ISR slot released before device memory
+
+	platform_closePin(g_lqLTEM->pinConfig.irqPin);
+	platform_closePin(g_lqLTEM->pinConfig.powerkeyPin);
+	platform_closePin(g_lqLTEM->pinConfig.resetPin);
+	platform_closePin(g_lqLTEM->pinConfig.statusPin);
+
+    free(g_lqLTEM->providerInfo);
+    free(g_lqLTEM->fileCtrl);
+    free(g_lqLTEM->atcmd);
+    free(g_lqLTEM->modemInfo);
+    free(g_lqLTEM->modemSettings);
+    spi_destroy(g_lqLTEM->spi);
+
+    free(g_lqLTEM);
+    g_lqLTEM = NULL;                                // caller binds another device to continue
 }
 
 
@@ -138,11 +203,10 @@ void ltem_setProviderScanSeq(const char* scanSequence)
     */
     if (strlen(scanSequence) > 0)
     {
-        strcpy(g_lqLTEM.modemSettings->scanSequence, scanSequence);
+        strcpy(g_lqLTEM->modemSettings->scanSequence, scanSequence);
         if (ltem_getDeviceState() == deviceState_appReady)
         {
-            atcmd_tryInvoke("AT+QCFG=\"nwscanseq\",%s", scanSequence);
-            atcmd_awaitResult();
+            atcmd_applySetting(1, "AT+QCFG=\"nwscanseq\",%s", scanSequence);
         }
     }
 }
@@ -155,11 +219,10 @@ void ltem_setProviderScanMode(ntwkScanMode_t scanMode)
 {
     /* AT+QCFG="nwscanmode"[,<scanmode>[,<effect>]]
     */
-    g_lqLTEM.modemSettings->scanMode = scanMode; 
+    g_lqLTEM->modemSettings->scanMode = scanMode; 
     if (ltem_getDeviceState() == deviceState_appReady)
     {
-        atcmd_tryInvoke("AT+QCFG=\"nwscanmode\",%d", scanMode);
-        atcmd_awaitResult();
+        atcmd_applySetting(1, "AT+QCFG=\"nwscanmode\",%d", scanMode);
     }
 }
 
@@ -171,15 +234,60 @@ void ltem_setIotMode(ntwkIotMode_t iotMode)
 {
     /* AT+QCFG="iotopmode",<mode>
     */
-    g_lqLTEM.modemSettings->iotMode = iotMode; 
+    g_lqLTEM->modemSettings->iotMode = iotMode; 
     if (ltem_getDeviceState() == deviceState_appReady)
     {
-        atcmd_tryInvoke("AT+QCFG=\"iotopmode\",%d", iotMode);
-        atcmd_awaitResult();
+        atcmd_applySetting(1, "AT+QCFG=\"iotopmode\",%d", iotMode);
     }
 }
 
 
+/**
+ *	\brief Change the BGx<>bridge UART baud rate.
+ */
+resultCode_t ltem_setBaudRate(uint32_t baudRate)
+{
+    uint32_t priorRate = g_lqLTEM->iop->baudRate;
+
+    if (baudRate == 0 || baudRate > SC16IS7xx__baudRateMax || SC16IS7xx__XTAL_frequency % (16 * baudRate) != 0)
+        return resultCode__badRequest;
+    if (baudRate == priorRate)
+    {
+        g_lqLTEM->modemSettings->baudRate = baudRate;
+        return resultCode__success;
+    }
+
+    /* AT+IPR=<rate> : OK is returned at the current rate, then BGx switches
+    */
+    if (!atcmd_tryInvoke("AT+IPR=%" PRIu32, baudRate))
+        return resultCode__conflict;
+    resultCode_t rslt = atcmd_awaitResult();
+    if (rslt != resultCode__success)
+        return rslt;                                                    // BGx rejected rate, link unchanged
+
+    pDelay(IOP_getFifoFillPeriod());                                    // allow BGx to complete switch
+    IOP_setBaudRate(baudRate);
+    if (S__probeLink())
+    {
+        g_lqLTEM->modemSettings->baudRate = baudRate;
+        PRINTF(dbgColor__info, "Baud=%" PRIu32 "\r", baudRate);
+        return resultCode__success;
+    }
+
+    /* no link at new rate: BGx may have switched with the link failing at that rate, request the prior rate at the new
+     * rate (response not expected to be readable) before reverting the bridge
+     */
+    if (atcmd_tryInvoke("AT+IPR=%" PRIu32, priorRate))
+        atcmd_awaitResultWithOptions(IOP__baudProbeTimeout, NULL);
+    pDelay(IOP_getFifoFillPeriod());
+
+    IOP_setBaudRate(priorRate);                                         // fallback, BGx may not have switched
+    if (S__probeLink())
+        return resultCode__unavailable;
+    return resultCode__internalError;
+}
+
+
 /**
  *	\brief Build default data context configuration for modem to use on startup.
  */
@@ -195,18 +303,18 @@ void ltem_setDefaultNetwork(uint8_t pdpContextId, const char *protoType, const c
 void ltem_start(resetAction_t resetAction)
 {
   	// on Arduino compatible, ensure pin is in default "logical" state prior to opening
-	platform_writePin(g_lqLTEM.pinConfig.powerkeyPin, gpioValue_low);
-	platform_writePin(g_lqLTEM.pinConfig.resetPin, gpioValue_low);
-	platform_writePin(g_lqLTEM.pinConfig.spiCsPin, gpioValue_high);
-	platform_writePin(g_lqLTEM.pinConfig.irqPin, gpioValue_high);
+	platform_writePin(g_lqLTEM->pinConfig.powerkeyPin, gpioValue_low);
+	platform_writePin(g_lqLTEM->pinConfig.resetPin, gpioValue_low);
+	platform_writePin(g_lqLTEM->pinConfig.spiCsPin, gpioValue_high);
+	platform_writePin(g_lqLTEM->pinConfig.irqPin, gpioValue_high);
 
-	platform_openPin(g_lqLTEM.pinConfig.powerkeyPin, gpioMode_output);		// powerKey: normal low
-	platform_openPin(g_lqLTEM.pinConfig.resetPin, gpioMode_output);			// resetPin: normal low
-	platform_openPin(g_lqLTEM.pinConfig.spiCsPin, gpioMode_output);			// spiCsPin: invert, normal gpioValue_high
-	platform_openPin(g_lqLTEM.pinConfig.statusPin, gpioMode_input);
-	platform_openPin(g_lqLTEM.pinConfig.irqPin, gpioMode_inputPullUp);
+	platform_openPin(g_lqLTEM->pinConfig.powerkeyPin, gpioMode_output);		// powerKey: normal low
+	platform_openPin(g_lqLTEM->pinConfig.resetPin, gpioMode_output);			// resetPin: normal low
+	platform_openPin(g_lqLTEM->pinConfig.spiCsPin, gpioMode_output);			// spiCsPin: invert, normal gpioValue_high
+	platform_openPin(g_lqLTEM->pinConfig.statusPin, gpioMode_input);
+	platform_openPin(g_lqLTEM->pinConfig.irqPin, gpioMode_inputPullUp);
 
-    spi_start(g_lqLTEM.spi);                                                // start host SPI
+    spi_start(g_lqLTEM->spi);                                                // start host SPI
 
     bool ltemReset = true;
     if (QBG_isPowerOn())
@@ -240,7 +348,10 @@ void S__initLTEmDevice(bool ltemReset)
     ASSERT(QBG_isPowerOn());
     ASSERT(SC16IS7xx_isAvailable());
 
+    LTEM_shadowInvalidate();                                // BGx settings are back to defaults (or unknown), force writes
+
     SC16IS7xx_start();                                      // initialize NXP SPI-UART bridge base functions: FIFO, levels, baud, framing
+    g_lqLTEM->iop->baudRate = IOP__uartBaudRate;
 
     if (ltemReset)
     {
@@ -250,23 +361,25 @@ void S__initLTEmDevice(bool ltemReset)
         }
         else
         {
-            if (g_lqLTEM.deviceState == deviceState_powerOn)
+            if (g_lqLTEM->deviceState == deviceState_powerOn)
             {
                 PRINTF(dbgColor__warn, "AppRdy timeout\r");
-                g_lqLTEM.deviceState = deviceState_appReady;        // missed it somehow
+                g_lqLTEM->deviceState = deviceState_appReady;        // missed it somehow
             }
 
         }
     }
     else
     {
-        g_lqLTEM.deviceState = deviceState_appReady;        // assume device state = appReady, APP RDY sent in 1st ~10 seconds of BGx running
+        g_lqLTEM->deviceState = deviceState_appReady;        // assume device state = appReady, APP RDY sent in 1st ~10 seconds of BGx running
         PRINTF(dbgColor__info, "LTEm ON (AppRdy)\r");
     }
 
     IOP_attachIrq();                                        // attach I/O processor ISR to IRQ
     SC16IS7xx_enableIrqMode();                              // enable IRQ generation on SPI-UART bridge (IRQ mode)
     QBG_setOptions();                                       // initialize BGx operating settings
+    if (g_lqLTEM->modemSettings->baudRate != 0 && g_lqLTEM->modemSettings->baudRate != IOP__uartBaudRate)
+        ltem_setBaudRate(g_lqLTEM->modemSettings->baudRate);   // BGx reverts to default rate on reset, reapply requested rate
     NTWK_initRatOptions();                                  // initialize BGx Radio Access Technology (RAT) options
     NTWK_applyDefaulNetwork();                              // configures default PDP context for likely autostart with provider attach
     ntwk_awaitProvider(2);                                  // attempt to warm-up provider/PDP briefly. If longer duration required, leave that to application
@@ -278,10 +391,11 @@ void S__initLTEmDevice(bool ltemReset)
  */
 void ltem_stop()
 {
-    spi_stop(g_lqLTEM.spi);
-    IOP_stopIrq();
-    g_lqLTEM.deviceState = deviceState_powerOff;
+    spi_stop(g_lqLTEM->spi);
+    IOP_detachIrq();
+    g_lqLTEM->deviceState = deviceState_powerOff;
     QBG_powerOff();
+    LTEM_shadowInvalidate();
 }
 
 
@@ -310,11 +424,11 @@ const char *ltem_getSwVersion()
 deviceState_t ltem_getDeviceState()
 {
     if (QBG_isPowerOn())             // ensure powered off device doesn't report otherwise
-        g_lqLTEM.deviceState = MAX(g_lqLTEM.deviceState, deviceState_powerOn); 
+        g_lqLTEM->deviceState = MAX(g_lqLTEM->deviceState, deviceState_powerOn); 
     else
-        g_lqLTEM.deviceState = deviceState_powerOff;
+        g_lqLTEM->deviceState = deviceState_powerOff;
 
-    return g_lqLTEM.deviceState;
+    return g_lqLTEM->deviceState;
 }
 
 
@@ -323,29 +437,72 @@ deviceState_t ltem_getDeviceState()
  */
 void ltem_eventMgr()
 {
-    /* look for a new incoming URC 
-     */
-    int16_t urcPossible = cbffr_find(g_lqLTEM.iop->rxBffr, "+", 0, 0, false);       // look for prefix char in URC
-    if (CBFFR_NOTFOUND(urcPossible))
+    IOP_resumeRxFlow();                                                             // if RX flow halted and consumers have made room, restart
+
+    ATCMD_serviceQueue();                                                           // complete in-flight queued command, send next
+    S__serviceAsync();                                                              // advance async operation (sckt_openAsync(), etc.)
+
+    if (g_lqLTEM->iop->rxFaultNotifyPending)                                         // ISR dropped RX chars, report outside of ISR context
     {
-        return;
+        g_lqLTEM->iop->rxFaultNotifyPending = false;
+        char faultMsg[80];
+        snprintf(faultMsg, sizeof(faultMsg), "RX dropped=%" PRIu32 " (overflows=%d, lineErrs=%d)", 
+                 g_lqLTEM->iop->rxDroppedCnt, g_lqLTEM->iop->rxOverflowCnt, g_lqLTEM->iop->rxLineErrorCnt);
+        ltem_notifyApp(appEvent_fault_softFault, faultMsg);
     }
 
-    for (size_t i = 0; i < ltem__streamCnt; i++)                                    // potential URC in rxBffr, see if a data handler will service
+    /* service URC events queued by the RX ISR, deferred while a command is underway (eventMgr is called within awaits)
+     */
+    if (!g_lqLTEM->atcmd->isOpenLocked)
     {
-        resultCode_t serviceRslt;
-        if (g_lqLTEM.streams[i] != NULL &&  g_lqLTEM.streams[i]->urcHndlr != NULL)  // URC event handler in this stream, offer the data to the handler
-        {
-            serviceRslt = g_lqLTEM.streams[i]->urcHndlr();
-        }
-        if (serviceRslt == resultCode__cancelled)                                   // not serviced, continue looking
-        {
-            continue;
-        }
-        break;                                                                      // service attempted (might have errored), so this event is over
+        S__serviceUrcQueue();
     }
+}
 
-    // S__ltemUrcHandler();                                                            // always invoke system level URC validation/service
+
+/**
+ *	@brief Copy a snapshot of the LTEmC operational metrics.
+ */
+void ltem_getMetrics(ltemMetrics_t *metrics)
+{
+    ASSERT(metrics != NULL);
+    memcpy(metrics, &g_lqLTEM->metrics, sizeof(ltemMetrics_t));
+}
+
+
+/**
+ *	@brief Clear the LTEmC operational metrics.
+ */
+void ltem_resetMetrics()
+{
+    memset(&g_lqLTEM->metrics, 0, sizeof(ltemMetrics_t));
+}
+
+
+/**
+ *	@brief Returns true if an async operation is underway.
+ */
+bool ltem_isAsyncPending()
+{
+    return g_lqLTEM->asyncOp.stepFunc != NULL;
+}
+
+
+/**
+ *	@brief Register a URC handler for a URC prefix, URC lines are queued as received and serviced by ltem_eventMgr().
+ */
+void ltem_registerUrc(const char *urcPrefix, urcEvntHndlr_func urcHndlr)
+{
+    S__registerUrc(urcPrefix, urcHndlr, false);
+}
+
+
+/**
+ *	@brief Register a URC handler for a URC prefix, handler streams the URC content from the RX buffer.
+ */
+void ltem_registerUrcStream(const char *urcPrefix, urcEvntHndlr_func urcHndlr)
+{
+    S__registerUrc(urcPrefix, urcHndlr, true);
 }
 
 
@@ -355,9 +512,9 @@ void ltem_addStream(streamCtrl_t *streamCtrl)
 
     for (size_t i = 0; i < ltem__streamCnt; i++)
     {
-        if (g_lqLTEM.streams[i] == NULL)
+        if (g_lqLTEM->streams[i] == NULL)
         {
-            g_lqLTEM.streams[i] = streamCtrl;
+            g_lqLTEM->streams[i] = streamCtrl;
             return;
         }
     }
@@ -368,10 +525,10 @@ void ltem_deleteStream(streamCtrl_t *streamCtrl)
 {
     for (size_t i = 0; i < ltem__streamCnt; i++)
     {
-        if (g_lqLTEM.streams[i]->dataCntxt == streamCtrl->dataCntxt)
+        if (g_lqLTEM->streams[i] != NULL && g_lqLTEM->streams[i]->dataCntxt == streamCtrl->dataCntxt)
         {
-            ASSERT(memcmp(g_lqLTEM.streams[i], streamCtrl, sizeof(streamCtrl_t)) == 0);     // compare the common fields
-            g_lqLTEM.streams[i] = NULL;
+            ASSERT(memcmp(g_lqLTEM->streams[i], streamCtrl, sizeof(streamCtrl_t)) == 0);     // compare the common fields
+            g_lqLTEM->streams[i] = NULL;
             return;
         }
     }
@@ -382,23 +539,23 @@ streamCtrl_t* ltem_getStreamFromCntxt(uint8_t context, streamType_t streamType)
 {
     for (size_t i = 0; i < ltem__streamCnt; i++)
     {
-        if (g_lqLTEM.streams[i]->dataCntxt == context)
+        if (g_lqLTEM->streams[i] != NULL && g_lqLTEM->streams[i]->dataCntxt == context)
         {
             if (streamType == streamType__ANY)
             {
-                return g_lqLTEM.streams[i];
+                return g_lqLTEM->streams[i];
             }
-            else if (g_lqLTEM.streams[i]->streamType == streamType)
+            else if (g_lqLTEM->streams[i]->streamType == streamType)
             {
-                return g_lqLTEM.streams[i];
+                return g_lqLTEM->streams[i];
             }
             else if (streamType == streamType__SCKT)
             {
-                if (g_lqLTEM.streams[i]->streamType == streamType_UDP ||
-                    g_lqLTEM.streams[i]->streamType == streamType_TCP ||
-                    g_lqLTEM.streams[i]->streamType == streamType_SSLTLS)
+                if (g_lqLTEM->streams[i]->streamType == streamType_UDP ||
+                    g_lqLTEM->streams[i]->streamType == streamType_TCP ||
+                    g_lqLTEM->streams[i]->streamType == streamType_SSLTLS)
                 {
-                    return g_lqLTEM.streams[i];
+                    return g_lqLTEM->streams[i];
                 }
             }
         }
@@ -411,8 +568,8 @@ streamCtrl_t* ltem_getStreamFromCntxt(uint8_t context, streamType_t streamType)
  */
 void ltem_notifyApp(uint8_t notifyType, const char *notifyMsg)
 {
-    if (g_lqLTEM.appEvntNotifyCB != NULL)                                       
-        (g_lqLTEM.appEvntNotifyCB)(notifyType, notifyMsg);                                // if app handler registered, it may/may not return
+    if (g_lqLTEM->appEvntNotifyCB != NULL)                                       
+        (g_lqLTEM->appEvntNotifyCB)(notifyType, notifyMsg);                                // if app handler registered, it may/may not return
 }
 
 
@@ -421,9 +578,120 @@ void ltem_notifyApp(uint8_t notifyType, const char *notifyMsg)
  */
 void ltem_setEventNotifCallback(appEvntNotify_func eventNotifCallback)
 {
-    g_lqLTEM.appEvntNotifyCB = eventNotifCallback;
+    g_lqLTEM->appEvntNotifyCB = eventNotifCallback;
+}
+
+/**
+ *	@brief Registers the application critical section handler, required for multi-task use of LTEmC.
+ */
+void ltem_setCriticalCallback(ltemCritical_func criticalCB)
+{
+    g_lqLTEM->criticalCB = criticalCB;
+}
+
+
+/**
+ *	@brief Acquire modem access for a task's sequence of LTEmC calls, waiting on higher priority and earlier requests.
+ */
+bool ltem_acquire(ltemRequest_t *request, ltemPriority_t priority, uint32_t timeoutMS)
+{
+    request->priority = priority;
+    request->cancel = false;
+    request->granted = false;
+
+    LTEM_critical(true);
+    uint8_t slot = 0;
+    while (slot < ltem__arbiterSlots && g_lqLTEM->arbiter.waiting[slot] != NULL)
+        slot++;
+    if (slot == ltem__arbiterSlots)                                             // no waiting slot
+    {
+        LTEM_critical(false);
+        return false;
+    }
+    request->arrival = g_lqLTEM->arbiter.arrivals++;
+    g_lqLTEM->arbiter.waiting[slot] = request;
+    S__arbiterGrant();
+    LTEM_critical(false);
+
+    uint32_t waitStart = pMillis();
+    while (!request->granted)
+    {
+        if (request->cancel || pMillis() - waitStart >= timeoutMS)
+        {
+            LTEM_critical(true);
+            if (request->granted)                                               // granted while giving up, pass access on
+            {
+                request->granted = false;
+                g_lqLTEM->arbiter.owner = NULL;
+            }
+            S__arbiterRemove(request);
+            S__arbiterGrant();
+            LTEM_critical(false);
+            return false;
+        }
+        uint32_t waited = pMillis() - waitStart;
+        if (g_lqLTEM->requestWaitCB != NULL)
+            g_lqLTEM->requestWaitCB(request, (waited < timeoutMS) ? timeoutMS - waited : 1);    // block until granted, cancelled or timeout
+        else
+            pYield();
+    }
+    LTEM_binding()->request = request;                                         // task's calls now pass LTEM_isAccessOwner()
+    return true;
+}
+
+
+/**
+ *	@brief Release modem access, granting access to the highest priority waiting request.
+ */
+void ltem_release(ltemRequest_t *request)
+{
+    LTEM_critical(true);
+    if (g_lqLTEM->arbiter.owner == request)
+    {
+        request->granted = false;
+        g_lqLTEM->arbiter.owner = NULL;
+        S__arbiterGrant();
+    }
+    LTEM_critical(false);
+    if (LTEM_binding()->request == request)
+        LTEM_binding()->request = NULL;
+}
+
+
+/**
+ *	@brief Request cancellation of a waiting request or the in-flight command of the request holding modem access.
+ */
+void ltem_cancel(ltemRequest_t *request)
+{
+    LTEM_critical(true);
+    request->cancel = true;
+    if (g_lqLTEM->requestSignalCB != NULL)                                      // wake request if waiting in ltem_acquire()
+        g_lqLTEM->requestSignalCB(request);
+    LTEM_critical(false);
 }
 
+
+/**
+ *	@brief Registers application wait/signal handlers, LTEmC waits for BGx responses sleep until RX (ISR signal) or timeout.
+ */
+void ltem_setWaitCallbacks(ltemWait_func waitCB, ltemSignal_func signalCB)
+{
+    g_lqLTEM->signalCB = signalCB;
+    g_lqLTEM->waitCB = waitCB;
+}
+
+
+/**
+ *	@brief Registers application request wait/signal handlers, ltem_acquire() waiters block until granted or cancelled.
+ */
+void ltem_setRequestWaitCallbacks(ltemRequestWait_func waitCB, ltemRequestSignal_func signalCB)
+{
+    ASSERT(waitCB == NULL || signalCB != NULL);                                 // a blocking wait requires a wake
+    g_lqLTEM->requestSignalCB = signalCB;
+    g_lqLTEM->requestWaitCB = waitCB;
+}
+
+
 /**
  *	@brief Registers the address (void*) of your application yield callback handler.
  */
@@ -439,19 +707,135 @@ void ltem_setYieldCallback(platform_yieldCB_func_t yieldCallback)
 #pragma region LTEmC Internal Functions (ltemc-internal.h)
 /*-----------------------------------------------------------------------------------------------*/
 
+/**
+ *	@brief Starts an async operation, stepped by ltem_eventMgr() until the step function returns a final result.
+ */
+ltemAsyncOp_t *LTEM_startAsync(ltemAsyncStep_func stepFunc, void *ctrl, ltemAsyncComplete_func completeCB)
+{
+    ASSERT(g_lqLTEM->asyncOp.stepFunc == NULL);                                      // one async operation at a time (atcmd is single threaded)
+
+    memset(&g_lqLTEM->asyncOp, 0, sizeof(ltemAsyncOp_t));
+    g_lqLTEM->asyncOp.stepFunc = stepFunc;
+    g_lqLTEM->asyncOp.ctrl = ctrl;
+    g_lqLTEM->asyncOp.completeCB = completeCB;
+    return &g_lqLTEM->asyncOp;
+}
+
+
+/**
+ *	@brief Completes the async operation, clearing it prior to callback so the application can start another.
+ */
+void LTEM_completeAsync(resultCode_t resultCode)
+{
+    void *ctrl = g_lqLTEM->asyncOp.ctrl;
+    ltemAsyncComplete_func completeCB = g_lqLTEM->asyncOp.completeCB;
+
+    memset(&g_lqLTEM->asyncOp, 0, sizeof(ltemAsyncOp_t));
+    if (completeCB != NULL)
+        completeCB(ctrl, resultCode);
+}
+
+
+/**
+ *	@brief Enter/exit the application critical section.
+ */
+void LTEM_critical(bool enter)
+{
+    if (g_lqLTEM->criticalCB != NULL)
+        g_lqLTEM->criticalCB(enter);
+}
+
+
+/**
+ *	@brief Returns true if cancellation is requested globally or by the request holding modem access.
+ */
+bool LTEM_isCancelled()
+{
+    ltemRequest_t *owner = g_lqLTEM->arbiter.owner;
+    return g_lqLTEM->cancellationRequest || (owner != NULL && owner->cancel);
+}
+
+
+/**
+ *	@brief Returns true if no request holds modem access or the calling task's request (its binding) holds it.
+ */
+bool LTEM_isAccessOwner()
+{
+    ltemRequest_t *owner = g_lqLTEM->arbiter.owner;
+    return owner == NULL || owner == LTEM_binding()->request;
+}
+
+
+/**
+ *	@brief Returns true if the modem setting (key) was last applied with value.
+ */
+bool LTEM_shadowIsCurrent(const char *key, uint16_t keySz, const char *value, uint16_t valueSz)
+{
+    ltemShadowEntry_t *entry = S__shadowFind(key, keySz);
+    return entry != NULL && 
+           entry->valueSz == valueSz && 
+           memcmp(entry->text + keySz, value, valueSz) == 0;
+}
+
+
+/**
+ *	@brief Record the value applied to a modem setting (key), NULL value removes the setting.
+ */
+void LTEM_shadowUpdate(const char *key, uint16_t keySz, const char *value, uint16_t valueSz)
+{
+    ltemShadowEntry_t *entry = S__shadowFind(key, keySz);
+
+    if (value == NULL || keySz == 0 || keySz + valueSz > ltem__shadowTextSz)     // removed or too long to shadow, next apply writes
+    {
+        if (entry != NULL)
+            entry->keySz = 0;
+        return;
+    }
+    if (entry == NULL)
+    {
+        for (uint8_t i = 0; i < ltem__shadowSz; i++)
+        {
+            if (g_lqLTEM->shadow.entries[i].keySz == 0)
+            {
+                entry = &g_lqLTEM->shadow.entries[i];                           // first unused
+                break;
+            }
+        }
+    }
+    if (entry == NULL)                                                          // full, replace round-robin
+    {
+        entry = &g_lqLTEM->shadow.entries[g_lqLTEM->shadow.nextEvict];
+        g_lqLTEM->shadow.nextEvict = (g_lqLTEM->shadow.nextEvict + 1) % ltem__shadowSz;
+    }
+    memcpy(entry->text, key, keySz);
+    memcpy(entry->text + keySz, value, valueSz);
+    entry->keySz = keySz;
+    entry->valueSz = valueSz;
+}
+
+
+/**
+ *	@brief Clears all shadowed modem settings.
+ */
+void LTEM_shadowInvalidate()
+{
+    memset(&g_lqLTEM->shadow, 0, sizeof(ltemShadow_t));
+}
+
+
 // void LTEM_registerUrcHandler(urcHandler_func *urcHandler)
 // {
 //     bool registered = false;
 //     for (size_t i = 0; i < ltem__urcHandlersCnt; i++)
 //     {
-//         if (g_lqLTEM.urcHandlers[i] == NULL)
+//         if (g_lqLTEM->urcHandlers[i] == NULL)
 //         {
 //             registered = true;
-//             g_lqLTEM.urcHandlers[i] = urcHandler;                               // add to "registered" handlers
+//             g_lqLTEM->urcHandlers[i] = urcHandler;                               // add to "registered" handlers
 //         }
 //         else
 //         {
-//             if (g_lqLTEM.urcHandlers[i] == urcHandler)                          // previously registered
+//             if (g_lqLTEM->urcHandlers[i] == urcHandler)                          // previously registered
 //                 registered = true;
 //         }
 //         ASSERT(registered);
@@ -462,7 +846,7 @@ void ltem_setYieldCallback(platform_yieldCB_func_t yieldCallback)
 // {
 //     for (size_t indx = 0; indx < ltem__streamCnt; indx++)
 //     {
-//         if (g_lqLTEM.streams[indx]->dataContext == dataCntxt)
+//         if (g_lqLTEM->streams[indx]->dataContext == dataCntxt)
 //         {
 //             return indx;
 //         }
@@ -476,34 +860,328 @@ void ltem_setYieldCallback(platform_yieldCB_func_t yieldCallback)
 
 /**
  * @brief Global URC handler
- * @details Services URC events that are not specific to a stream/protocol
+ * @details Services URC events that are not specific to a stream/protocol: keeps provider/network state current and
+ * notifies streams of packet network loss.
  */
-S__ltemUrcHandler()                                                     
+static resultCode_t S__ltemUrcHandler(const urcEvent_t *urcEvent)
 {
-    cbuffer_t *rxBffr = g_lqLTEM.iop->rxBffr;                           // for convenience
-    char parseBffr[30];
-
-    // bool isQuectel = cbffr_find(rxBffr, "+Q", 0, 0, false) != CBFFR_NOFIND;
-    // bool isCCITT = cbffr_find(rxBffr, "+C", 0, 0, false) != CBFFR_NOFIND;
-
     /* LTEm System URCs Handled Here
      *
-     * +QIURC: "pdpdeact",<contextID>
+     * +CEREG: <stat>                   LTE registration (AT+CEREG=1), AT+CEREG? response is +CEREG: <n>,<stat>
+     * +CGREG: <stat>                   GSM/GPRS registration (AT+CGREG=1 set by application)
+     * +QIURC: "pdpdeact",<contextID>   network pdp context timed out and deactivated
+     * +QIND: "act","<actMode>"         access technology changed (AT+QINDCFG="act",1 set by application), other +QIND ignored
+     * +CPIN: <code>                    SIM state, other than READY the SIM is unavailable (ex: NOT READY)
+     * APP RDY                          BGx firmware (re)started, settings are back to defaults
     */
 
+    /* Network registration
+     ------------------------------------------------------------------------------------------- */
+    if (strcmp(urcEvent->prefix, "+CEREG:") == 0 || strcmp(urcEvent->prefix, "+CGREG:") == 0)
+    {
+        NTWK_regStatusReport(urcEvent->line);
+    }
+
     /* PDP (packet network) deactivation/close
      ------------------------------------------------------------------------------------------- */
-    // if (cbffr_find(rxBffr, "+QIURC: \"pdpdeact\"", 0, 0, true) >= 0)
-    // {
-    //     for (size_t i = 0; i < dataCntxt__cnt; i++)
-    //     {
-    //         if (g_lqLTEM.streams[i].dataCloseCB)
-    //         {
-    //             g_lqLTEM.streams[i].dataCloseCB(i);
-    //         }
-    //     }
-    // }
- 
+    else if (strcmp(urcEvent->prefix, URC_PDPDEACT) == 0)
+    {
+        uint8_t pdpContextId = strtol(urcEvent->line + strlen(urcEvent->prefix) + 1, NULL, 10);    // prefix followed by ,<contextID>
+        PRINTF(dbgColor__warn, "PDP context %d deactivated\r", pdpContextId);
+
+        NTWK_setNetworkInactive(pdpContextId);
+        S__notifyStreams(urcEvent);
+    }
+
+    /* Access technology change
+     ------------------------------------------------------------------------------------------- */
+    else if (strcmp(urcEvent->prefix, "+QIND:") == 0)
+    {
+        const char *actMode = strstr(urcEvent->line, "\"act\",\"");
+        if (actMode != NULL)
+        {
+            actMode += sizeof("\"act\",\"") - 1;
+            if (strncmp(actMode, "CAT-M", 5) == 0)                                  // same iotMode names as ntwk_awaitProvider()
+                strcpy(g_lqLTEM->providerInfo->iotMode, "M1");
+            else if (strncmp(actMode, "CAT-NB", 6) == 0)
+                strcpy(g_lqLTEM->providerInfo->iotMode, "NB1");
+            else if (strncmp(actMode, "GSM", 3) == 0)
+                strcpy(g_lqLTEM->providerInfo->iotMode, "GSM");
+        }
+    }
+
+    /* BGx restarted outside of driver control (ex: BGx watchdog), shadowed settings no longer in effect
+     ------------------------------------------------------------------------------------------- */
+    else if (strcmp(urcEvent->prefix, "APP RDY") == 0)
+    {
+        PRINTF(dbgColor__warn, "BGx restarted (APP RDY)\r");
+        LTEM_shadowInvalidate();
+        g_lqLTEM->deviceState = deviceState_appReady;
+    }
+
+    /* SIM state, SIM unavailable drops provider and all PDP contexts
+     ------------------------------------------------------------------------------------------- */
+    else
+    {
+        if (strcmp(urcEvent->line + sizeof("+CPIN: ") - 1, "READY") != 0)
+        {
+            PRINTF(dbgColor__warn, "SIM unavailable: %s\r", urcEvent->line);
+            NTWK_clearProviderInfo();
+
+            urcEvent_t pdpEvent = { .prefix = URC_PDPDEACT, .urcIndx = urcEvent->urcIndx, .arrivedAt = urcEvent->arrivedAt };
+            snprintf(pdpEvent.line, sizeof(pdpEvent.line), "%s,0", URC_PDPDEACT);             // contextID 0: all contexts
+            S__notifyStreams(&pdpEvent);
+        }
+    }
+    return resultCode__success;
+}
+
+
+/**
+ * @brief Forward a pdpdeact URC event to the URC handler of each protocol with an added stream, once per handler.
+ * @details Protocol handlers close their streams on the PDP context (contextID 0 is all contexts).
+ */
+static void S__notifyStreams(const urcEvent_t *urcEvent)
+{
+    urcEvntHndlr_func notified[ltem__streamCnt] = {0};
+    uint8_t notifiedCnt = 0;
+
+    for (size_t i = 0; i < ltem__streamCnt; i++)
+    {
+        streamCtrl_t *streamCtrl = g_lqLTEM->streams[i];
+        if (streamCtrl == NULL || streamCtrl->urcHndlr == NULL)
+            continue;
+
+        bool isNotified = false;
+        for (size_t j = 0; j < notifiedCnt; j++)
+        {
+            isNotified |= notified[j] == streamCtrl->urcHndlr;
+        }
+        if (!isNotified)
+        {
+            notified[notifiedCnt++] = streamCtrl->urcHndlr;
+            streamCtrl->urcHndlr(urcEvent);
+        }
+    }
+}
+
+
+/**
+ * @brief Add a URC prefix/handler to the URC dispatch table, an already registered pair is not added again.
+ */
+static void S__registerUrc(const char *urcPrefix, urcEvntHndlr_func urcHndlr, bool isStream)
+{
+    iop_t *iop = g_lqLTEM->iop;
+    uint8_t freeIndx = ltem__urcPrefixCnt;
+
+    for (uint8_t i = 0; i < ltem__urcPrefixCnt; i++)
+    {
+        if (iop->urcActive & (1 << i))
+        {
+            if (iop->urcTable[i].urcHndlr == urcHndlr && strcmp(iop->urcTable[i].prefix, urcPrefix) == 0)
+                return;                                                             // already registered
+        }
+        else if (freeIndx == ltem__urcPrefixCnt)
+        {
+            freeIndx = i;
+        }
+    }
+    ASSERT(freeIndx < ltem__urcPrefixCnt);                                          // dispatch table full, see ltem__urcPrefixCnt
+    ASSERT(strlen(urcPrefix) > 0 && strlen(urcPrefix) < IOP__urcDetectBufferSz - 1);  // prefix captured with URC line
+
+    urcDispatch_t *urcEntry = &iop->urcTable[freeIndx];
+    urcEntry->prefix = urcPrefix;
+    urcEntry->prefixSz = strlen(urcPrefix);
+    urcEntry->urcHndlr = urcHndlr;
+    urcEntry->isStream = isStream;
+    iop->urcActive |= 1 << freeIndx;                                                // entry complete before classifier can select it (next line)
+}
+
+
+/**
+ * @brief Service URC events queued by RX ISR in arrival order, each by the handler registered for its prefix.
+ * @details Non-stream URC lines at the rxBffr tail are removed before the handler parses the event line, stream URC handlers
+ *          are called with the rxBffr tail at the URC. Unread chars ahead of a URC are not discarded: a non-stream URC is
+ *          serviced from the event and its line left in place, a stream URC is held until the chars ahead are read. A URC
+ *          line consumed with a command response is serviced from the event, a line read by a data transfer is not a URC.
+ */
+static void S__serviceUrcQueue()
+{
+    iop_t *iop = g_lqLTEM->iop;
+    if (iop->urcServicing)                                                          // URC handlers invoke commands, which may yield to eventMgr
+        return;
+    iop->urcServicing = true;
+
+    uint16_t droppedCnt = iop->urcDroppedCnt;                                       // ISR queue full drops since last service
+    g_lqLTEM->metrics.urcDropped += (uint16_t)(droppedCnt - iop->urcDroppedReported);
+    iop->urcDroppedReported = droppedCnt;
+
+    while (iop->urcQueueTail != iop->urcQueueHead)
+    {
+        urcEvent_t *urcEvent = &iop->urcQueue[iop->urcQueueTail];
+        urcDispatch_t *urcEntry = &iop->urcTable[urcEvent->urcIndx];
+
+        if (urcEvent->inDataXfer)
+        {
+            PRINTF(dbgColor__dCyan, "URC(%s) in data, ignored\r", urcEvent->line);
+        }
+        else if (iop->urcActive & (1 << urcEvent->urcIndx))
+        {
+            int16_t urcAt = cbffr_find(iop->rxBffr, urcEntry->prefix, 0, 0, false);
+            bool inRxBffr = CBFFR_FOUND(urcAt);
+            bool atTail = inRxBffr && S__isLineEndsAhead(urcAt);
+
+            if (inRxBffr && !atTail && urcEntry->isStream)
+                break;                                                              // hold, stream content follows unread chars
+
+            if (atTail)
+            {
+                cbffr_skipTail(iop->rxBffr, urcAt);                                 // only line ends ahead of URC
+                if (!urcEntry->isStream)
+                {
+                    int16_t eolIndx = cbffr_find(iop->rxBffr, "\r\n", 0, 0, false);
+                    if (CBFFR_FOUND(eolIndx))
+                        cbffr_skipTail(iop->rxBffr, eolIndx + 2);                   // remove URC line, event line has it
+                }
+            }
+
+            if (inRxBffr || !urcEntry->isStream)
+            {
+                uint32_t serviceDelay = pMillis() - urcEvent->arrivedAt;
+                PRINTF(dbgColor__dCyan, "URC(%s) delay=%" PRIu32 "\r", urcEvent->line, serviceDelay);
+                g_lqLTEM->metrics.urcServiced++;
+                g_lqLTEM->metrics.urcDelayTotalMS += serviceDelay;
+                g_lqLTEM->metrics.urcDelayMaxMS = MAX(g_lqLTEM->metrics.urcDelayMaxMS, serviceDelay);
+                if (urcEntry->isStream)
+                {
+                    IOP_beginRxDataXfer();                                          // stream content is not URC lines
+                    urcEntry->urcHndlr(urcEvent);
+                    IOP_endRxDataXfer();
+                }
+                else
+                {
+                    urcEntry->urcHndlr(urcEvent);
+                }
+            }
+            else
+            {
+                g_lqLTEM->metrics.urcDropped++;                                     // stream content consumed with a command response
+            }
+        }
+        iop->urcQueueTail = (iop->urcQueueTail + 1) % ltem__urcQueueSz;            // slot released after handler, event valid for call
+    }
+    iop->urcServicing = false;
+}
+
+
+/**
+ * @brief Test the chars ahead of a URC in rxBffr are only line ends, the URC is at the rxBffr tail.
+ */
+static bool S__isLineEndsAhead(uint16_t charCnt)
+{
+    char ahead[4];
+    if (charCnt > sizeof(ahead))
+        return false;
+
+    cbffr_peek(g_lqLTEM->iop->rxBffr, ahead, charCnt);
+    for (uint16_t i = 0; i < charCnt; i++)
+    {
+        if (ahead[i] != '\r' && ahead[i] != '\n')
+            return false;
+    }
+    return true;
+}
+
+
+/**
+ * @brief Advance the underway async operation one step, completing it on a final result.
+ */
+static void S__serviceAsync()
+{
+    ltemAsyncOp_t *asyncOp = &g_lqLTEM->asyncOp;
+
+    if (asyncOp->stepFunc == NULL || asyncOp->stepping)
+        return;
+
+    asyncOp->stepping = true;
+    resultCode_t rslt = asyncOp->stepFunc(asyncOp->ctrl);
+    asyncOp->stepping = false;
+
+    if (rslt != resultCode__unknown)
+        LTEM_completeAsync(rslt);
+}
+
+
+/**
+ * @brief Verify BGx communications following a UART baud rate change.
+ */
+static bool S__probeLink()
+{
+    for (size_t i = 0; i < IOP__baudProbeAttempts; i++)
+    {
+        if (atcmd_tryInvoke("AT") && atcmd_awaitResultWithOptions(IOP__baudProbeTimeout, NULL) == resultCode__success)
+            return true;
+        IOP_resetRxBuffer();                                            // discard any garbled chars
+    }
+    return false;
+}
+
+
+/**
+ * @brief If modem access is free, grant it to the highest priority (then earliest) waiting request. Caller holds critical section.
+ */
+static void S__arbiterGrant()
+{
+    if (g_lqLTEM->arbiter.owner != NULL)
+        return;
+
+    ltemRequest_t *next = NULL;
+    for (uint8_t i = 0; i < ltem__arbiterSlots; i++)
+    {
+        ltemRequest_t *request = g_lqLTEM->arbiter.waiting[i];
+        if (request != NULL && 
+            (next == NULL || request->priority > next->priority || 
+             (request->priority == next->priority && (int32_t)(request->arrival - next->arrival) < 0)))
+        {
+            next = request;
+        }
+    }
+    if (next != NULL)
+    {
+        S__arbiterRemove(next);
+        g_lqLTEM->arbiter.owner = next;
+        next->granted = true;
+        if (g_lqLTEM->requestSignalCB != NULL)                                  // wake granted task
+            g_lqLTEM->requestSignalCB(next);
+    }
+}
+
+
+/**
+ * @brief Remove request from the arbiter waiting slots. Caller holds critical section.
+ */
+static void S__arbiterRemove(ltemRequest_t *request)
+{
+    for (uint8_t i = 0; i < ltem__arbiterSlots; i++)
+    {
+        if (g_lqLTEM->arbiter.waiting[i] == request)
+            g_lqLTEM->arbiter.waiting[i] = NULL;
+    }
+}
+
+
+/**
+ * @brief Find the shadow entry for a setting key, NULL if the setting is not shadowed.
+ */
+static ltemShadowEntry_t *S__shadowFind(const char *key, uint16_t keySz)
+{
+    for (uint8_t i = 0; i < ltem__shadowSz; i++)
+    {
+        ltemShadowEntry_t *entry = &g_lqLTEM->shadow.entries[i];
+        if (keySz > 0 && entry->keySz == keySz && memcmp(entry->text, key, keySz) == 0)
+            return entry;
+    }
+    return NULL;
 }
 
 #pragma endregion
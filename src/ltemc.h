@@ -76,15 +76,49 @@ extern "C"
 // typedef void (*eventNotifCallback_func)(uint8_t notifCode, const char *message);
 
 /**
- *	\brief Initialize the LTEm1 modem.
+ *	\brief Initialize an LTEm modem device instance. The new device is bound (see ltem_bind()) on return.
  *	\param ltem_config [in] - The LTE modem gpio pin configuration.
  *  \param applicationCallback [in] - If supplied (not NULL), this function will be invoked for significant LTEm events.
+ *  \return Handle to the device instance, used with ltem_bind() when driving more than one LTEm device.
  */
-void ltem_create(const ltemPinConfig_t ltem_config, yield_func yieldCB, appEvntNotify_func eventNotifyCB);
+ltemHandle_t ltem_create(const ltemPinConfig_t ltem_config, yield_func yieldCB, appEvntNotify_func eventNotifyCB);
 
 
 /**
- *	\brief Uninitialize the LTEm device structures.
+ *	\brief Bind an LTEm device instance; all subsequent LTEmC calls (ltem, atcmd, sckt, mqtt, http, files, ntwk, etc.) operate on it.
+ *  \details Bind is not required with a single device. With multiple devices, bind before calling LTEmC functions for a device 
+ *           (including ltem_eventMgr()). Interrupt servicing is dispatched to the owning device regardless of the bound device.
+ *           Without a task binding callback (see ltem_setTaskBindingCallback()) the binding is process-wide and NOT task-safe: 
+ *           a bind in one task redirects another task's in-flight LTEmC calls (ex: sckt_send()) to the newly bound device.
+ *	\param device [in] - Device handle from ltem_create().
+ *  \return Handle of the previously bound device (NULL if none).
+ */
+ltemHandle_t ltem_bind(ltemHandle_t device);
+
+
+/**
+ *	\brief Get the currently bound LTEm device instance.
+ *  \return Handle of the bound device (NULL if none).
+ */
+ltemHandle_t ltem_getBound();
+
+
+/**
+ *	\brief Registers the application task binding callback, making ltem_bind() and ltem_acquire() ownership per task (required
+ *         when LTEmC is called from multiple tasks).
+ *  \details The callback returns the calling task's binding in thread-local storage (ex: a _Thread_local ltemTaskBinding_t, or
+ *           a field of the RTOS task's local storage block), each task then binds its device with ltem_bind(). The binding 
+ *           also records the task's request granted by ltem_acquire(): while a request holds modem access, other tasks do not
+ *           take the command lock or service the device. The registering task's binding is initialized with the current 
+ *           binding, other tasks' bindings must start zeroed. Called on each LTEmC device access from task context, never from
+ *           interrupt context.
+ *  \param bindingCB [in] Returns the calling task's binding, NULL to restore the process-wide binding.
+ */
+void ltem_setTaskBindingCallback(ltemTaskBinding_func bindingCB);
+
+
+/**
+ *	\brief Uninitialize the bound LTEm device structures and release the device instance.
  */
 void ltem_destroy();
 
@@ -110,6 +144,16 @@ void ltem_setProviderScanMode(ntwkScanMode_t mode);
 void ltem_setIotMode(ntwkIotMode_t mode);
 
 
+/**
+ *	\brief Change the BGx<>bridge UART baud rate. BGx is switched with AT+IPR, the bridge reprogrammed to match and the link verified.
+ *  \details The rate is not saved in the BGx, it reverts to 115200 on BGx reset and is reapplied by LTEmC during restart. If the link
+ *           cannot be verified at the new rate, the prior rate is restored.
+ *  \param [in] baudRate The new rate: 460800 (max), 230400, 115200 or 57600.
+ *  \return Result code: 200 rate applied, 400 rate not supported, 503 link not verified (prior rate restored), 500 link lost
+ */
+resultCode_t ltem_setBaudRate(uint32_t baudRate);
+
+
 /**
  *	\brief Build default data context configuration for modem to use on startup.
  *  \param [in] cntxtId The context ID to operate on. Typically 0 or 1
@@ -164,6 +208,49 @@ deviceState_t ltem_getDeviceState();
 void ltem_eventMgr();
 
 
+/**
+ *	\brief Copy a snapshot of the LTEmC operational metrics: per AT verb completions, timeouts, CME errors, retries and 
+ *         execution duration histogram (log2 milliseconds). Use atcmd_getVerbName() to label verbs for reporting.
+ *  \param metrics [out] Application metrics structure to receive the snapshot.
+ */
+void ltem_getMetrics(ltemMetrics_t *metrics);
+
+
+/**
+ *	\brief Clear the LTEmC operational metrics, start a new collection period.
+ */
+void ltem_resetMetrics();
+
+
+/**
+ *	\brief Returns true if an async operation (sckt_openAsync(), mqtt_startAsync(), http_getAsync()) is underway.
+ *  \details Async operations are advanced by ltem_eventMgr(), with completion signaled to the operation's callback.
+ */
+bool ltem_isAsyncPending();
+
+
+/**
+ * @brief Register a URC handler for a URC prefix, replaces scanning the RX buffer for URCs in ltem_eventMgr().
+ * @details URC lines are classified against registered prefixes as chars are received and queued as URC events (line and
+ *          arrival time). ltem_eventMgr() calls the handler with the event between commands, never while a command is
+ *          underway. The URC line is removed from the RX buffer. Registering a prefix/handler pair again has no effect.
+ * 
+ * @param urcPrefix URC prefix matched from start of line (ex: "+QMTSTAT:"), must remain valid (string literal)
+ * @param urcHndlr Handler, called with the URC event
+ */
+void ltem_registerUrc(const char *urcPrefix, urcEvntHndlr_func urcHndlr);
+
+
+/**
+ * @brief Register a URC handler for a URC with content the handler streams from the RX buffer (ex: "+QMTRECV:").
+ * @details As ltem_registerUrc(), the handler is called with the RX buffer tail at the URC and consumes the URC content.
+ * 
+ * @param urcPrefix URC prefix matched from start of line, must remain valid (string literal)
+ * @param urcHndlr Handler, called with the URC event
+ */
+void ltem_registerUrcStream(const char *urcPrefix, urcEvntHndlr_func urcHndlr);
+
+
 /**
  * @brief Adds a protocol stream to the LTEm streams table
  * @details ASSERTS that no stream is occupying the stream control's data context
@@ -199,6 +286,71 @@ streamCtrl_t* ltem_getStreamFromCntxt(uint8_t context, streamType_t streamType);
 void ltem_setYieldCallback(yield_func yieldCB);
 
 
+/**
+ *	\brief Registers the application critical section callback, required when LTEmC is called from multiple tasks.
+ *  \details LTEmC calls criticalCB(true)/criticalCB(false) around updates to the command lock and modem access arbiter. 
+ *           Implement with a mutex or scheduler suspend, not an interrupt disable held across SPI (not done inside).
+ *  \param criticalCB [in] Enter (true) or exit (false) critical section.
+ */
+void ltem_setCriticalCallback(ltemCritical_func criticalCB);
+
+
+/**
+ *	\brief Acquire modem access for a task's sequence of LTEmC calls (multi-task applications).
+ *  \details Waiting requests are granted in priority order, then arrival order: a high priority publish queued behind a low 
+ *           priority poll is granted access first. Access is not taken from the current holder; the holder's in-flight command 
+ *           can be cancelled with ltem_cancel(). Each task passes its own request, which carries the cancellation token.
+ *           While waiting, the task blocks in the request wait callback (see ltem_setRequestWaitCallbacks()) or, if none 
+ *           registered, pYield() is called. While a request holds access, commands from other tasks wait for the command lock
+ *           without servicing the device; tasks are told apart by their binding (see ltem_setTaskBindingCallback()).
+ *  \param request [in/out] Task's request, stays valid until ltem_release().
+ *  \param priority [in] Access priority.
+ *  \param timeoutMS [in] Maximum wait for access.
+ *  \return True if access granted; false on timeout, cancellation or all waiting slots (ltem__arbiterSlots) in use.
+ */
+bool ltem_acquire(ltemRequest_t *request, ltemPriority_t priority, uint32_t timeoutMS);
+
+
+/**
+ *	\brief Release modem access acquired with ltem_acquire(), the next waiting request is granted access.
+ *  \param request [in] Request holding access.
+ */
+void ltem_release(ltemRequest_t *request);
+
+
+/**
+ *	\brief Cancel a request: a waiting ltem_acquire() returns false, or the commands of the request holding access complete 
+ *         with resultCode__cancelled until it calls ltem_release(). Safe to call from another task.
+ *  \param request [in] Request to cancel.
+ */
+void ltem_cancel(ltemRequest_t *request);
+
+
+/**
+ *	\brief Registers application wait and signal callbacks, allowing the host to sleep while LTEmC awaits BGx responses.
+ *  \details Without wait callbacks, LTEmC polls the RX buffer calling the yield callback between passes. With callbacks, 
+ *           waits (command results, data mode receives) call waitCB until new chars are received or the wait times out; the
+ *           IOP ISR calls signalCB after adding received chars to the RX buffer. A signal given before waitCB blocks must not 
+ *           be lost (semaphore or event flag semantics); WFI is suitable if a periodic tick interrupt bounds the sleep.
+ *           Application work performed in the yield callback must be scheduled by the application when using waitCB.
+ *  \param waitCB [in] Block until signalled or timeoutMS elapses, NULL to restore polling.
+ *  \param signalCB [in] Wake waitCB, called in interrupt context (ex: give semaphore from ISR). May be NULL for WFI.
+ */
+void ltem_setWaitCallbacks(ltemWait_func waitCB, ltemSignal_func signalCB);
+
+
+/**
+ *	\brief Registers application request wait and signal callbacks, tasks waiting in ltem_acquire() block until granted access.
+ *  \details Without request wait callbacks, ltem_acquire() polls calling the yield callback. With callbacks, a waiting task
+ *           calls waitCB with its request; signalCB is called with the request when it is granted access or cancelled, from the
+ *           task releasing access or cancelling (within the critical section). The request's waitCntxt identifies the waiting 
+ *           task (ex: task handle for a task notification). A signal given before waitCB blocks must not be lost.
+ *  \param waitCB [in] Block the calling task until signalled or timeoutMS elapses, NULL to restore polling.
+ *  \param signalCB [in] Wake the task waiting on the request.
+ */
+void ltem_setRequestWaitCallbacks(ltemRequestWait_func waitCB, ltemRequestSignal_func signalCB);
+
+
 /**
  *	\brief Registers the address (void*) of your application event notification callback handler.
  *  \param eventNotifCallback [in] Callback function in application code to be invoked when LTEmC is in await section.
@@ -52,7 +52,8 @@
 #include <ltemc-types.h>                            // - necessary to access internal buffers
 #include <ltemc-nxp-sc16is.h>                       // - necessary to perform direct component access via SPI
 
-ltemDevice_t g_lqLTEM;                              // - normally created in the ltemc.c file, this test is low-level and performs direct IO
+ltemDevice_t ltemDevice;                            // - normally created by ltem_create(), this test is low-level and performs direct IO
+ltemDevice_t *g_lqLTEM = &ltemDevice;               // - bound device
 
 void setup() {
     #ifdef SERIAL_DBG
@@ -69,12 +70,12 @@ void setup() {
 
     /*  Manually create/initialize modem parts used, this is a low-level test
      */
-	g_lqLTEM.pinConfig = ltem_pinConfig;                                // initialize the I/O modem internal settings
-    g_lqLTEM.spi = spi_create(g_lqLTEM.pinConfig.spiCsPin);
-    g_lqLTEM.appEvntNotifyCB = appEvntNotify;                           // set the callback address
+	g_lqLTEM->pinConfig = ltem_pinConfig;                                // initialize the I/O modem internal settings
+    g_lqLTEM->spi = spi_create(g_lqLTEM->pinConfig.spiCsPin);
+    g_lqLTEM->appEvntNotifyCB = appEvntNotify;                           // set the callback address
 
     initIO();                                                           // initialize GPIO, SPI
-    spi_start(g_lqLTEM.spi);
+    spi_start(g_lqLTEM->spi);
     
     /* QBG_ (caps prefix) indicates a function for LTEmC internal use. This test is a low-level
      * direct test of LTEmX I/O and BGx module functionality requiring more direct access to 
@@ -297,16 +298,16 @@ void indicateFailure(char failureMsg[])
 void initIO()
 {
 	// on Arduino, ensure pin is in default "logical" state prior to opening
-	platform_writePin(g_lqLTEM.pinConfig.powerkeyPin, gpioValue_low);
-	platform_writePin(g_lqLTEM.pinConfig.resetPin, gpioValue_low);
-	platform_writePin(g_lqLTEM.pinConfig.spiCsPin, gpioValue_high);
+	platform_writePin(g_lqLTEM->pinConfig.powerkeyPin, gpioValue_low);
+	platform_writePin(g_lqLTEM->pinConfig.resetPin, gpioValue_low);
+	platform_writePin(g_lqLTEM->pinConfig.spiCsPin, gpioValue_high);
 
-	platform_openPin(g_lqLTEM.pinConfig.powerkeyPin, gpioMode_output);		// powerKey: normal low
-	platform_openPin(g_lqLTEM.pinConfig.resetPin, gpioMode_output);			// resetPin: normal low
-	platform_openPin(g_lqLTEM.pinConfig.spiCsPin, gpioMode_output);			// spiCsPin: invert, normal gpioValue_high
+	platform_openPin(g_lqLTEM->pinConfig.powerkeyPin, gpioMode_output);		// powerKey: normal low
+	platform_openPin(g_lqLTEM->pinConfig.resetPin, gpioMode_output);			// resetPin: normal low
+	platform_openPin(g_lqLTEM->pinConfig.spiCsPin, gpioMode_output);			// spiCsPin: invert, normal gpioValue_high
 
-	platform_openPin(g_lqLTEM.pinConfig.statusPin, gpioMode_input);
-	platform_openPin(g_lqLTEM.pinConfig.irqPin, gpioMode_inputPullUp);
+	platform_openPin(g_lqLTEM->pinConfig.statusPin, gpioMode_input);
+	platform_openPin(g_lqLTEM->pinConfig.irqPin, gpioMode_inputPullUp);
 }
 
 /* Check free memory (stack-heap) 
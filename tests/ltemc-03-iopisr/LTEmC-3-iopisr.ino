@@ -80,7 +80,7 @@ void setup() {
     startLTEm();                                            // test defined initialize\start, can't use ltem_start() for this test scenario
 
     cbffr_init(rxBffrPtr, rawBuffer, sizeof(rawBuffer));
-    g_lqLTEM.iop->rxBffr = rxBffrPtr;                       // override LTEm created buffer with test instance
+    g_lqLTEM->iop->rxBffr = rxBffrPtr;                       // override LTEm created buffer with test instance
 
     // pDelay(1000);
     // cbffr_reset(rxBffrPtr);
@@ -167,23 +167,23 @@ void startLTEm()
 {
     // initialize the HOST side of the LTEm interface
 	// ensure pin is in default "logical" state prior to opening
-	platform_writePin(g_lqLTEM.pinConfig.powerkeyPin, gpioValue_low);
-	platform_writePin(g_lqLTEM.pinConfig.resetPin, gpioValue_low);
-	platform_writePin(g_lqLTEM.pinConfig.spiCsPin, gpioValue_high);
+	platform_writePin(g_lqLTEM->pinConfig.powerkeyPin, gpioValue_low);
+	platform_writePin(g_lqLTEM->pinConfig.resetPin, gpioValue_low);
+	platform_writePin(g_lqLTEM->pinConfig.spiCsPin, gpioValue_high);
 
-	platform_openPin(g_lqLTEM.pinConfig.powerkeyPin, gpioMode_output);		// powerKey: normal low
-	platform_openPin(g_lqLTEM.pinConfig.resetPin, gpioMode_output);			// resetPin: normal low
-	platform_openPin(g_lqLTEM.pinConfig.spiCsPin, gpioMode_output);			// spiCsPin: invert, normal gpioValue_high
+	platform_openPin(g_lqLTEM->pinConfig.powerkeyPin, gpioMode_output);		// powerKey: normal low
+	platform_openPin(g_lqLTEM->pinConfig.resetPin, gpioMode_output);			// resetPin: normal low
+	platform_openPin(g_lqLTEM->pinConfig.spiCsPin, gpioMode_output);			// spiCsPin: invert, normal gpioValue_high
 
-	platform_openPin(g_lqLTEM.pinConfig.statusPin, gpioMode_input);
-	platform_openPin(g_lqLTEM.pinConfig.irqPin, gpioMode_inputPullUp);
+	platform_openPin(g_lqLTEM->pinConfig.statusPin, gpioMode_input);
+	platform_openPin(g_lqLTEM->pinConfig.irqPin, gpioMode_inputPullUp);
 
-    spi_start(g_lqLTEM.spi);
+    spi_start(g_lqLTEM->spi);
 
     QBG_reset(resetAction_powerReset);                                      // force power cycle here, limited initial state conditioning
     SC16IS7xx_start();                                                      // start (resets previously powered on) NXP SPI-UART bridge
 
-    if (g_lqLTEM.deviceState != deviceState_appReady)
+    if (g_lqLTEM->deviceState != deviceState_appReady)
     {
         IOP_awaitAppReady();                                                // wait for BGx to signal out firmware ready
     }
@@ -74,7 +74,7 @@ char readData[256];
 
 // for debugging access
 #include "ltemc-internal.h"
-extern ltemDevice_t g_lqLTEM;
+extern ltemDevice_t *g_lqLTEM;
 
 void setup() {
     #ifdef SERIAL_OPT
@@ -0,0 +1,237 @@
+/******************************************************************************
+ *  \file LTEmC-12-bench.c
+ *  \license MIT License
+ *
+ *  Copyright (c) 2020 LooUQ Incorporated.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED
+ * "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ * LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ******************************************************************************
+ * Test 12: Host (off-target) micro-benchmarks of the LTEmC command path.
+ *
+ * White-box: includes ltemc-atcmd.c so static helpers can be timed in
+ * isolation (the build leaves ltemc-atcmd.c out of the linked sources).
+ * Each benchmark times the library code against a reference copy of the
+ * code it replaced. Reports host ns/op and, on x86, TSC cycles/op.
+ *
+ * Usage: ltemc-bench [-n iterations]
+ *****************************************************************************/
+
+#include "ltemc-atcmd.c"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_CYCLES() __rdtsc()
+#else
+#define BENCH_CYCLES() 0ULL
+#endif
+
+#include "replay.h"
+
+
+enum benchApp__constants
+{
+    benchApp__defaultIterations = 1000000,
+    benchApp__spiCsPin = 1,
+    benchApp__irqPin = 2,
+    benchApp__statusPin = 3,
+    benchApp__powerkeyPin = 4,
+    benchApp__resetPin = 5
+};
+
+
+typedef struct benchRslt_tag
+{
+    double nsPerOp;
+    double cyclesPerOp;
+} benchRslt_t;
+
+typedef void (*benchOp_func)();
+
+
+static const ltemPinConfig_t s_pinConfig =
+{
+    .spiCsPin = benchApp__spiCsPin,
+    .irqPin = benchApp__irqPin,
+    .statusPin = benchApp__statusPin,
+    .powerkeyPin = benchApp__powerkeyPin,
+    .resetPin = benchApp__resetPin,
+    .ringUrcPin = 0,
+    .connected = 0,
+    .wakePin = 0
+};
+
+static uint32_t s_iterations = benchApp__defaultIterations;
+static char s_refMirror[atcmd__cmdBufferSz];                                // reference: CMDMIRROR before it became LTEMC_CMDMIRROR only
+static volatile uint32_t s_sink;
+
+static benchRslt_t S__run(benchOp_func op);
+static void S__report(const char *name, const char *refName, benchOp_func refOp, const char *libName, benchOp_func libOp);
+static void S__resetRef();
+static void S__resetLib();
+static uint16_t S__buildRef(const char *cmdTemplate, ...);
+static uint16_t S__buildLib(bool isDescriptor, const char *cmdTemplate, ...);
+static void S__qirdRef();
+static void S__qirdTemplate();
+static void S__qirdDescriptor();
+static void S__qmtpubRef();
+static void S__qmtpubDescriptor();
+
+
+int main(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            s_iterations = strtoul(argv[++i], NULL, 10);
+    }
+    if (s_iterations == 0)
+    {
+        fprintf(stderr, "usage: %s [-n iterations]\n", argv[0]);
+        return 1;
+    }
+
+    platform_writePin(s_pinConfig.statusPin, gpioValue_high);               // BGx powered, device created (not started)
+    ltem_create(s_pinConfig, NULL, NULL);
+    strcpy(g_lqLTEM->atcmd->cmdStr, "AT+QISEND=0,1460\r");                  // 40-char class command in buffer, as at invoke
+
+    char refCmd[atcmd__cmdBufferSz];                                        // descriptor output must match the printf reference
+    S__qmtpubRef();
+    strcpy(refCmd, g_lqLTEM->atcmd->cmdStr);
+    S__qmtpubDescriptor();
+    if (strcmp(refCmd, g_lqLTEM->atcmd->cmdStr) != 0)
+    {
+        fprintf(stderr, "descriptor mismatch: %s != %s\n", g_lqLTEM->atcmd->cmdStr, refCmd);
+        return 1;
+    }
+    strcpy(g_lqLTEM->atcmd->cmdStr, "AT+QISEND=0,1460\r");
+
+    printf("iterations=%u\n", s_iterations);
+    S__report("atcmd-reset", "memset+mirror", S__resetRef, "terminate", S__resetLib);
+    S__report("build-qird", "vsnprintf+cat", S__qirdRef, "vsnprintf", S__qirdTemplate);
+    S__report("build-qird", "vsnprintf+cat", S__qirdRef, "descriptor", S__qirdDescriptor);
+    S__report("build-qmtpub", "vsnprintf+cat", S__qmtpubRef, "descriptor", S__qmtpubDescriptor);
+    return 0;
+}
+
+
+#pragma region Benchmarks
+/*-----------------------------------------------------------------------------------------------*/
+
+/**
+ *  @brief Reference: atcmd_reset() buffer clearing and per invoke command mirror copy before the lightweight reset.
+ */
+static void S__resetRef()
+{
+    memset(g_lqLTEM->atcmd->cmdStr, 0, atcmd__cmdBufferSz);
+    memset(g_lqLTEM->atcmd->rawResponse, 0, atcmd__respBufferSz);
+    memset(g_lqLTEM->atcmd->errorDetail, 0, ltem__errorDetailSz);
+    atcmd_reset(false);
+    strcpy(g_lqLTEM->atcmd->cmdStr, "AT+QISEND=0,1460\r");
+    memcpy(s_refMirror, g_lqLTEM->atcmd->cmdStr, atcmd__cmdBufferSz);
+    s_sink += s_refMirror[0];
+}
+
+
+/**
+ *  @brief Library: atcmd_reset() terminating buffers, no mirror copy (LTEMC_CMDMIRROR off).
+ */
+static void S__resetLib()
+{
+    atcmd_reset(false);
+    strcpy(g_lqLTEM->atcmd->cmdStr, "AT+QISEND=0,1460\r");
+    #ifdef LTEMC_CMDMIRROR
+    strcpy(g_lqLTEM->atcmd->CMDMIRROR, g_lqLTEM->atcmd->cmdStr);
+    #endif
+    s_sink += g_lqLTEM->atcmd->cmdStr[0];
+}
+
+
+
+/**
+ *  @brief Reference: command assembly before descriptors, vsnprintf() then strcat() \r and strlen() for the TX length.
+ */
+static uint16_t S__buildRef(const char *cmdTemplate, ...)
+{
+    va_list ap;
+    va_start(ap, cmdTemplate);
+    vsnprintf(g_lqLTEM->atcmd->cmdStr, sizeof(g_lqLTEM->atcmd->cmdStr), cmdTemplate, ap);
+    va_end(ap);
+    strcat(g_lqLTEM->atcmd->cmdStr, "\r");
+    return strlen(g_lqLTEM->atcmd->cmdStr);
+}
+
+
+/**
+ *  @brief Library: S__buildCmdStr(), printf template or descriptor (atcmd formatter).
+ */
+static uint16_t S__buildLib(bool isDescriptor, const char *cmdTemplate, ...)
+{
+    va_list ap;
+    va_start(ap, cmdTemplate);
+    uint16_t cmdLen = S__buildCmdStr(g_lqLTEM->atcmd->cmdStr, sizeof(g_lqLTEM->atcmd->cmdStr), cmdTemplate, ap, isDescriptor);
+    va_end(ap);
+    return cmdLen;
+}
+
+
+static void S__qirdRef() { s_sink += S__buildRef("AT+QIRD=%d,%d", 0, 1500); }
+static void S__qirdTemplate() { s_sink += S__buildLib(false, "AT+QIRD=%d,%d", 0, 1500); }
+static void S__qirdDescriptor() { s_sink += S__buildLib(true, s_atcmdTemplates[atcmdCmd_qird], 0, 1500); }
+static void S__qmtpubRef() { s_sink += S__buildRef("AT+QMTPUB=%d,%d,%d,0,\"%s\",%d", 0, 1, 1, "devices/ltem/messages/events/", 64); }
+static void S__qmtpubDescriptor() { s_sink += S__buildLib(true, s_atcmdTemplates[atcmdCmd_qmtpub], 0, 1, 1, "devices/ltem/messages/events/", 64); }
+
+#pragma endregion
+
+
+#pragma region Static Functions
+/*-----------------------------------------------------------------------------------------------*/
+
+static benchRslt_t S__run(benchOp_func op)
+{
+    struct timespec start, end;
+
+    for (uint32_t i = 0; i < s_iterations / 10; i++)                        // warm up
+        op();
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    uint64_t cyclesStart = BENCH_CYCLES();
+    for (uint32_t i = 0; i < s_iterations; i++)
+        op();
+    uint64_t cycles = BENCH_CYCLES() - cyclesStart;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    benchRslt_t rslt;
+    rslt.nsPerOp = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / s_iterations;
+    rslt.cyclesPerOp = (double)cycles / s_iterations;
+    return rslt;
+}
+
+
+static void S__report(const char *name, const char *refName, benchOp_func refOp, const char *libName, benchOp_func libOp)
+{
+    benchRslt_t ref = S__run(refOp);
+    benchRslt_t lib = S__run(libOp);
+    printf("%-12s %-14s %7.1f ns %7.1f cyc | %-14s %7.1f ns %7.1f cyc | %.1fx\n",
+           name, refName, ref.nsPerOp, ref.cyclesPerOp, libName, lib.nsPerOp, lib.cyclesPerOp, ref.nsPerOp / lib.nsPerOp);
+}
+
+#pragma endregion
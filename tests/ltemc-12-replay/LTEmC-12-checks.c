@@ -0,0 +1,689 @@
+/******************************************************************************
+ *  \file LTEmC-12-checks.c
+ *  \license MIT License
+ *
+ *  Copyright (c) 2020 LooUQ Incorporated.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED
+ * "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ * LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ******************************************************************************
+ * Test 12: Host (off-target) LTEmC checks on the replay platform.
+ *
+ * Each check loads a short BGx transcript, drives LTEmC through it on the
+ * emulated bridge and asserts on driver state and the replay counters
+ * (SPI transactions, ISR dispatches). Exit code is the count of failed
+ * checks, 3 on an LTEmC fault.
+ *
+ * Usage: ltemc-checks [check-name]
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ltemc.h>
+#include "ltemc-internal.h"
+#include "ltemc-sckt.h"
+#include "ltemc-mdminfo.h"
+#include "replay.h"
+
+
+enum checksApp__constants
+{
+    checksApp__bulkSz = 1500,                   // bulk transfer, one TCP MSS
+    checksApp__roundTripCmds = 10,
+    checksApp__bulkTimeoutMS = 2000,
+    checksApp__settleMS = 20,                   // played RX is in the bridge FIFO, allow the RX time-out IRQ and URC service
+    checksApp__isrRegisterReadsMax = 4,         // IIR + RXLVL/TXLVL, IER write on TX drain, releasing IIR read (6-12 before the ISR snapshot)
+    checksApp__spiCsPin = 1,
+    checksApp__irqPin = 2,
+    checksApp__statusPin = 3,
+    checksApp__powerkeyPin = 4,
+    checksApp__resetPin = 5
+};
+
+
+#define CHECK(cond, ...) do { if (!(cond)) { printf("    %s:%d ", __FILE__, __LINE__); printf(__VA_ARGS__); printf("\n"); return false; } } while(0)
+
+
+typedef bool (*check_func)();
+
+typedef struct checkEntry_tag
+{
+    const char *name;
+    check_func check;
+} checkEntry_t;
+
+
+static const ltemPinConfig_t s_pinConfig =
+{
+    .spiCsPin = checksApp__spiCsPin,
+    .irqPin = checksApp__irqPin,
+    .statusPin = checksApp__statusPin,
+    .powerkeyPin = checksApp__powerkeyPin,
+    .resetPin = checksApp__resetPin,
+    .ringUrcPin = 0,
+    .connected = 0,
+    .wakePin = 0
+};
+
+static bool S__checkIsrRegisterReads();
+static bool S__checkFifoProfiles();
+static bool S__checkScktOpenRetry();
+static bool S__checkRegStatusReport();
+static bool S__checkUrcInData();
+static bool S__checkAcquireWait();
+static bool S__checkShadowAppRdy();
+static bool S__checkModemInfoQueue();
+static bool S__checkScktSendPrefix();
+static bool S__checkScktSendFailRetry();
+static bool S__checkIsrHold();
+static bool S__checkTaskBinding();
+static bool S__checkAccessOwner();
+
+static const checkEntry_t s_checks[] =
+{
+    { "isr-register-reads", S__checkIsrRegisterReads },
+    { "fifo-profiles", S__checkFifoProfiles },
+    { "sckt-open-retry", S__checkScktOpenRetry },
+    { "reg-status-report", S__checkRegStatusReport },
+    { "urc-in-data", S__checkUrcInData },
+    { "acquire-wait", S__checkAcquireWait },
+    { "shadow-app-rdy", S__checkShadowAppRdy },
+    { "mdminfo-queue", S__checkModemInfoQueue },
+    { "sckt-send-prefix", S__checkScktSendPrefix },
+    { "sckt-send-fail-retry", S__checkScktSendFailRetry },
+    { "isr-hold", S__checkIsrHold },
+    { "task-binding", S__checkTaskBinding },
+    { "access-owner", S__checkAccessOwner },
+};
+
+static bool S__play(const char *transcript);
+static bool S__start(const char *transcript);
+static bool S__finish();
+static bool S__playBulk(const char *transcript, bool isTx);
+static void applEvntNotify(appEvents_t eventType, const char *notifyMsg);
+static void S__scktRecv(dataCntxt_t dataCntxt, char *dataPtr, uint16_t dataSz, bool isFinal);
+
+static void S__requestWait(ltemRequest_t *request, uint32_t timeoutMS);
+static void S__requestSignal(ltemRequest_t *request);
+static ltemTaskBinding_t *S__taskBindingSlot();
+
+static char s_scktRecvData[200];
+static uint16_t s_scktRecvSz;
+static ltemRequest_t *s_requestOwner;
+static ltemRequest_t *s_requestSignalled;
+static uint16_t s_requestWaitCnt;
+static ltemTaskBinding_t s_taskBindings[2];                                     // thread-local bindings of two "tasks"
+static uint8_t s_taskCurrent;
+
+
+int main(int argc, char *argv[])
+{
+    const char *only = (argc > 1) ? argv[1] : NULL;
+
+    lqDiag_setNotifyCallback(applEvntNotify);
+    platform_writePin(s_pinConfig.statusPin, gpioValue_high);               // BGx powered
+    ltem_create(s_pinConfig, NULL, applEvntNotify);
+
+    replay_setAutoOk(true);
+    ltem_start(resetAction_skipIfOn);
+    replay_setAutoOk(false);
+
+    int failedCnt = 0;
+    for (uint16_t i = 0; i < sizeof(s_checks) / sizeof(s_checks[0]); i++)
+    {
+        if (only != NULL && strcmp(only, s_checks[i].name) != 0)
+            continue;
+
+        replay_resetStats();
+        bool passed = s_checks[i].check();
+        printf("%s %s\n", passed ? "PASS" : "FAIL", s_checks[i].name);
+        failedCnt += passed ? 0 : 1;
+    }
+    return failedCnt;
+}
+
+
+#pragma region Checks
+/*-----------------------------------------------------------------------------------------------*/
+
+/**
+ *  @brief Register (spi_transferWord) transactions per bridge interrupt: RX bursts, RX time-out and TX refill.
+ */
+static bool S__checkIsrRegisterReads()
+{
+    char transcript[800] =                                                  // RX trigger and time-out bursts, then a TX payload spanning several FIFO refills
+        "> ATI\\r\n~ 20\n"
+        "< \\r\\nQuectel\\r\\nBG96\\r\\nRevision: BG96MAR02A07M1G\\r\\nSubEdition: V01\\r\\nSerial: 866425032000000\\r\\n\\r\\nOK\\r\\n\n"
+        "> AT+QISEND=0,200\\r\n~ 25\n< \\r\\n>\\x20\n> ";
+    for (uint8_t i = 0; i < 20; i++)
+        strcat(transcript, "0123456789");
+    strcat(transcript, "\n~ 40\n< \\r\\nSEND OK\\r\\n\n");
+    CHECK(S__play(transcript), "replay");
+
+    const replayStats_t *stats = replay_getStats();
+    CHECK(stats->isrCnt > 0, "no interrupts");
+    CHECK(stats->isrSpiWordMax <= checksApp__isrRegisterReadsMax, "isrSpiWordMax=%u (max %u)", stats->isrSpiWordMax, checksApp__isrRegisterReadsMax);
+    printf("    isrCnt=%u isrSpiWordXfers=%u (%.2f/irq) isrSpiWordMax=%u\n",
+           stats->isrCnt, stats->isrSpiWordXfers, (double)stats->isrSpiWordXfers / stats->isrCnt, stats->isrSpiWordMax);
+    return true;
+}
+
+
+
+/**
+ *  @brief Command round-trip and bulk RX/TX cost under each bridge FIFO trigger profile (pinned with IOP_setTrafficProfile).
+ *  @details Command profile must answer short commands faster, data profile must move bulk chars with fewer interrupts.
+ */
+static bool S__checkFifoProfiles()
+{
+    static const iopTrafficProfile_t profiles[] = { iopTrafficProfile_command, iopTrafficProfile_data };
+    static const char *profileNames[] = { "command", "data" };
+    double roundTripUS[2];
+    uint32_t rxIsrCnt[2];
+
+    char bulk[checksApp__bulkSz + 1];
+    for (uint16_t i = 0; i < checksApp__bulkSz; i++)
+        bulk[i] = '0' + i % 10;
+    bulk[checksApp__bulkSz] = '\0';
+
+    char transcript[checksApp__bulkSz + 8];
+    for (uint8_t p = 0; p < 2; p++)
+    {
+        IOP_setTrafficProfile(profiles[p]);
+
+        replay_resetStats();
+        for (uint8_t i = 0; i < checksApp__roundTripCmds; i++)
+            CHECK(S__play("> AT+CSQ\\r\n~ 2\n< \\r\\n+CSQ: 19,99\\r\\n\\r\\nOK\\r\\n\n"), "replay AT+CSQ");
+        roundTripUS[p] = replay_getStats()->virtualNS / 1e3 / checksApp__roundTripCmds;
+
+        snprintf(transcript, sizeof(transcript), "< %s\n", bulk);
+        replay_resetStats();
+        CHECK(S__playBulk(transcript, false), "bulk RX");
+        const replayStats_t *stats = replay_getStats();
+        rxIsrCnt[p] = stats->isrCnt;
+        printf("    %-7s  AT+CSQ round-trip=%.0fus  RX %u chars: %.1f kB/s isr=%u spi=%u",
+               profileNames[p], roundTripUS[p], checksApp__bulkSz, checksApp__bulkSz / (stats->virtualNS / 1e6),
+               stats->isrCnt, stats->spiWordXfers + stats->spiBufferXfers);
+
+        snprintf(transcript, sizeof(transcript), "> %s\n", bulk);
+        replay_resetStats();
+        IOP_startTx(bulk, checksApp__bulkSz);
+        CHECK(S__playBulk(transcript, true), "bulk TX");
+        printf("  TX %u chars: %.1f kB/s isr=%u spi=%u\n",
+               checksApp__bulkSz, checksApp__bulkSz / (stats->virtualNS / 1e6), stats->isrCnt, stats->spiWordXfers + stats->spiBufferXfers);
+    }
+    IOP_setTrafficProfile(iopTrafficProfile_command);
+
+    CHECK(roundTripUS[0] < roundTripUS[1], "command profile round-trip %.0fus not below data profile %.0fus", roundTripUS[0], roundTripUS[1]);
+    CHECK(rxIsrCnt[1] < rxIsrCnt[0], "data profile bulk RX interrupts %u not below command profile %u", rxIsrCnt[1], rxIsrCnt[0]);
+    return true;
+}
+
+
+
+/**
+ *  @brief Socket open: +QIOPEN <err> is the result, transient errors are retried per policy, persistent errors fail.
+ */
+static bool S__checkScktOpenRetry()
+{
+    static const char openCmd[] = "> AT+QIOPEN=1,0,\"TCP\",\"192.168.1.10\",9011,0\\r\n~ 30\n< \\r\\nOK\\r\\n\n~ 200\n";
+    char transcript[600];
+    scktCtrl_t scktCtrl;
+
+    sckt_initControl(&scktCtrl, dataCntxt_0, streamType_TCP, NULL);
+    sckt_setConnection(&scktCtrl, 1, "192.168.1.10", 9011, 0);
+
+    snprintf(transcript, sizeof(transcript), "%s< \\r\\n+QIOPEN: 0,565\\r\\n\n%s< \\r\\n+QIOPEN: 0,0\\r\\n\n", openCmd, openCmd);
+    CHECK(S__start(transcript), "load");
+    resultCode_t rslt = sckt_open(&scktCtrl, true);
+    CHECK(S__finish(), "replay, DNS 565 then success");
+    CHECK(rslt == resultCode__success, "open after 565 retry, rslt=%d", rslt);
+
+    CHECK(S__start("> AT+QICLOSE=0\\r\n~ 20\n< \\r\\nOK\\r\\n\n"), "load");
+    sckt_close(&scktCtrl);
+    CHECK(S__finish(), "replay, close");
+
+    snprintf(transcript, sizeof(transcript), "%s< \\r\\n+QIOPEN: 0,552\\r\\n\n", openCmd);
+    CHECK(S__start(transcript), "load");
+    rslt = sckt_open(&scktCtrl, true);
+    CHECK(S__finish(), "replay, 552 not retried");
+    CHECK(rslt == resultCode__badRequest, "open with 552 (invalid parameters), rslt=%d", rslt);
+    return true;
+}
+
+
+
+/**
+ *  @brief Network registration: +CEREG URC and AT+CEREG? response both update EPS status, +CGREG updates GPRS status.
+ */
+static bool S__checkRegStatusReport()
+{
+    providerInfo_t *providerInfo = g_lqLTEM->providerInfo;
+    providerInfo->epsRegStatus = 0;
+    providerInfo->gprsRegStatus = 0;
+
+    CHECK(S__start("< \\r\\n+CEREG: 5,\"1A2B\",\"01A2D101\",8\\r\\n\n"), "load");
+    CHECK(S__finish(), "replay, URC");
+    CHECK(providerInfo->epsRegStatus == 5, "URC form, epsRegStatus=%d", providerInfo->epsRegStatus);
+    CHECK(providerInfo->gprsRegStatus == 0, "URC form, gprsRegStatus=%d", providerInfo->gprsRegStatus);
+
+    CHECK(S__start("< \\r\\n+CGREG: 1\\r\\n\n"), "load");
+    CHECK(S__finish(), "replay, URC");
+    CHECK(providerInfo->gprsRegStatus == 1 && providerInfo->epsRegStatus == 5, "+CGREG URC, gprsRegStatus=%d", providerInfo->gprsRegStatus);
+
+    providerInfo->epsRegStatus = 0;
+    providerInfo->gprsRegStatus = 0;
+    providerInfo->regStatusAt = 0;                                              // no URC since start, status is queried
+    CHECK(S__start("> AT+CEREG?\\r\n~ 20\n< \\r\\n+CEREG: 1,5\\r\\n\\r\\nOK\\r\\n\n"), "load");
+    uint8_t regStatus = ntwk_getRegistrationStatus();
+    CHECK(S__finish(), "replay, AT+CEREG?");
+    CHECK(regStatus == 5 && providerInfo->epsRegStatus == 5, "query form, regStatus=%d epsRegStatus=%d", regStatus, providerInfo->epsRegStatus);
+    CHECK(providerInfo->gprsRegStatus == 0, "query form, gprsRegStatus=%d", providerInfo->gprsRegStatus);
+    return true;
+}
+
+
+/**
+ *  @brief URC lines inside received data are not URCs: socket data (+QIRD) carrying +CEREG/+QIURC lines is delivered 
+ *         to the application and does not update network or socket state, a URC following the data is serviced.
+ */
+static bool S__checkUrcInData()
+{
+    static const char body[] = "ab\r\n+CEREG: 5\r\n+QIURC: \"closed\",0\r\nyz";          // 37 chars
+    scktCtrl_t scktCtrl;
+    providerInfo_t *providerInfo = g_lqLTEM->providerInfo;
+    providerInfo->epsRegStatus = 1;
+
+    sckt_initControl(&scktCtrl, dataCntxt_0, streamType_TCP, S__scktRecv);
+    sckt_setConnection(&scktCtrl, 1, "192.168.1.10", 9011, 0);
+    CHECK(S__start("> AT+QIOPEN=1,0,\"TCP\",\"192.168.1.10\",9011,0\\r\n~ 30\n< \\r\\nOK\\r\\n\n~ 50\n< \\r\\n+QIOPEN: 0,0\\r\\n\n"), "load");
+    CHECK(sckt_open(&scktCtrl, true) == resultCode__success, "open");
+    CHECK(S__finish(), "replay, open");
+
+    s_scktRecvSz = 0;
+    CHECK(S__start("< \\r\\n+QIURC: \"recv\",0\\r\\n\n"
+                   "> AT+QIRD=0,1000\\r\n~ 20\n"
+                   "< \\r\\n+QIRD: 37\\r\\nab\\r\\n+CEREG: 5\\r\\n+QIURC: \"closed\",0\\r\\nyz\\r\\nOK\\r\\n\n"
+                   "> AT+QIRD=0,1000\\r\n~ 20\n"
+                   "< \\r\\n+QIRD: 0\\r\\n\\r\\nOK\\r\\n\n"), "load");
+    CHECK(S__finish(), "replay, recv");
+    CHECK(s_scktRecvSz == strlen(body) && memcmp(s_scktRecvData, body, s_scktRecvSz) == 0, "data delivered, recvSz=%d", s_scktRecvSz);
+    CHECK(providerInfo->epsRegStatus == 1, "+CEREG in data serviced, epsRegStatus=%d", providerInfo->epsRegStatus);
+    CHECK(scktCtrl.state == scktState_open, "+QIURC closed in data serviced, state=%d", scktCtrl.state);
+
+    CHECK(S__start("< \\r\\n+CEREG: 5\\r\\n\n"), "load");
+    CHECK(S__finish(), "replay, URC");
+    CHECK(providerInfo->epsRegStatus == 5, "URC after data, epsRegStatus=%d", providerInfo->epsRegStatus);
+
+    CHECK(S__start("< \\r\\nunread\\r\\n+CEREG: 1\\r\\n\n"), "load");
+    CHECK(S__finish(), "replay, URC");
+    CHECK(providerInfo->epsRegStatus == 1, "URC after unread chars, epsRegStatus=%d", providerInfo->epsRegStatus);
+    CHECK(CBFFR_FOUND(cbffr_find(g_lqLTEM->iop->rxBffr, "unread", 0, 0, false)), "unread chars ahead of URC discarded");
+    IOP_resetRxBuffer();
+
+    CHECK(S__start("> AT+QICLOSE=0\\r\n~ 20\n< \\r\\nOK\\r\\n\n"), "load");
+    sckt_close(&scktCtrl);
+    CHECK(S__finish(), "replay, close");
+    return true;
+}
+
+
+
+/**
+ *  @brief Arbiter: a waiting task blocks in the request wait callback and is signalled when granted. A cancelled command 
+ *         of a manual (reuse) lock holder leaves the lock to the holder.
+ */
+static bool S__checkAcquireWait()
+{
+    ltemRequest_t owner = {0};
+    ltemRequest_t waiter = {0};
+
+    CHECK(ltem_acquire(&owner, ltemPriority_normal, 0), "owner acquire");
+    ltem_setRequestWaitCallbacks(S__requestWait, S__requestSignal);
+    s_requestOwner = &owner;
+    s_requestWaitCnt = 0;
+    s_requestSignalled = NULL;
+
+    bool granted = ltem_acquire(&waiter, ltemPriority_high, 1000);              // wait callback releases owner (other task)
+    ltem_setRequestWaitCallbacks(NULL, NULL);
+    CHECK(granted, "waiter acquire");
+    CHECK(s_requestWaitCnt == 1, "waiter blocked once, waits=%d", s_requestWaitCnt);
+    CHECK(s_requestSignalled == &waiter, "waiter signalled on grant");
+
+    CHECK(S__start("> AT\\r\n~ 20\n< \\r\\nOK\\r\\n\n"), "load");
+    CHECK(ATCMD_awaitLock(atcmd__defaultTimeout), "lock");
+    atcmd_invokeReuseLock("AT");
+    ltem_cancel(&waiter);
+    resultCode_t rslt = atcmd_awaitResult();
+    CHECK(rslt == resultCode__cancelled, "cancelled, rslt=%d", rslt);
+    CHECK(g_lqLTEM->atcmd->isOpenLocked, "manual lock released by cancel");
+    atcmd_close();
+    ltem_release(&waiter);
+    CHECK(S__finish(), "replay, AT");
+    IOP_resetRxBuffer();                                                        // response to abandoned command
+    return true;
+}
+
+
+/**
+ *  @brief Settings shadow: an applied value is not written again, a changed value is, and an APP RDY URC (BGx restart)
+ *         forces the next apply to write.
+ */
+static bool S__checkShadowAppRdy()
+{
+    static const char scanMode[] = "> AT+QCFG=\"nwscanmode\",%d\\r\n~ 20\n< \\r\\nOK\\r\\n\n";
+    char transcript[120];
+
+    snprintf(transcript, sizeof(transcript), scanMode, 3);
+    CHECK(S__start(transcript), "load");
+    CHECK(atcmd_applySetting(1, "AT+QCFG=\"nwscanmode\",%d", 3) == resultCode__success, "apply");
+    CHECK(S__finish(), "replay, apply");
+
+    uint32_t txChars = replay_getStats()->txChars;
+    CHECK(atcmd_applySetting(1, "AT+QCFG=\"nwscanmode\",%d", 3) == resultCode__success, "apply, in effect");
+    CHECK(replay_getStats()->txChars == txChars, "setting in effect written again");
+
+    snprintf(transcript, sizeof(transcript), scanMode, 1);
+    CHECK(S__start(transcript), "load");
+    CHECK(atcmd_applySetting(1, "AT+QCFG=\"nwscanmode\",%d", 1) == resultCode__success, "apply, changed");
+    CHECK(S__finish(), "replay, changed value");
+
+    CHECK(S__start("< \\r\\nAPP RDY\\r\\n\n"), "load");
+    CHECK(S__finish(), "replay, URC");
+
+    snprintf(transcript, sizeof(transcript), scanMode, 1);
+    CHECK(S__start(transcript), "load");
+    CHECK(atcmd_applySetting(1, "AT+QCFG=\"nwscanmode\",%d", 1) == resultCode__success, "apply, after APP RDY");
+    CHECK(S__finish(), "replay, setting written after APP RDY");
+    return true;
+}
+
+
+/**
+ *  @brief Command queue: mdminfo_ltem() pipelines its identity queries, each completion callback stores its value.
+ */
+static bool S__checkModemInfoQueue()
+{
+    static const char transcript[] = 
+        "> AT+GSN\\r\n~ 20\n< \\r\\n866349041234567\\r\\n\\r\\nOK\\r\\n\n"
+        "> AT+QGMR\\r\n~ 20\n< \\r\\nBG96MAR02A07M1G\\r\\n\\r\\nOK\\r\\n\n"
+        "> ATI\\r\n~ 20\n< \\r\\nQuectel\\r\\nBG96\\r\\nRevision: BG96MAR02A07M1G\\r\\n\\r\\nOK\\r\\n\n"
+        "> AT+ICCID\\r\n~ 20\n< \\r\\n+ICCID: 89014103211118510720\\r\\n\\r\\nOK\\r\\n\n";
+
+    memset(g_lqLTEM->modemInfo, 0, sizeof(modemInfo_t));
+    CHECK(S__start(transcript), "load");
+    modemInfo_t *modemInfo = mdminfo_ltem();
+    CHECK(S__finish(), "replay, queued queries");
+    CHECK(strcmp(modemInfo->imei, "866349041234567") == 0, "imei=%s", modemInfo->imei);
+    CHECK(strcmp(modemInfo->fwver, "BG96MAR02A07M1G") == 0, "fwver=%s", modemInfo->fwver);
+    CHECK(strcmp(modemInfo->mfgmodel, "Quectel: BG96") == 0, "mfgmodel=%s", modemInfo->mfgmodel);
+    CHECK(strcmp(modemInfo->iccid, "89014103211118510720") == 0, "iccid=%s", modemInfo->iccid);
+    CHECK(!g_lqLTEM->atcmd->isOpenLocked, "queue left command lock held");
+
+    uint32_t txChars = replay_getStats()->txChars;
+    mdminfo_ltem();                                                             // values known, nothing queued
+    CHECK(replay_getStats()->txChars == txChars, "values queried again");
+    return true;
+}
+
+
+/**
+ *  @brief TX chaining: sckt_sendWithPrefix() sends prefix, data and EOT as chained TX blocks of one +QISEND.
+ */
+static bool S__checkScktSendPrefix()
+{
+    static const char prefix[] = { 0x00, 0x05, 'E', 'C' };                     // framing header: length + type, not a C string
+    scktCtrl_t scktCtrl;
+
+    sckt_initControl(&scktCtrl, dataCntxt_0, streamType_TCP, NULL);
+    CHECK(S__start("> AT+QISEND=0,9\\r\n~ 20\n< \\r\\n>\\x20\n> \\x00\\x05EChello\\x1A\n~ 20\n< \\r\\nSEND OK\\r\\n\n"), "load");
+    resultCode_t rslt = sckt_sendWithPrefix(&scktCtrl, prefix, sizeof(prefix), "hello", 5);
+    CHECK(S__finish(), "replay, prefixed send");
+    CHECK(rslt == resultCode__success, "prefixed send, rslt=%d", rslt);
+    CHECK(replay_getStats()->txMismatches == 0, "TX differs from prefix + data + EOT");
+    return true;
+}
+
+
+/**
+ *  @brief Socket send SEND FAIL (BGx send buffer full) ends the data mode wait at once and is retried per the scktSend policy.
+ */
+static bool S__checkScktSendFailRetry()
+{
+    static const char sendCmd[] = "> AT+QISEND=0,5\\r\n~ 20\n< \\r\\n>\\x20\n> hello\\x1A\n~ 20\n";
+    char transcript[300];
+    scktCtrl_t scktCtrl;
+
+    sckt_initControl(&scktCtrl, dataCntxt_0, streamType_TCP, NULL);
+    snprintf(transcript, sizeof(transcript), "%s< \\r\\nSEND FAIL\\r\\n\n%s< \\r\\nSEND OK\\r\\n\n", sendCmd, sendCmd);
+    CHECK(S__start(transcript), "load");
+    uint32_t sendStart = pMillis();
+    resultCode_t rslt = sckt_send(&scktCtrl, "hello", 5);
+    uint32_t sendDuration = pMillis() - sendStart;
+    CHECK(S__finish(), "replay, SEND FAIL then SEND OK");
+    CHECK(rslt == resultCode__success, "send after SEND FAIL retry, rslt=%d", rslt);
+    CHECK(sendDuration < atcmd__defaultTimeout, "SEND FAIL waited out the timeout, duration=%d", sendDuration);
+    CHECK(replay_getStats()->txMismatches == 0, "TX differs from two sends");
+    return true;
+}
+
+
+/**
+ *  @brief ISR hold: an IRQ arriving while the foreground holds the ISR off (bridgeIer update) is deferred, not lost; the
+ *         release services it.
+ */
+static bool S__checkIsrHold()
+{
+    g_lqLTEM->providerInfo->gprsRegStatus = 0;
+    g_lqLTEM->iop->isrHeld = true;                                              // foreground inside a bridgeIer update
+    CHECK(S__start("< \\r\\n+CGREG: 1\\r\\n\n> AT\\r\n~ 20\n< \\r\\nOK\\r\\n\n"), "load");
+    pDelay(checksApp__settleMS);
+
+    uint32_t isrCnt = replay_getStats()->isrCnt;
+    CHECK(isrCnt > 0 && g_lqLTEM->iop->isrPending, "IRQ not deferred, isrCnt=%d", isrCnt);
+    CHECK(cbffr_getOccupied(g_lqLTEM->iop->rxBffr) == 0, "RX serviced while held");
+
+    CHECK(atcmd_tryInvoke("AT"), "invoke");                                     // TX IRQ enable releases the hold
+    CHECK(!g_lqLTEM->iop->isrHeld && !g_lqLTEM->iop->isrPending, "hold not released");
+    resultCode_t rslt = atcmd_awaitResult();
+    atcmd_close();
+    CHECK(S__finish(), "replay, deferred RX then AT");
+    CHECK(rslt == resultCode__success, "AT after deferred IRQ, rslt=%d", rslt);
+    CHECK(g_lqLTEM->providerInfo->gprsRegStatus == 1, "deferred RX lost, gprsRegStatus=%d", g_lqLTEM->providerInfo->gprsRegStatus);
+    return true;
+}
+
+
+/**
+ *  @brief Task binding: with a task binding callback, ltem_bind() in one task does not redirect another task's LTEmC calls.
+ */
+static bool S__checkTaskBinding()
+{
+    static struct ltemDevice_tag otherDevice;
+    ltemHandle_t device = ltem_getBound();
+
+    s_taskCurrent = 0;
+    ltem_setTaskBindingCallback(S__taskBindingSlot);
+    CHECK(ltem_getBound() == device, "registering task lost its binding");
+
+    s_taskCurrent = 1;
+    CHECK(ltem_getBound() == NULL, "task 1 starts unbound");
+    ltem_bind(&otherDevice);                                                    // task 1 binds a second device
+
+    s_taskCurrent = 0;
+    CHECK(ltem_getBound() == device, "task 1 bind redirected task 0");
+    CHECK(S__play("> AT\\r\n~ 20\n< \\r\\nOK\\r\\n\n"), "replay AT on task 0 device");
+
+    ltem_setTaskBindingCallback(NULL);
+    CHECK(ltem_getBound() == device, "process-wide binding changed");
+    return true;
+}
+
+
+/**
+ *  @brief Arbiter ownership: while task 0's request holds modem access, task 1 neither takes the command lock nor services
+ *         the device waiting for it; task 0's command proceeds.
+ */
+static bool S__checkAccessOwner()
+{
+    ltemRequest_t request = {0};
+    memset(s_taskBindings, 0, sizeof(s_taskBindings));
+
+    s_taskCurrent = 0;
+    ltem_setTaskBindingCallback(S__taskBindingSlot);
+    CHECK(ltem_acquire(&request, ltemPriority_normal, 0), "task 0 acquire");
+
+    s_taskCurrent = 1;
+    ltem_bind(s_taskBindings[0].device);
+    CHECK(S__start("< \\r\\n+CGREG: 5\\r\\n\n> AT\\r\n~ 20\n< \\r\\nOK\\r\\n\n"), "load");
+    g_lqLTEM->providerInfo->gprsRegStatus = 0;
+    pDelay(checksApp__settleMS);
+    CHECK(!ATCMD_awaitLock(50), "task 1 took the lock from the access owner");
+    CHECK(g_lqLTEM->providerInfo->gprsRegStatus == 0, "task 1 serviced the device waiting for the lock");
+
+    s_taskCurrent = 0;
+    CHECK(atcmd_tryInvoke("AT"), "task 0 invoke");
+    resultCode_t rslt = atcmd_awaitResult();
+    atcmd_close();
+    ltem_release(&request);
+    ltem_eventMgr();
+    CHECK(S__finish(), "replay, AT");
+    CHECK(rslt == resultCode__success, "task 0 AT, rslt=%d", rslt);
+    CHECK(g_lqLTEM->providerInfo->gprsRegStatus == 5, "URC not serviced by owner, gprsRegStatus=%d", g_lqLTEM->providerInfo->gprsRegStatus);
+
+    ltem_setTaskBindingCallback(NULL);
+    return true;
+}
+
+#pragma endregion
+
+
+#pragma region Static Functions
+/*-----------------------------------------------------------------------------------------------*/
+
+/**
+ *  @brief Play a transcript through, invoking its AT commands and servicing URCs, until all entries are consumed.
+ *  @return True if host TX matched the transcript, all entries were played and every command succeeded.
+ */
+static bool S__play(const char *transcript)
+{
+    if (!replay_loadText(transcript))
+        return false;
+
+    uint16_t failedCnt = 0;
+    replay_start();
+    replay_invokeTranscript(&failedCnt);
+    return replay_isComplete() && !replay_isFailed() && failedCnt == 0;
+}
+
+
+/**
+ *  @brief Start playing a transcript, the check then drives LTEmC through its public API.
+ */
+static bool S__start(const char *transcript)
+{
+    if (!replay_loadText(transcript))
+        return false;
+    replay_start();
+    return true;
+}
+
+
+/**
+ *  @brief Service URCs until the transcript started with S__start() is played through.
+ *  @return True if host TX matched the transcript and all entries were played.
+ */
+static bool S__finish()
+{
+    uint32_t waitStart = pMillis();
+    while (!replay_isComplete() && !replay_isFailed() && pMillis() - waitStart < checksApp__bulkTimeoutMS)
+    {
+        ltem_eventMgr();
+        pYield();
+    }
+    uint32_t settleStart = pMillis();
+    while (pMillis() - settleStart < checksApp__settleMS)
+    {
+        ltem_eventMgr();
+        pYield();
+    }
+    return replay_isComplete() && !replay_isFailed();
+}
+
+
+/**
+ *  @brief Play a bulk transcript entry with no command: RX chars are left in the RX buffer (then discarded), TX chars are queued by the caller.
+ *  @return True if the bulk chars were all moved through the bridge within checksApp__bulkTimeoutMS.
+ */
+static bool S__playBulk(const char *transcript, bool isTx)
+{
+    if (!replay_loadText(transcript))
+        return false;
+
+    replay_start();
+    uint32_t waitStart = pMillis();
+    while (!replay_isFailed() && pMillis() - waitStart < checksApp__bulkTimeoutMS)
+    {
+        if (replay_isComplete() && (isTx || cbffr_getOccupied(g_lqLTEM->iop->rxBffr) == checksApp__bulkSz))
+            break;
+        pYield();
+    }
+    bool moved = replay_isComplete() && !replay_isFailed() && (isTx || cbffr_getOccupied(g_lqLTEM->iop->rxBffr) == checksApp__bulkSz);
+    IOP_resetRxBuffer();
+    return moved;
+}
+
+
+static void S__scktRecv(dataCntxt_t dataCntxt, char *dataPtr, uint16_t dataSz, bool isFinal)
+{
+    uint16_t copySz = dataSz < sizeof(s_scktRecvData) - s_scktRecvSz ? dataSz : sizeof(s_scktRecvData) - s_scktRecvSz;
+    memcpy(s_scktRecvData + s_scktRecvSz, dataPtr, copySz);
+    s_scktRecvSz += copySz;
+}
+
+
+static void S__requestWait(ltemRequest_t *request, uint32_t timeoutMS)
+{
+    s_requestWaitCnt++;
+    ltem_release(s_requestOwner);                                               // owner task releases while request waits
+}
+
+
+static void S__requestSignal(ltemRequest_t *request)
+{
+    s_requestSignalled = request;
+}
+
+
+static ltemTaskBinding_t *S__taskBindingSlot()
+{
+    return &s_taskBindings[s_taskCurrent];
+}
+
+
+static void applEvntNotify(appEvents_t eventType, const char *notifyMsg)
+{
+    if (eventType > appEvent__FAULTS)
+    {
+        fprintf(stderr, "LTEmC-Fault: %s\n", notifyMsg);
+        exit(3);
+    }
+}
+
+#pragma endregion
@@ -0,0 +1,150 @@
+/******************************************************************************
+ *  \file LTEmC-12-replay.c
+ *  \license MIT License
+ *
+ *  Copyright (c) 2020 LooUQ Incorporated.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED
+ * "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ * LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ******************************************************************************
+ * Test 12: Host (off-target) BGx transcript replay and benchmark.
+ *
+ * Starts LTEmC on the replay platform (BGx auto-responder answers the start
+ * sequence), then replays a transcript: each AT command line in the
+ * transcript is invoked through atcmd, data mode payloads are sent by the
+ * data handler, URCs are serviced by ltem_eventMgr(). Reports virtual time,
+ * host CPU time and SPI/ISR counts; optional budgets fail the run (exit 2)
+ * for CI regression checks.
+ *
+ * Usage: ltemc-replay <transcript> [-n iterations] [--max-spi N] [--max-isr N]
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <ltemc.h>
+#include "replay.h"
+
+
+enum replayApp__constants
+{
+    replayApp__spiCsPin = 1,
+    replayApp__irqPin = 2,
+    replayApp__statusPin = 3,
+    replayApp__powerkeyPin = 4,
+    replayApp__resetPin = 5
+};
+
+
+static const ltemPinConfig_t s_pinConfig =
+{
+    .spiCsPin = replayApp__spiCsPin,
+    .irqPin = replayApp__irqPin,
+    .statusPin = replayApp__statusPin,
+    .powerkeyPin = replayApp__powerkeyPin,
+    .resetPin = replayApp__resetPin,
+    .ringUrcPin = 0,
+    .connected = 0,
+    .wakePin = 0
+};
+
+static void applEvntNotify(appEvents_t eventType, const char *notifyMsg);
+
+
+int main(int argc, char *argv[])
+{
+    const char *transcriptPath = NULL;
+    uint32_t iterations = 1;
+    uint32_t maxSpi = 0;
+    uint32_t maxIsr = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            iterations = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--max-spi") == 0 && i + 1 < argc)
+            maxSpi = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--max-isr") == 0 && i + 1 < argc)
+            maxIsr = strtoul(argv[++i], NULL, 10);
+        else
+            transcriptPath = argv[i];
+    }
+    if (transcriptPath == NULL || iterations == 0)
+    {
+        fprintf(stderr, "usage: %s <transcript> [-n iterations] [--max-spi N] [--max-isr N]\n", argv[0]);
+        return 1;
+    }
+    if (!replay_load(transcriptPath))
+        return 1;
+
+    lqDiag_setNotifyCallback(applEvntNotify);                               // enable ASSERTS to callback into application
+    platform_writePin(s_pinConfig.statusPin, gpioValue_high);               // BGx powered
+    ltem_create(s_pinConfig, NULL, applEvntNotify);
+
+    replay_setAutoOk(true);
+    ltem_start(resetAction_skipIfOn);
+    replay_setAutoOk(false);
+
+    uint16_t cmdCnt = 0;
+    uint16_t failedCnt = 0;
+    replay_resetStats();
+    clock_t hostStart = clock();
+
+    for (uint32_t i = 0; i < iterations && !replay_isFailed(); i++)
+    {
+        replay_start();
+        cmdCnt += replay_invokeTranscript(&failedCnt);
+    }
+
+    double hostUS = (double)(clock() - hostStart) * 1000000 / CLOCKS_PER_SEC;
+    const replayStats_t *stats = replay_getStats();
+    uint32_t spiXfers = stats->spiWordXfers + stats->spiBufferXfers;
+
+    printf("transcript=%s iterations=%u commands=%u cmdFailed=%u complete=%d\n",
+           transcriptPath, iterations, cmdCnt, failedCnt, replay_isComplete());
+    printf("virtualMS=%.3f spiBusyMS=%.3f hostUS=%.0f hostUSPerCmd=%.2f\n",
+           stats->virtualNS / 1e6, stats->spiBusyNS / 1e6, hostUS, cmdCnt ? hostUS / cmdCnt : 0.0);
+    printf("spiXfers=%u spiWordXfers=%u spiBufferXfers=%u spiBufferBytes=%u isrCnt=%u isrSpiWordXfers=%u isrSpiWordMax=%u\n",
+           spiXfers, stats->spiWordXfers, stats->spiBufferXfers, stats->spiBufferBytes, stats->isrCnt, stats->isrSpiWordXfers, stats->isrSpiWordMax);
+    printf("rxChars=%u txChars=%u spiXfersPerKB=%.1f rxOverruns=%u fifoFaults=%u txMismatches=%u\n",
+           stats->rxChars, stats->txChars, (stats->rxChars + stats->txChars) ? spiXfers * 1024.0 / (stats->rxChars + stats->txChars) : 0.0,
+           stats->rxOverruns, stats->fifoFaults, stats->txMismatches);
+
+    if (replay_isFailed() || !replay_isComplete() || stats->fifoFaults > 0)
+        return 1;
+
+    uint32_t spiPerIteration = spiXfers / iterations;
+    uint32_t isrPerIteration = stats->isrCnt / iterations;
+    if ((maxSpi && spiPerIteration > maxSpi) || (maxIsr && isrPerIteration > maxIsr))
+    {
+        printf("BUDGET EXCEEDED: spiXfers/iteration=%u (max %u) isrCnt/iteration=%u (max %u)\n", spiPerIteration, maxSpi, isrPerIteration, maxIsr);
+        return 2;
+    }
+    return 0;
+}
+
+
+static void applEvntNotify(appEvents_t eventType, const char *notifyMsg)
+{
+    if (eventType > appEvent__FAULTS)
+    {
+        fprintf(stderr, "LTEmC-Fault: %s\n", notifyMsg);
+        exit(3);
+    }
+}
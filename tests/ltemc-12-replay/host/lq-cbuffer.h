@@ -0,0 +1,78 @@
+/******************************************************************************
+ *  \file lq-cbuffer.h
+ *  \license MIT License
+ *
+ *  Copyright (c) 2020 LooUQ Incorporated.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED
+ * "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ * LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ******************************************************************************
+ * Test 12: Host stand-in for the LooUQ lq-embed lq-cbuffer.h (host build only).
+ *
+ * Circular char buffer with block push/pop (contiguous region, then
+ * finalize) and search relative to the tail.
+ *****************************************************************************/
+
+#ifndef __LQ_CBUFFER_H__
+#define __LQ_CBUFFER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define CBFFR_NOFIND -1
+#define CBFFR_FOUND(indx) ((int16_t)(indx) >= 0)
+#define CBFFR_NOTFOUND(indx) ((int16_t)(indx) < 0)
+
+typedef struct cbuffer_tag
+{
+    char *buffer;
+    uint16_t bufferSz;
+    uint16_t head;                              // next char written
+    uint16_t tail;                              // next char read
+    volatile uint16_t occupied;
+    uint16_t pushBlkSz;                         // block from last pushBlock, committed by pushBlockFinalize
+    uint16_t popBlkSz;                          // block from last popBlock, committed by popBlockFinalize
+} cbuffer_t;
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+void cbffr_init(cbuffer_t *cbuf, char *buffer, uint16_t bufferSz);
+void cbffr_reset(cbuffer_t *cbuf);
+
+uint16_t cbffr_pushBlock(cbuffer_t *cbuf, char **blockAddr, uint16_t requestSz);
+void cbffr_pushBlockFinalize(cbuffer_t *cbuf, bool commit);
+uint16_t cbffr_popBlock(cbuffer_t *cbuf, char **blockAddr, uint16_t requestSz);
+void cbffr_popBlockFinalize(cbuffer_t *cbuf, bool commit);
+
+uint16_t cbffr_pop(cbuffer_t *cbuf, char *dest, uint16_t popSz);
+uint16_t cbffr_peek(cbuffer_t *cbuf, char *dest, uint16_t peekSz);
+uint16_t cbffr_skipTail(cbuffer_t *cbuf, uint16_t skipSz);
+int16_t cbffr_find(cbuffer_t *cbuf, const char *needle, uint16_t searchOffset, uint16_t searchWindow, bool setTailAtFind);
+
+uint16_t cbffr_getOccupied(cbuffer_t *cbuf);
+uint16_t cbffr_getVacant(cbuffer_t *cbuf);
+uint16_t cbffr_getCapacity(cbuffer_t *cbuf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* !__LQ_CBUFFER_H__ */
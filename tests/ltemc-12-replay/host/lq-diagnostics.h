@@ -0,0 +1,65 @@
+/******************************************************************************
+ *  \file lq-diagnostics.h
+ *  \license MIT License
+ *
+ *  Copyright (c) 2020 LooUQ Incorporated.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED
+ * "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ * LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ******************************************************************************
+ * Test 12: Host stand-in for the LooUQ lq-embed lq-diagnostics.h (host build only).
+ *
+ * A failed ASSERT is reported to the callback set by
+ * lqDiag_setNotifyCallback() as appEvent_fault_assertFailed, then aborts.
+ * ASSERT_W warnings are reported as appEvent_warn_info and continue.
+ *****************************************************************************/
+
+#ifndef __LQ_DIAGNOSTICS_H__
+#define __LQ_DIAGNOSTICS_H__
+
+#include "lq-types.h"
+
+#ifndef SRCFILE
+#define SRCFILE "???"
+#endif
+
+#define ASSERT(true_cond) do { if (!(true_cond)) lqDiag_assert(true, SRCFILE, __LINE__, #true_cond); } while(0)
+#define ASSERT_W(true_cond, msg) do { if (!(true_cond)) lqDiag_assert(false, SRCFILE, __LINE__, msg); } while(0)
+
+enum dbgColor__constants
+{
+    dbgColor__none = 0,
+    dbgColor__white, dbgColor__gray,
+    dbgColor__red, dbgColor__dRed, dbgColor__green, dbgColor__dGreen, dbgColor__blue, dbgColor__dBlue,
+    dbgColor__cyan, dbgColor__dCyan, dbgColor__magenta, dbgColor__dMagenta, dbgColor__yellow, dbgColor__dYellow,
+    dbgColor__info, dbgColor__warn, dbgColor__error
+};
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+void lqDiag_setNotifyCallback(appEvntNotify_func notifyCallback);
+void lqDiag_assert(bool isFault, const char *srcFile, uint16_t srcLine, const char *msg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* !__LQ_DIAGNOSTICS_H__ */
@@ -0,0 +1,244 @@
+/******************************************************************************
+ *  \file lq-embed.c
+ *  \license MIT License
+ *
+ *  Copyright (c) 2020 LooUQ Incorporated.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED
+ * "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ * LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ******************************************************************************
+ * Test 12: Host stand-ins for the lq-embed library sources LTEmC links
+ * against (cbuffer, lq-str, lq-base64, lq-diagnostics, platform yield hook). Host build
+ * only, replaced by the real library with make LQEMBED=<lq-embed>/src.
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lq-types.h"
+#include "lq-diagnostics.h"
+#include "lq-cbuffer.h"
+#include "lq-str.h"
+#include "lq-platform.h"
+
+#define MIN(x, y) (((x) < (y)) ? (x) : (y))
+
+platform_yieldCB_func_t platform_yieldCB_func = NULL;
+
+static appEvntNotify_func s_notifyCB = NULL;
+
+
+#pragma region lq-diagnostics
+/*-----------------------------------------------------------------------------------------------*/
+
+void lqDiag_setNotifyCallback(appEvntNotify_func notifyCallback)
+{
+    s_notifyCB = notifyCallback;
+}
+
+
+void lqDiag_assert(bool isFault, const char *srcFile, uint16_t srcLine, const char *msg)
+{
+    char notifyMsg[120];
+    snprintf(notifyMsg, sizeof(notifyMsg), "%s:%d %s", srcFile, srcLine, msg);
+
+    if (!isFault)
+    {
+        if (s_notifyCB)
+            s_notifyCB(appEvent_warn_info, notifyMsg);
+        return;
+    }
+    if (s_notifyCB)
+        s_notifyCB(appEvent_fault_assertFailed, notifyMsg);
+    fprintf(stderr, "ASSERT %s\n", notifyMsg);
+    abort();
+}
+
+#pragma endregion
+
+
+#pragma region lq-str
+/*-----------------------------------------------------------------------------------------------*/
+
+char *lq_strnstr(const char *haystack, const char *needle, size_t length)
+{
+    size_t needleLen = strlen(needle);
+    if (needleLen == 0)
+        return (char *)haystack;
+
+    for (size_t i = 0; i + needleLen <= length && haystack[i] != '\0'; i++)
+    {
+        if (memcmp(haystack + i, needle, needleLen) == 0)
+            return (char *)(haystack + i);
+    }
+    return NULL;
+}
+
+#pragma endregion
+
+
+#pragma region lq-base64
+/*-----------------------------------------------------------------------------------------------*/
+
+void binToB64(char *b64, const void *bin, uint16_t binSz)
+{
+    static const char encTable[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    const uint8_t *src = (const uint8_t *)bin;
+
+    for (uint16_t i = 0; i < binSz; i += 3)
+    {
+        uint32_t triple = (uint32_t)src[i] << 16;
+        if (i + 1 < binSz) triple |= (uint32_t)src[i + 1] << 8;
+        if (i + 2 < binSz) triple |= src[i + 2];
+
+        *b64++ = encTable[(triple >> 18) & 0x3F];
+        *b64++ = encTable[(triple >> 12) & 0x3F];
+        *b64++ = (i + 1 < binSz) ? encTable[(triple >> 6) & 0x3F] : '=';
+        *b64++ = (i + 2 < binSz) ? encTable[triple & 0x3F] : '=';
+    }
+    *b64 = '\0';
+}
+
+#pragma endregion
+
+
+#pragma region lq-cbuffer
+/*-----------------------------------------------------------------------------------------------*/
+
+void cbffr_init(cbuffer_t *cbuf, char *buffer, uint16_t bufferSz)
+{
+    memset(cbuf, 0, sizeof(cbuffer_t));
+    cbuf->buffer = buffer;
+    cbuf->bufferSz = bufferSz;
+}
+
+
+void cbffr_reset(cbuffer_t *cbuf)
+{
+    cbuf->head = 0;
+    cbuf->tail = 0;
+    cbuf->occupied = 0;
+    cbuf->pushBlkSz = 0;
+    cbuf->popBlkSz = 0;
+}
+
+
+uint16_t cbffr_pushBlock(cbuffer_t *cbuf, char **blockAddr, uint16_t requestSz)
+{
+    uint16_t vacant = cbuf->bufferSz - cbuf->occupied;
+    uint16_t toEnd = cbuf->bufferSz - cbuf->head;
+
+    *blockAddr = cbuf->buffer + cbuf->head;
+    cbuf->pushBlkSz = MIN(requestSz, MIN(vacant, toEnd));
+    return cbuf->pushBlkSz;
+}
+
+
+void cbffr_pushBlockFinalize(cbuffer_t *cbuf, bool commit)
+{
+    if (commit)
+    {
+        cbuf->head = (cbuf->head + cbuf->pushBlkSz) % cbuf->bufferSz;
+        cbuf->occupied += cbuf->pushBlkSz;
+    }
+    cbuf->pushBlkSz = 0;
+}
+
+
+uint16_t cbffr_popBlock(cbuffer_t *cbuf, char **blockAddr, uint16_t requestSz)
+{
+    uint16_t toEnd = cbuf->bufferSz - cbuf->tail;
+
+    *blockAddr = cbuf->buffer + cbuf->tail;
+    cbuf->popBlkSz = MIN(requestSz, MIN(cbuf->occupied, toEnd));
+    return cbuf->popBlkSz;
+}
+
+
+void cbffr_popBlockFinalize(cbuffer_t *cbuf, bool commit)
+{
+    if (commit)
+        cbffr_skipTail(cbuf, cbuf->popBlkSz);
+    cbuf->popBlkSz = 0;
+}
+
+
+uint16_t cbffr_peek(cbuffer_t *cbuf, char *dest, uint16_t peekSz)
+{
+    peekSz = MIN(peekSz, cbuf->occupied);
+    for (uint16_t i = 0; i < peekSz; i++)
+        dest[i] = cbuf->buffer[(cbuf->tail + i) % cbuf->bufferSz];
+    return peekSz;
+}
+
+
+uint16_t cbffr_pop(cbuffer_t *cbuf, char *dest, uint16_t popSz)
+{
+    popSz = cbffr_peek(cbuf, dest, popSz);
+    return cbffr_skipTail(cbuf, popSz);
+}
+
+
+uint16_t cbffr_skipTail(cbuffer_t *cbuf, uint16_t skipSz)
+{
+    skipSz = MIN(skipSz, cbuf->occupied);
+    cbuf->tail = (cbuf->tail + skipSz) % cbuf->bufferSz;
+    cbuf->occupied -= skipSz;
+    return skipSz;
+}
+
+
+int16_t cbffr_find(cbuffer_t *cbuf, const char *needle, uint16_t searchOffset, uint16_t searchWindow, bool setTailAtFind)
+{
+    uint16_t needleLen = strlen(needle);
+    uint16_t occupied = cbuf->occupied;
+    uint16_t searchEnd = (searchWindow == 0) ? occupied : MIN(occupied, searchOffset + searchWindow + needleLen);
+
+    for (uint16_t i = searchOffset; i + needleLen <= searchEnd; i++)
+    {
+        uint16_t j = 0;
+        while (j < needleLen && cbuf->buffer[(cbuf->tail + i + j) % cbuf->bufferSz] == needle[j])
+            j++;
+        if (j == needleLen)
+        {
+            if (setTailAtFind)
+                cbffr_skipTail(cbuf, i);
+            return i;
+        }
+    }
+    return CBFFR_NOFIND;
+}
+
+
+uint16_t cbffr_getOccupied(cbuffer_t *cbuf)
+{
+    return cbuf->occupied;
+}
+
+
+uint16_t cbffr_getVacant(cbuffer_t *cbuf)
+{
+    return cbuf->bufferSz - cbuf->occupied;
+}
+
+
+uint16_t cbffr_getCapacity(cbuffer_t *cbuf)
+{
+    return cbuf->bufferSz;
+}
+
+#pragma endregion
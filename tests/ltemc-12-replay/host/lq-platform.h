@@ -0,0 +1,55 @@
+/******************************************************************************
+ *  \file lq-platform.h
+ *  \license MIT License
+ *
+ *  Copyright (c) 2020 LooUQ Incorporated.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED
+ * "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ * LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ******************************************************************************
+ * Test 12: Host stand-in for the LooUQ lq-embed lq-platform.h (host build only).
+ *
+ * Platform hooks are implemented by the replay bridge (replay-bridge.c).
+ *****************************************************************************/
+
+#ifndef __LQ_PLATFORM_H__
+#define __LQ_PLATFORM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "platform/lqPlatform-spi.h"
+#include "platform/lqPlatform-gpio.h"
+
+#define pElapsed(start, timeout) ((start == 0) ? 0 : pMillis() - start > timeout)
+
+typedef void (*platform_yieldCB_func_t)();
+extern platform_yieldCB_func_t platform_yieldCB_func;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+uint32_t pMillis();
+void pDelay(uint32_t delay_ms);
+void pYield();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* !__LQ_PLATFORM_H__ */
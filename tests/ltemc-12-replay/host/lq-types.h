@@ -0,0 +1,105 @@
+/******************************************************************************
+ *  \file lq-types.h
+ *  \license MIT License
+ *
+ *  Copyright (c) 2020 LooUQ Incorporated.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED
+ * "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ * LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ******************************************************************************
+ * Test 12: Host stand-in for the LooUQ lq-embed lq-types.h (host build only).
+ *
+ * Declares the subset of lq-embed types and constants LTEmC uses so the
+ * replay harness builds without the embedded library. Build against the
+ * real library with make LQEMBED=<lq-embed>/src.
+ *****************************************************************************/
+
+#ifndef __LQ_TYPES_H__
+#define __LQ_TYPES_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+
+
+/**
+ *  @brief Result codes, HTTP status code semantics.
+ */
+typedef uint16_t resultCode_t;
+
+enum resultCode__constants
+{
+    resultCode__success = 200,
+    resultCode__previouslyOpened = 208,
+    resultCode__successMax = 299,
+
+    resultCode__badRequest = 400,
+    resultCode__unauthorized = 401,
+    resultCode__notFound = 404,
+    resultCode__methodNotAllowed = 405,
+    resultCode__timeout = 408,
+    resultCode__conflict = 409,
+    resultCode__preConditionFailed = 412,
+    resultCode__tooManyRequests = 429,
+    resultCode__cancelled = 499,
+
+    resultCode__internalError = 500,
+    resultCode__unavailable = 503,
+    resultCode__gtwyTimeout = 504,
+    resultCode__unknown = 520,
+    resultCode__cmError = 550
+};
+
+
+/**
+ *  @brief Application notification event types, faults above appEvent__FAULTS.
+ */
+typedef enum appEvents_tag
+{
+    appEvent_info = 1,
+    appEvent__WARNINGS = 100,
+    appEvent_warn_info = 101,
+    appEvent__FAULTS = 200,
+    appEvent_fault_softFault = 251,
+    appEvent_fault_assertFailed = 252,
+    appEvent_fault_hardLogic = 253,
+    appEvent_fault_softLogic = 254,
+    appEvent_fault_hardFault = 255
+} appEvents_t;
+
+
+typedef enum resetAction_tag
+{
+    resetAction_swReset = 0,
+    resetAction_hwReset = 1,
+    resetAction_powerReset = 2,
+    resetAction_skipIfOn = 3
+} resetAction_t;
+
+
+typedef void (*appEvntNotify_func)(appEvents_t eventType, const char *notifyMsg);
+typedef void (*yield_func)();
+
+#define PROPLEN(x) ((x) + 1)
+#define SET_PROPLEN(x) ((x) + 1)
+#define PERIOD_FROM_SECONDS(x) ((x) * 1000)
+
+#endif  /* !__LQ_TYPES_H__ */
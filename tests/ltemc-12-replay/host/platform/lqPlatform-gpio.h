@@ -0,0 +1,65 @@
+/******************************************************************************
+ *  \file lqPlatform-gpio.h
+ *  \license MIT License
+ *
+ *  Copyright (c) 2020 LooUQ Incorporated.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED
+ * "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ * LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ******************************************************************************
+ * Test 12: Host stand-in for the LooUQ lq-embed platform GPIO header (host build only).
+ *****************************************************************************/
+
+#ifndef __LQPLATFORM_GPIO_H__
+#define __LQPLATFORM_GPIO_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum gpioPinValue_tag
+{
+    gpioValue_low = 0,
+    gpioValue_high = 1
+} gpioPinValue_t;
+
+typedef enum gpioPinMode_tag
+{
+    gpioMode_input = 0,
+    gpioMode_output,
+    gpioMode_inputPullUp,
+    gpioMode_inputPullDown
+} gpioPinMode_t;
+
+typedef enum gpioIrqTrigger_tag
+{
+    gpioIrqTriggerOn_low = 0,
+    gpioIrqTriggerOn_high,
+    gpioIrqTriggerOn_change,
+    gpioIrqTriggerOn_falling,
+    gpioIrqTriggerOn_rising
+} gpioIrqTrigger_t;
+
+typedef void (*platformGpioPinIrqCallback)();
+
+void platform_openPin(uint8_t pinNum, gpioPinMode_t pinMode);
+void platform_closePin(uint8_t pinNum);
+gpioPinValue_t platform_readPin(uint8_t pinNum);
+void platform_writePin(uint8_t pinNum, gpioPinValue_t val);
+void platform_attachIsr(uint8_t pinNum, bool enabled, gpioIrqTrigger_t triggerOn, platformGpioPinIrqCallback isrCallback);
+void platform_detachIsr(uint8_t pinNum);
+
+#endif  /* !__LQPLATFORM_GPIO_H__ */
@@ -0,0 +1,42 @@
+/******************************************************************************
+ *  \file lqPlatform-spi.h
+ *  \license MIT License
+ *
+ *  Copyright (c) 2020 LooUQ Incorporated.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED
+ * "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ * LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ******************************************************************************
+ * Test 12: Host stand-in for the LooUQ lq-embed platform SPI header (host build only).
+ *****************************************************************************/
+
+#ifndef __LQPLATFORM_SPI_H__
+#define __LQPLATFORM_SPI_H__
+
+#include <stdint.h>
+
+typedef struct platformSpi_tag platformSpi_t;
+
+platformSpi_t *spi_create(uint8_t chipSelLine);
+void spi_start(platformSpi_t *platformSpi);
+void spi_stop(platformSpi_t *platformSpi);
+void spi_destroy(platformSpi_t *platformSpi);
+void spi_usingInterrupt(platformSpi_t *platformSpi, int8_t irqNumber);
+uint16_t spi_transferWord(platformSpi_t *platformSpi, uint16_t writeVal);
+void spi_transferBuffer(platformSpi_t *platformSpi, uint8_t addressByte, void *buf, uint16_t xfer_len);
+
+#endif  /* !__LQPLATFORM_SPI_H__ */
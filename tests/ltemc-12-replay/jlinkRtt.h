@@ -0,0 +1,54 @@
+/******************************************************************************
+ *  \file jlinkRtt.h
+ *  \license MIT License
+ *
+ *  Copyright (c) 2020 LooUQ Incorporated.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED
+ * "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ * LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ******************************************************************************
+ * Test 12: Host replay stand-in for the target J-Link RTT debug output header.
+ *
+ * LTEmC sources built with _DEBUG 2 include <jlinkRtt.h> and define PRINTF
+ * over rtt_printf(). On the host, output is discarded (benchmark runs) or
+ * sent to stdout with -DREPLAY_TRACE. Put this directory ahead of the
+ * platform library on the include path.
+ *****************************************************************************/
+
+#ifndef __JLINKRTT_H__
+#define __JLINKRTT_H__
+
+#include <stdio.h>
+#include <stdarg.h>
+
+static inline void rtt_printf(int color, const char *fmt, ...)
+{
+    #ifdef REPLAY_TRACE
+    va_list ap;
+    va_start(ap, fmt);
+    vprintf(fmt, ap);
+    va_end(ap);
+    #else
+    (void)color;
+    (void)fmt;
+    #endif
+}
+
+/* same definition as the LTEmC sources (benign redefinition), for sources that rely on this header for PRINTF */
+#define PRINTF(c_,f_,__VA_ARGS__...) do { rtt_printf(c_, (f_), ## __VA_ARGS__); } while(0)
+
+#endif  /* !__JLINKRTT_H__ */
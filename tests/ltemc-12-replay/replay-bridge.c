@@ -0,0 +1,756 @@
+/******************************************************************************
+ *  \file replay-bridge.c
+ *  \license MIT License
+ *
+ *  Copyright (c) 2020 LooUQ Incorporated.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED
+ * "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ * LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ******************************************************************************
+ * Test 12: Host (off-target) BGx transcript replay, platform and bridge.
+ *
+ * Host implementation of the LTEmC platform hooks:
+ *  - spi_transferWord()/spi_transferBuffer() drive an emulated SC16IS7xx:
+ *    register banks (LCR selected), RX/TX FIFOs, trigger levels (FCR/TLR),
+ *    IIR interrupt sources and LSR status.
+ *  - pMillis()/pDelay()/pYield() advance a virtual clock. Each advance moves
+ *    TX chars out of the bridge and transcript RX chars in at the UART byte
+ *    rate set by the driver (DLL/DLH), then dispatches the LTEmC ISR on the
+ *    IRQ falling edge. The ISR runs only at these points, never inside an
+ *    SPI transfer.
+ *  - GPIO pins read back the last written value, the IRQ pin reads the
+ *    bridge IRQ line.
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "lq-platform.h"
+#include "ltemc-nxp-sc16is.h"
+#include "replay.h"
+
+#define MIN(x, y) (((x) < (y)) ? (x) : (y))
+#define MAX(x, y) (((x) > (y)) ? (x) : (y))
+
+enum bridge__constants
+{
+    bridge__pinCnt = 64,
+    bridge__iirNone = 0x01,                     // IIR[0] = 1: no interrupt pending
+    bridge__iirThr = 0x02,                      // source 1: THR trigger level
+    bridge__iirRhr = 0x04,                      // source 2: RHR trigger level
+    bridge__iirLineStatus = 0x06,               // source 3: receiver line status (overrun)
+    bridge__iirRxTimeout = 0x0C,                // source 6: RX time-out
+    bridge__iirFifoEnabled = 0xC0
+};
+
+
+/**
+ *  @brief Emulated SC16IS7xx bridge state (single channel).
+ */
+typedef struct bridge_tag
+{
+    SC16IS7xx_IER ier;
+    SC16IS7xx_FCR fcr;                          // write-only on device, kept for trigger levels
+    SC16IS7xx_MCR mcr;
+    SC16IS7xx_EFR efr;
+    SC16IS7xx_TLR tlr;
+    uint8_t lcr;
+    uint8_t spr;
+    uint8_t tcr;
+    uint8_t dll;
+    uint8_t dlh;
+
+    uint8_t rxFifo[replay__fifoSz];
+    uint8_t rxHead;
+    uint8_t rxCnt;
+    uint8_t txFifo[replay__fifoSz];
+    uint8_t txHead;
+    uint8_t txCnt;
+    bool overrun;                               // LSR[1], cleared on LSR read
+    bool thrEvent;                              // THR trigger reached, cleared by IIR read or FIFO write
+
+    uint64_t txNextNS;                          // time next TX char leaves the FIFO
+    uint64_t rxLastNS;                          // time of last RX char arrival (RX time-out)
+} bridge_t;
+
+
+/**
+ *  @brief Transcript player state (the BGx side of the bridge UART).
+ */
+typedef struct player_tag
+{
+    bool playing;
+    bool failed;
+    bool autoOk;
+    uint16_t cursor;                            // current transcript entry
+    uint16_t offset;                            // chars of current entry sent/matched
+    uint64_t entryAtNS;                         // time current entry became current
+    uint64_t rxNextNS;                          // time next RX char reaches the FIFO
+    char txStream[replay__txStreamSz];          // host TX chars not yet matched
+    uint16_t txStreamCnt;
+    const char *autoRx;                         // auto-responder reply in progress
+    uint8_t autoRxOffset;
+} player_t;
+
+
+static bridge_t s_bridge;
+static player_t s_player;
+static replayStats_t s_stats;
+
+static uint64_t s_nowNS = 0;
+static uint8_t s_pins[bridge__pinCnt];
+static uint8_t s_irqPin = 0xFF;
+static platformGpioPinIrqCallback s_isr = NULL;
+static bool s_inIsr = false;
+static bool s_irqWasPending = false;
+
+#ifdef LTEMC_SPI_DMA
+static SC16IS7xx_xferComplete_func s_dmaCompleteCB = NULL;
+#endif
+
+static const char s_autoOkReply[] = "\r\nOK\r\n";
+
+static void S__advance(uint64_t ns);
+static void S__dispatch();
+static void S__serviceTx();
+static void S__servicePlayer();
+static void S__playerRecvTx(char txChar);
+static void S__playerNext();
+static bool S__pushRx(char rxChar);
+static uint8_t S__readReg(uint8_t regAddr);
+static void S__writeReg(uint8_t regAddr, uint8_t regValue);
+static uint8_t S__popRx();
+static void S__pushTx(uint8_t txChar);
+static uint8_t S__iir(bool acknowledge);
+static uint64_t S__byteNS();
+static uint8_t S__rxTriggerLevel();
+static uint8_t S__txTriggerLevel();
+static void S__reset();
+
+
+#pragma region Replay Control
+/*-----------------------------------------------------------------------------------------------*/
+
+/**
+ *  @brief Set BGx auto-responder.
+ */
+void replay_setAutoOk(bool autoOk)
+{
+    s_player.autoOk = autoOk;
+}
+
+
+/**
+ *  @brief Start transcript playback from the first entry.
+ */
+void replay_start()
+{
+    s_player.playing = true;
+    s_player.failed = false;
+    s_player.cursor = 0;
+    s_player.offset = 0;
+    s_player.entryAtNS = s_nowNS;
+    s_player.rxNextNS = s_nowNS;
+    s_player.txStreamCnt = 0;
+}
+
+
+/**
+ *  @brief Test for transcript playback complete.
+ */
+bool replay_isComplete()
+{
+    return s_player.playing && s_player.cursor >= replay_getEntryCnt();
+}
+
+
+/**
+ *  @brief Test for transcript playback failed.
+ */
+bool replay_isFailed()
+{
+    return s_player.failed;
+}
+
+
+/**
+ *  @brief Get replay counters.
+ */
+const replayStats_t *replay_getStats()
+{
+    return &s_stats;
+}
+
+
+/**
+ *  @brief Clear replay counters.
+ */
+void replay_resetStats()
+{
+    memset(&s_stats, 0, sizeof(replayStats_t));
+}
+
+#pragma endregion
+
+
+#pragma region Platform Hooks
+/*-----------------------------------------------------------------------------------------------*/
+
+uint32_t pMillis()
+{
+    S__advance(replay__millisNS);
+    S__dispatch();
+    return (uint32_t)(s_nowNS / 1000000);
+}
+
+
+void pDelay(uint32_t delay_ms)
+{
+    uint64_t untilNS = s_nowNS + (uint64_t)delay_ms * 1000000;
+    while (s_nowNS < untilNS)
+    {
+        S__advance(MIN(replay__delayStepNS, untilNS - s_nowNS));
+        S__dispatch();
+    }
+}
+
+
+void pYield()
+{
+    S__advance(replay__yieldNS);
+    S__dispatch();
+}
+
+
+platformSpi_t *spi_create(uint8_t chipSelLine)
+{
+    S__reset();
+    return (platformSpi_t *)&s_bridge;                                      // opaque to LTEmC, one bridge per replay
+}
+
+
+void spi_start(platformSpi_t *platformSpi) {}
+void spi_stop(platformSpi_t *platformSpi) {}
+void spi_destroy(platformSpi_t *platformSpi) {}
+void spi_usingInterrupt(platformSpi_t *platformSpi, int8_t irqNumber) {}
+
+
+uint16_t spi_transferWord(platformSpi_t *platformSpi, uint16_t writeVal)
+{
+    union __SC16IS7xx_reg_payload__ payload;
+    payload.reg_payload = writeVal;
+
+    if (payload.reg_addr.RnW == SC16IS7xx__FIFO_readRnW)
+        payload.reg_data = S__readReg(payload.reg_addr.A);
+    else
+        S__writeReg(payload.reg_addr.A, payload.reg_data);
+
+    s_stats.spiWordXfers++;
+    if (s_inIsr)
+        s_stats.isrSpiWordXfers++;
+    uint64_t xferNS = replay__spiSelectNS + 16 * replay__spiBitNS;
+    s_stats.spiBusyNS += xferNS;
+    S__advance(xferNS);
+    return payload.reg_payload;
+}
+
+
+void spi_transferBuffer(platformSpi_t *platformSpi, uint8_t addressByte, void* buf, uint16_t xfer_len)
+{
+    union __SC16IS7xx_reg_addr_byte__ regAddr;
+    regAddr.reg_address = addressByte;
+    uint8_t *bufPtr = (uint8_t *)buf;
+
+    for (uint16_t i = 0; i < xfer_len; i++)                                 // address is not auto-incremented, all chars to/from A
+    {
+        if (regAddr.RnW == SC16IS7xx__FIFO_readRnW)
+            bufPtr[i] = S__readReg(regAddr.A);
+        else
+            S__writeReg(regAddr.A, bufPtr[i]);
+    }
+
+    s_stats.spiBufferXfers++;
+    s_stats.spiBufferBytes += xfer_len;
+    uint64_t xferNS = replay__spiSelectNS + (1 + xfer_len) * 8 * replay__spiBitNS;
+    s_stats.spiBusyNS += xferNS;
+    S__advance(xferNS);
+}
+
+
+#ifdef LTEMC_SPI_DMA
+void spi_transferBufferAsync(void *spi, uint8_t addressByte, void *buf, uint16_t xfer_len, SC16IS7xx_xferComplete_func completeCB)
+{
+    spi_transferBuffer((platformSpi_t *)spi, addressByte, buf, xfer_len);
+    s_dmaCompleteCB = completeCB;                                           // completion is an interrupt, delivered at next dispatch
+}
+#endif
+
+
+void platform_openPin(uint8_t pinNum, gpioPinMode_t pinMode) {}
+void platform_closePin(uint8_t pinNum) {}
+
+
+gpioPinValue_t platform_readPin(uint8_t pinNum)
+{
+    if (pinNum == s_irqPin)
+        return (S__iir(false) & bridge__iirNone) ? gpioValue_high : gpioValue_low;     // IRQ is active low
+    return (pinNum < bridge__pinCnt && s_pins[pinNum]) ? gpioValue_high : gpioValue_low;
+}
+
+
+void platform_writePin(uint8_t pinNum, gpioPinValue_t pinVal)
+{
+    if (pinNum < bridge__pinCnt)
+        s_pins[pinNum] = pinVal;
+}
+
+
+void platform_attachIsr(uint8_t pinNum, bool enabled, gpioIrqTrigger_t triggerOn, platformGpioPinIrqCallback isrCallback)
+{
+    s_irqPin = pinNum;
+    s_isr = enabled ? isrCallback : NULL;
+    s_irqWasPending = false;
+}
+
+
+void platform_detachIsr(uint8_t pinNum)
+{
+    s_isr = NULL;
+}
+
+#pragma endregion
+
+
+#pragma region Static Functions
+/*-----------------------------------------------------------------------------------------------*/
+
+/**
+ *  @brief Advance virtual time, moving UART chars through the bridge FIFOs.
+ */
+static void S__advance(uint64_t ns)
+{
+    s_nowNS += ns;
+    s_stats.virtualNS += ns;
+    S__serviceTx();
+    S__servicePlayer();
+}
+
+
+/**
+ *  @brief Dispatch the LTEmC ISR on an IRQ falling edge (and pending DMA completion). Never nested.
+ */
+static void S__dispatch()
+{
+    if (s_inIsr)
+        return;
+
+    s_inIsr = true;
+    #ifdef LTEMC_SPI_DMA
+    if (s_dmaCompleteCB != NULL)
+    {
+        SC16IS7xx_xferComplete_func completeCB = s_dmaCompleteCB;
+        s_dmaCompleteCB = NULL;
+        completeCB();
+    }
+    #endif
+
+    bool irqPending = (S__iir(false) & bridge__iirNone) == 0;
+    if (irqPending && !s_irqWasPending && s_isr != NULL)
+    {
+        s_stats.isrCnt++;
+        uint32_t isrWordStart = s_stats.isrSpiWordXfers;
+        s_isr();
+        s_stats.isrSpiWordMax = MAX(s_stats.isrSpiWordMax, s_stats.isrSpiWordXfers - isrWordStart);
+        irqPending = (S__iir(false) & bridge__iirNone) == 0;
+    }
+    s_irqWasPending = irqPending;
+    s_inIsr = false;
+}
+
+
+/**
+ *  @brief Move TX chars out of the bridge at the UART byte rate to the BGx (player).
+ */
+static void S__serviceTx()
+{
+    uint64_t byteNS = S__byteNS();
+    uint8_t txTrigger = S__txTriggerLevel();
+
+    while (s_bridge.txCnt > 0 && s_nowNS >= s_bridge.txNextNS)
+    {
+        bool belowTrigger = replay__fifoSz - s_bridge.txCnt < txTrigger;
+        char txChar = s_bridge.txFifo[s_bridge.txHead];
+        s_bridge.txHead = (s_bridge.txHead + 1) % replay__fifoSz;
+        s_bridge.txCnt--;
+        s_bridge.txNextNS += byteNS;
+        s_stats.txChars++;
+
+        if (belowTrigger && replay__fifoSz - s_bridge.txCnt >= txTrigger)   // spaces rose to trigger level
+            s_bridge.thrEvent = true;
+        S__playerRecvTx(txChar);
+    }
+}
+
+
+/**
+ *  @brief Advance the transcript: match host TX, time delays and deliver RX chars at the UART byte rate.
+ */
+static void S__servicePlayer()
+{
+    uint64_t byteNS = S__byteNS();
+
+    if (!s_player.playing)
+    {
+        while (s_player.autoRx != NULL && s_nowNS >= s_player.rxNextNS)     // auto-responder reply
+        {
+            if (!S__pushRx(s_player.autoRx[s_player.autoRxOffset]))
+                break;
+            s_player.rxNextNS += byteNS;
+            if (s_player.autoRx[++s_player.autoRxOffset] == '\0')
+                s_player.autoRx = NULL;
+        }
+        return;
+    }
+
+    const replayEntry_t *entry;
+    while (!s_player.failed && (entry = replay_getEntry(s_player.cursor)) != NULL)
+    {
+        if (entry->type == replayEntry_tx)
+        {
+            uint16_t matched = 0;
+            while (s_player.offset < entry->dataSz && matched < s_player.txStreamCnt)
+            {
+                if (s_player.txStream[matched] != entry->data[s_player.offset])
+                {
+                    s_stats.txMismatches++;
+                    s_player.failed = true;
+                    fprintf(stderr, "replay: transcript line %d, host TX mismatch at char %d (expected 0x%02X, got 0x%02X)\n",
+                            entry->lineNum, s_player.offset, (uint8_t)entry->data[s_player.offset], (uint8_t)s_player.txStream[matched]);
+                    return;
+                }
+                matched++;
+                s_player.offset++;
+            }
+            memmove(s_player.txStream, s_player.txStream + matched, s_player.txStreamCnt - matched);
+            s_player.txStreamCnt -= matched;
+
+            if (s_player.offset < entry->dataSz)
+                return;                                                     // wait on more host TX
+        }
+        else if (entry->type == replayEntry_delay)
+        {
+            uint64_t untilNS = s_player.entryAtNS + (uint64_t)entry->delayMS * 1000000;
+            if (s_nowNS < untilNS)
+                return;
+            s_player.rxNextNS = MAX(s_player.rxNextNS, untilNS);
+        }
+        else                                                                // replayEntry_rx
+        {
+            if (s_player.offset == 0)
+                s_player.rxNextNS = MAX(s_player.rxNextNS, s_player.entryAtNS);
+
+            while (s_player.offset < entry->dataSz && s_nowNS >= s_player.rxNextNS)
+            {
+                if (!S__pushRx(entry->data[s_player.offset]))
+                    return;                                                 // flow controlled, hold
+                s_player.offset++;
+                s_player.rxNextNS += byteNS;
+            }
+            if (s_player.offset < entry->dataSz)
+                return;
+        }
+        S__playerNext();
+    }
+}
+
+
+/**
+ *  @brief Host TX char arrived at BGx.
+ */
+static void S__playerRecvTx(char txChar)
+{
+    if (s_player.playing)
+    {
+        if (s_player.cursor >= replay_getEntryCnt() || s_player.txStreamCnt == replay__txStreamSz)
+        {
+            s_stats.txMismatches++;                                         // host TX beyond transcript end
+            return;
+        }
+        s_player.txStream[s_player.txStreamCnt++] = txChar;
+    }
+    else if (s_player.autoOk && txChar == '\r' && s_player.autoRx == NULL)
+    {
+        s_player.autoRx = s_autoOkReply;
+        s_player.autoRxOffset = 0;
+        s_player.rxNextNS = MAX(s_player.rxNextNS, s_nowNS);
+    }
+}
+
+
+/**
+ *  @brief Move player to next transcript entry.
+ */
+static void S__playerNext()
+{
+    s_player.cursor++;
+    s_player.offset = 0;
+    s_player.entryAtNS = s_nowNS;
+}
+
+
+/**
+ *  @brief BGx char into RX FIFO.
+ *  @return False if the FIFO is full and RTS/CTS flow control holds the sender. Without flow control the char is lost.
+ */
+static bool S__pushRx(char rxChar)
+{
+    if (s_bridge.rxCnt == replay__fifoSz)
+    {
+        if (s_bridge.efr.AUTO_nRTS)
+            return false;
+        s_bridge.overrun = true;
+        s_stats.rxOverruns++;
+        return true;
+    }
+    s_bridge.rxFifo[(s_bridge.rxHead + s_bridge.rxCnt) % replay__fifoSz] = rxChar;
+    s_bridge.rxCnt++;
+    s_bridge.rxLastNS = s_nowNS;
+    s_stats.rxChars++;
+    return true;
+}
+
+
+static uint8_t S__popRx()
+{
+    if (s_bridge.rxCnt == 0)
+    {
+        s_stats.fifoFaults++;
+        return 0;
+    }
+    uint8_t rxChar = s_bridge.rxFifo[s_bridge.rxHead];
+    s_bridge.rxHead = (s_bridge.rxHead + 1) % replay__fifoSz;
+    s_bridge.rxCnt--;
+    return rxChar;
+}
+
+
+static void S__pushTx(uint8_t txChar)
+{
+    if (s_bridge.txCnt == replay__fifoSz)
+    {
+        s_stats.fifoFaults++;
+        return;
+    }
+    if (s_bridge.txCnt == 0)
+        s_bridge.txNextNS = s_nowNS + S__byteNS();                          // shift register idle, first char starts now
+    s_bridge.txFifo[(s_bridge.txHead + s_bridge.txCnt) % replay__fifoSz] = txChar;
+    s_bridge.txCnt++;
+    s_bridge.thrEvent = false;                                              // THR write clears THR interrupt
+}
+
+
+/**
+ *  @brief Register read, register bank selected by LCR (general, special: 0x80, enhanced: 0xBF).
+ */
+static uint8_t S__readReg(uint8_t regAddr)
+{
+    bool tcrTlrBank = s_bridge.mcr.TCR_TLR_EN && s_bridge.efr.ENHANCED_FNS_EN;
+
+    if (s_bridge.lcr == SC16IS7xx__LCR_REGSET_enhanced && (regAddr == SC16IS7xx_EFR_regAddr))
+        return s_bridge.efr.reg;
+    if ((s_bridge.lcr & SC16IS7xx__LCR_REGSET_special) && s_bridge.lcr != SC16IS7xx__LCR_REGSET_enhanced)
+    {
+        if (regAddr == SC16IS7xx_DLL_regAddr)
+            return s_bridge.dll;
+        if (regAddr == SC16IS7xx_DLH_regAddr)
+            return s_bridge.dlh;
+    }
+
+    switch (regAddr)
+    {
+        case SC16IS7xx_FIFO_regAddr:
+            return S__popRx();
+        case SC16IS7xx_IER_regAddr:
+            return s_bridge.ier.reg;
+        case SC16IS7xx_IIR_regAddr:
+            return S__iir(true);
+        case SC16IS7xx_LCR_regAddr:
+            return s_bridge.lcr;
+        case SC16IS7xx_MCR_regAddr:
+            return s_bridge.mcr.reg;
+        case SC16IS7xx_LSR_regAddr:
+        {
+            SC16IS7xx_LSR lsr = { 0 };
+            lsr.reg = (s_bridge.rxCnt > 0 ? 0x01 : 0) |
+                      (s_bridge.overrun ? 0x02 : 0) |
+                      (s_bridge.txCnt == 0 ? 0x60 : 0);                     // THR empty, THR and TSR empty
+            s_bridge.overrun = false;
+            return lsr.reg;
+        }
+        case SC16IS7xx_TCR_regAddr:                                         // shared with MSR
+            return tcrTlrBank ? s_bridge.tcr : 0;
+        case SC16IS7xx_TLR_regAddr:                                         // shared with SPR
+            return tcrTlrBank ? s_bridge.tlr.reg : s_bridge.spr;
+        case SC16IS7xx_TXLVL_regAddr:
+            return replay__fifoSz - s_bridge.txCnt;
+        case SC16IS7xx_RXLVL_regAddr:
+            return s_bridge.rxCnt;
+        default:
+            return 0;
+    }
+}
+
+
+/**
+ *  @brief Register write, register bank selected by LCR.
+ */
+static void S__writeReg(uint8_t regAddr, uint8_t regValue)
+{
+    bool tcrTlrBank = s_bridge.mcr.TCR_TLR_EN && s_bridge.efr.ENHANCED_FNS_EN;
+
+    if (regAddr == SC16IS7xx_LCR_regAddr)
+    {
+        s_bridge.lcr = regValue;
+        return;
+    }
+    if (s_bridge.lcr == SC16IS7xx__LCR_REGSET_enhanced)
+    {
+        if (regAddr == SC16IS7xx_EFR_regAddr)
+            s_bridge.efr.reg = regValue;
+        return;                                                             // XON/XOFF not emulated
+    }
+    if (s_bridge.lcr & SC16IS7xx__LCR_REGSET_special)
+    {
+        if (regAddr == SC16IS7xx_DLL_regAddr)
+            s_bridge.dll = regValue;
+        else if (regAddr == SC16IS7xx_DLH_regAddr)
+            s_bridge.dlh = regValue;
+        return;
+    }
+
+    switch (regAddr)
+    {
+        case SC16IS7xx_FIFO_regAddr:
+            S__pushTx(regValue);
+            break;
+        case SC16IS7xx_IER_regAddr:
+        {
+            bool thrEnabling = !s_bridge.ier.THR_EMPTY_INT_EN && (regValue & 0x02);
+            s_bridge.ier.reg = regValue;
+            if (thrEnabling && replay__fifoSz - s_bridge.txCnt >= S__txTriggerLevel())
+                s_bridge.thrEvent = true;                                   // enabling THR IRQ with FIFO at/above trigger raises it
+            break;
+        }
+        case SC16IS7xx_FCR_regAddr:
+            s_bridge.fcr.reg = regValue;
+            if (s_bridge.fcr.RX_FIFO_RST)
+            {
+                s_bridge.rxCnt = 0;
+                s_bridge.overrun = false;
+            }
+            if (s_bridge.fcr.TX_FIFO_RST)
+                s_bridge.txCnt = 0;
+            break;
+        case SC16IS7xx_MCR_regAddr:
+            s_bridge.mcr.reg = regValue;
+            break;
+        case SC16IS7xx_TCR_regAddr:
+            if (tcrTlrBank)
+                s_bridge.tcr = regValue;
+            break;
+        case SC16IS7xx_TLR_regAddr:
+            if (tcrTlrBank)
+                s_bridge.tlr.reg = regValue;
+            else
+                s_bridge.spr = regValue;
+            break;
+        case SC16IS7xx_UARTRST_regAddr:
+            if (regValue & SC16IS7xx__SW_resetMask)
+                S__reset();
+            break;
+    }
+}
+
+
+/**
+ *  @brief Interrupt identification, highest priority pending source.
+ *  @param acknowledge [in] IIR register read, clears a THR interrupt.
+ */
+static uint8_t S__iir(bool acknowledge)
+{
+    uint8_t fifoBits = s_bridge.fcr.FIFO_EN ? bridge__iirFifoEnabled : 0;
+    bool rxTimeout = s_bridge.rxCnt > 0 && s_nowNS - s_bridge.rxLastNS >= replay__rxTimeoutChars * S__byteNS();
+
+    if (s_bridge.ier.RECEIVE_LINE_STAT_INT_EN && s_bridge.overrun)
+        return bridge__iirLineStatus | fifoBits;
+    if (s_bridge.ier.RHR_DATA_AVAIL_INT_EN && s_bridge.rxCnt >= S__rxTriggerLevel())
+        return bridge__iirRhr | fifoBits;
+    if (s_bridge.ier.RHR_DATA_AVAIL_INT_EN && rxTimeout)
+        return bridge__iirRxTimeout | fifoBits;
+    if (s_bridge.ier.THR_EMPTY_INT_EN && s_bridge.thrEvent)
+    {
+        if (acknowledge)
+            s_bridge.thrEvent = false;
+        return bridge__iirThr | fifoBits;
+    }
+    return bridge__iirNone | fifoBits;
+}
+
+
+/**
+ *  @brief UART char time (10 bits) at the baud rate set by the DLL/DLH divisor.
+ */
+static uint64_t S__byteNS()
+{
+    uint16_t divisor = (s_bridge.dlh << 8) | s_bridge.dll;
+    if (divisor == 0)
+        divisor = replay__defaultDivisor;
+    uint32_t baudRate = replay__xtalFrequency / (16 * divisor);
+    return 10ULL * 1000000000ULL / baudRate;
+}
+
+
+/**
+ *  @brief RX trigger level: TLR (4 char granularity) if set, otherwise FCR.
+ */
+static uint8_t S__rxTriggerLevel()
+{
+    static const uint8_t fcrLevels[] = { 8, 16, 56, 60 };
+    return s_bridge.tlr.RX_TRIGGER_LVL ? s_bridge.tlr.RX_TRIGGER_LVL * 4 : fcrLevels[s_bridge.fcr.RX_TRIGGER_LVL];
+}
+
+
+/**
+ *  @brief TX trigger level (spaces): TLR (4 char granularity) if set, otherwise FCR.
+ */
+static uint8_t S__txTriggerLevel()
+{
+    static const uint8_t fcrLevels[] = { 8, 16, 32, 56 };
+    return s_bridge.tlr.TX_TRIGGER_LVL ? s_bridge.tlr.TX_TRIGGER_LVL * 4 : fcrLevels[s_bridge.fcr.TX_TRIGGER_LVL];
+}
+
+
+/**
+ *  @brief Bridge reset (power on or UARTRST): registers cleared, FIFOs empty.
+ */
+static void S__reset()
+{
+    memset(&s_bridge, 0, sizeof(bridge_t));
+    s_bridge.lcr = 0x1D;                                                    // SC16IS7xx LCR reset value
+    s_bridge.dll = replay__defaultDivisor;
+}
+
+#pragma endregion
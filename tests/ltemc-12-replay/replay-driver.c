@@ -0,0 +1,137 @@
+/******************************************************************************
+ *  \file replay-driver.c
+ *  \license MIT License
+ *
+ *  Copyright (c) 2020 LooUQ Incorporated.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED
+ * "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ * LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ******************************************************************************
+ * Test 12: Host (off-target) BGx transcript replay, LTEmC side.
+ *
+ * Invokes the AT commands of the loaded transcript through atcmd, in order,
+ * with data mode payloads sent by the data handler and URCs serviced by
+ * ltem_eventMgr() between commands. Shared by ltemc-replay and ltemc-checks.
+ *****************************************************************************/
+
+#include <string.h>
+
+#include <ltemc.h>
+#include "replay.h"
+
+
+enum replayDriver__constants
+{
+    replayDriver__responseMarginMS = 2000,      // command timeout beyond transcript BGx think time
+    replayDriver__drainTimeoutMS = 10000        // wait for trailing transcript RX (URCs) after last command
+};
+
+
+static const replayEntry_t *S__findDataEntry(uint16_t cmdIndx, const char **trigger);
+static uint32_t S__responseWindow(uint16_t cmdIndx);
+
+
+/**
+ *  @brief Invoke the transcript's AT commands in order, servicing URCs between commands.
+ *  @return Count of commands invoked.
+ */
+uint16_t replay_invokeTranscript(uint16_t *failedCnt)
+{
+    uint16_t cmdCnt = 0;
+    char cmdStr[atcmd__cmdBufferSz];
+
+    for (uint16_t i = 0; i < replay_getEntryCnt() && !replay_isFailed(); i++)
+    {
+        const replayEntry_t *entry = replay_getEntry(i);
+        if (entry->type != replayEntry_tx || entry->dataSz < 3 || entry->dataSz > sizeof(cmdStr) ||
+            memcmp(entry->data, "AT", 2) != 0 || entry->data[entry->dataSz - 1] != '\r')
+            continue;                                                       // data mode payloads are sent by command's data handler
+
+        memcpy(cmdStr, entry->data, entry->dataSz - 1);                     // atcmd appends \r
+        cmdStr[entry->dataSz - 1] = '\0';
+
+        const char *trigger;
+        const replayEntry_t *dataEntry = S__findDataEntry(i, &trigger);
+        if (dataEntry != NULL)
+            atcmd_configDataMode(0, trigger, atcmd_stdTxDataHndlr, dataEntry->data, dataEntry->dataSz, NULL, true);
+
+        resultCode_t rslt = resultCode__conflict;
+        if (atcmd_tryInvoke("%s", cmdStr))
+            rslt = atcmd_awaitResultWithOptions(S__responseWindow(i), NULL);
+        atcmd_close();
+        if (rslt != resultCode__success)
+            (*failedCnt)++;
+        cmdCnt++;
+
+        ltem_eventMgr();                                                    // URCs received with/after response
+    }
+
+    uint32_t drainStart = pMillis();
+    while (!replay_isComplete() && !replay_isFailed() && pMillis() - drainStart < replayDriver__drainTimeoutMS)
+    {
+        ltem_eventMgr();
+        pYield();
+    }
+    ltem_eventMgr();
+    return cmdCnt;
+}
+
+
+/**
+ *  @brief Find the data mode payload for a command: a non-AT TX entry following a BGx data prompt.
+ *  @param trigger [out] Data mode trigger found in BGx response ("> " or "CONNECT").
+ *  @return Payload entry, NULL if command has no data mode payload.
+ */
+static const replayEntry_t *S__findDataEntry(uint16_t cmdIndx, const char **trigger)
+{
+    *trigger = NULL;
+    for (uint16_t i = cmdIndx + 1; i < replay_getEntryCnt(); i++)
+    {
+        const replayEntry_t *entry = replay_getEntry(i);
+        if (entry->type == replayEntry_rx)
+        {
+            if (entry->dataSz >= 2 && memcmp(entry->data + entry->dataSz - 2, "> ", 2) == 0)
+                *trigger = "> ";
+            else if (entry->dataSz >= 9 && memcmp(entry->data, "\r\nCONNECT", 9) == 0)
+                *trigger = "CONNECT\r\n";
+        }
+        else if (entry->type == replayEntry_tx)
+        {
+            bool isCmd = entry->dataSz >= 2 && memcmp(entry->data, "AT", 2) == 0;
+            return (*trigger != NULL && !isCmd) ? entry : NULL;
+        }
+    }
+    return NULL;
+}
+
+
+/**
+ *  @brief Command timeout: BGx think time in transcript up to the next AT command, plus margin.
+ */
+static uint32_t S__responseWindow(uint16_t cmdIndx)
+{
+    uint32_t windowMS = replayDriver__responseMarginMS;
+    for (uint16_t i = cmdIndx + 1; i < replay_getEntryCnt(); i++)
+    {
+        const replayEntry_t *entry = replay_getEntry(i);
+        if (entry->type == replayEntry_delay)
+            windowMS += entry->delayMS;
+        else if (entry->type == replayEntry_tx && entry->dataSz >= 2 && memcmp(entry->data, "AT", 2) == 0)
+            break;
+    }
+    return windowMS;
+}
@@ -0,0 +1,191 @@
+/******************************************************************************
+ *  \file replay-record.c
+ *  \license MIT License
+ *
+ *  Copyright (c) 2020 LooUQ Incorporated.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED
+ * "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ * LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ******************************************************************************
+ * Test 12: On-target transcript recorder.
+ *
+ * Built into a device application (not the host replay), with the linker
+ * option -Wl,--wrap=spi_transferBuffer. Bridge FIFO transfers are captured
+ * with their pMillis() time into a RAM log; the application calls
+ * replayRecord_flush() from its loop to emit transcript lines (> < ~) to a
+ * line writer (serial, RTT, file). Record with LTEMC_SPI_DMA off, DMA RX
+ * transfers bypass spi_transferBuffer.
+ *
+ * LTEmC moves FIFO chars in its ISR (and polled before IRQ attach), FIFO
+ * transfers are not nested so capture needs no locking. Flush with the IRQ
+ * masked or between commands.
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "lq-platform.h"
+#include "ltemc-nxp-sc16is.h"
+
+
+enum replayRecord__constants
+{
+    replayRecord__logSz = 8192,                 // RAM log, captures beyond are dropped (counted)
+    replayRecord__lineSz = 256                  // emitted transcript line, longer data is continued on following lines
+};
+
+typedef void (*replayRecordWriter_func)(const char *line);
+
+typedef struct recordHeader_tag
+{
+    char direction;                             // '>' host TX, '<' BGx RX
+    uint16_t dataSz;
+    uint32_t timestamp;                         // pMillis() at capture
+} recordHeader_t;
+
+static uint8_t s_log[replayRecord__logSz];
+static uint16_t s_logCnt = 0;
+static uint32_t s_droppedCnt = 0;
+static uint32_t s_lastTxAt = 0;                 // flush state carried across flushes: BGx think time reference
+static bool s_awaitingRx = false;
+static char s_line[replayRecord__lineSz];      // transcript line being built, continues across captures to line end
+static uint16_t s_lineLen = 0;
+
+void __real_spi_transferBuffer(platformSpi_t *platformSpi, uint8_t addressByte, void* buf, uint16_t xfer_len);
+static void S__capture(char direction, const void *data, uint16_t dataSz);
+static void S__emit(replayRecordWriter_func writer, char direction, const uint8_t *data, uint16_t dataSz);
+static void S__emitLine(replayRecordWriter_func writer);
+
+
+/**
+ *  @brief Wrapped platform FIFO transfer, captures bridge FIFO data.
+ */
+void __wrap_spi_transferBuffer(platformSpi_t *platformSpi, uint8_t addressByte, void* buf, uint16_t xfer_len)
+{
+    union __SC16IS7xx_reg_addr_byte__ regAddr;
+    regAddr.reg_address = addressByte;
+    bool isFifo = regAddr.A == SC16IS7xx_FIFO_regAddr;
+
+    if (isFifo && regAddr.RnW == SC16IS7xx__FIFO_writeRnW)
+        S__capture('>', buf, xfer_len);                                     // before transfer, platform may overwrite buf with MISO
+    __real_spi_transferBuffer(platformSpi, addressByte, buf, xfer_len);
+    if (isFifo && regAddr.RnW == SC16IS7xx__FIFO_readRnW)
+        S__capture('<', buf, xfer_len);
+}
+
+
+/**
+ *  @brief Emit captured transfers as transcript lines and clear the log.
+ *  @param writer [in] Line writer, called once per transcript line (without line end).
+ *  @return Count of captures dropped (log full) since last flush.
+ */
+uint32_t replayRecord_flush(replayRecordWriter_func writer)
+{
+    uint16_t logIndx = 0;
+    char line[32];
+
+    while (logIndx + sizeof(recordHeader_t) <= s_logCnt)
+    {
+        recordHeader_t header;
+        memcpy(&header, s_log + logIndx, sizeof(recordHeader_t));
+        logIndx += sizeof(recordHeader_t);
+
+        if (s_lineLen > 0 && s_line[0] != header.direction)                 // direction change ends line
+            S__emitLine(writer);
+
+        if (header.direction == '>')
+        {
+            s_lastTxAt = header.timestamp;
+            s_awaitingRx = true;
+        }
+        else if (s_awaitingRx)                                              // first BGx chars after host TX: think time
+        {
+            snprintf(line, sizeof(line), "~ %lu", (unsigned long)(header.timestamp - s_lastTxAt));
+            writer(line);
+            s_awaitingRx = false;
+        }
+        S__emit(writer, header.direction, s_log + logIndx, header.dataSz);
+        logIndx += header.dataSz;
+    }
+    S__emitLine(writer);
+
+    uint32_t droppedCnt = s_droppedCnt;
+    s_logCnt = 0;
+    s_droppedCnt = 0;
+    return droppedCnt;
+}
+
+
+/**
+ *  @brief Append a FIFO transfer to the log.
+ */
+static void S__capture(char direction, const void *data, uint16_t dataSz)
+{
+    if (s_logCnt + sizeof(recordHeader_t) + dataSz > replayRecord__logSz)
+    {
+        s_droppedCnt++;
+        return;
+    }
+    recordHeader_t header = { .direction = direction, .dataSz = dataSz, .timestamp = pMillis() };
+    memcpy(s_log + s_logCnt, &header, sizeof(recordHeader_t));
+    memcpy(s_log + s_logCnt + sizeof(recordHeader_t), data, dataSz);
+    s_logCnt += sizeof(recordHeader_t) + dataSz;
+}
+
+
+/**
+ *  @brief Append transfer data to escaped transcript lines, ending lines after \n (RX) or \r (TX).
+ */
+static void S__emit(replayRecordWriter_func writer, char direction, const uint8_t *data, uint16_t dataSz)
+{
+    for (uint16_t i = 0; i < dataSz; i++)
+    {
+        if (s_lineLen == 0)
+        {
+            s_line[s_lineLen++] = direction;
+            s_line[s_lineLen++] = ' ';
+        }
+
+        uint8_t dataChar = data[i];
+        if (dataChar == '\r')
+            s_lineLen += snprintf(s_line + s_lineLen, sizeof(s_line) - s_lineLen, "\\r");
+        else if (dataChar == '\n')
+            s_lineLen += snprintf(s_line + s_lineLen, sizeof(s_line) - s_lineLen, "\\n");
+        else if (dataChar == '\\')
+            s_lineLen += snprintf(s_line + s_lineLen, sizeof(s_line) - s_lineLen, "\\\\");
+        else if (dataChar < 0x20 || dataChar > 0x7E)
+            s_lineLen += snprintf(s_line + s_lineLen, sizeof(s_line) - s_lineLen, "\\x%02X", dataChar);
+        else
+            s_line[s_lineLen++] = dataChar;
+
+        bool lineEnd = (direction == '<') ? dataChar == '\n' : dataChar == '\r';
+        if (lineEnd || s_lineLen >= sizeof(s_line) - 6)                    // room for next escaped char and terminator
+            S__emitLine(writer);
+    }
+}
+
+
+/**
+ *  @brief Write the pending transcript line, if any. A TX line without \r is continued by the next > line on replay.
+ */
+static void S__emitLine(replayRecordWriter_func writer)
+{
+    if (s_lineLen == 0)
+        return;
+    s_line[s_lineLen] = '\0';
+    writer(s_line);
+    s_lineLen = 0;
+}
@@ -0,0 +1,218 @@
+/******************************************************************************
+ *  \file replay-transcript.c
+ *  \license MIT License
+ *
+ *  Copyright (c) 2020 LooUQ Incorporated.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED
+ * "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ * LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ******************************************************************************
+ * Test 12: Host (off-target) BGx transcript replay, transcript file loader.
+ *
+ * Transcript lines (see README.md):
+ *      > AT+QIOPEN=1,0,"TCP","192.168.1.10",9011,0\r       chars expected from host
+ *      < \r\nOK\r\n                                         chars from BGx
+ *      ~ 350                                               BGx think time (ms)
+ *      # comment
+ * Escapes in > and < lines: \r \n \t \\ \xHH
+ * A > line not ending in \r is continued by a following > line (long lines).
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "replay.h"
+
+
+static replayEntry_t s_entries[replay__entriesMax];
+static uint16_t s_entryCnt = 0;
+
+static bool S__parse(FILE *transcript, const char *path);
+static int S__unescape(const char *src, char *dest, uint16_t destSz);
+
+
+/**
+ *  @brief Load and parse a transcript file.
+ */
+bool replay_load(const char *path)
+{
+    FILE *transcript = fopen(path, "r");
+    if (transcript == NULL)
+    {
+        fprintf(stderr, "replay: unable to open transcript %s\n", path);
+        return false;
+    }
+    bool loaded = S__parse(transcript, path);
+    fclose(transcript);
+    return loaded;
+}
+
+
+/**
+ *  @brief Load and parse a transcript from a string.
+ */
+bool replay_loadText(const char *text)
+{
+    FILE *transcript = fmemopen((void *)text, strlen(text), "r");
+    if (transcript == NULL)
+        return false;
+
+    bool loaded = S__parse(transcript, "(text)");
+    fclose(transcript);
+    return loaded;
+}
+
+
+/**
+ *  @brief Get the count of transcript entries loaded.
+ */
+uint16_t replay_getEntryCnt()
+{
+    return s_entryCnt;
+}
+
+
+/**
+ *  @brief Get a transcript entry.
+ */
+const replayEntry_t *replay_getEntry(uint16_t indx)
+{
+    return (indx < s_entryCnt) ? &s_entries[indx] : NULL;
+}
+
+
+/**
+ *  @brief Parse transcript lines, replacing any transcript previously loaded.
+ */
+static bool S__parse(FILE *transcript, const char *path)
+{
+    for (uint16_t i = 0; i < s_entryCnt; i++)
+        free(s_entries[i].data);
+    s_entryCnt = 0;
+
+    char line[replay__entryDataSz * 4];                                 // escaped text is up to 4 chars per data char (\xHH)
+    char data[replay__entryDataSz];
+    uint16_t lineNum = 0;
+    bool loaded = true;
+
+    while (fgets(line, sizeof(line), transcript))
+    {
+        lineNum++;
+        line[strcspn(line, "\r\n")] = '\0';                             // line ends are file format, BGx line ends are escaped
+        if (line[0] == '\0' || line[0] == '#')
+            continue;
+
+        if (s_entryCnt == replay__entriesMax)
+        {
+            fprintf(stderr, "replay: %s:%d transcript exceeds %d entries\n", path, lineNum, replay__entriesMax);
+            loaded = false;
+            break;
+        }
+
+        replayEntry_t *entry = &s_entries[s_entryCnt];
+        memset(entry, 0, sizeof(replayEntry_t));
+        entry->type = line[0];
+        entry->lineNum = lineNum;
+        const char *text = (line[1] == ' ') ? line + 2 : line + 1;     // single space separates prefix and text
+
+        if (entry->type == replayEntry_delay)
+        {
+            entry->delayMS = strtoul(text, NULL, 10);
+        }
+        else if (entry->type == replayEntry_tx || entry->type == replayEntry_rx)
+        {
+            int dataSz = S__unescape(text, data, sizeof(data));
+            if (dataSz <= 0)
+            {
+                fprintf(stderr, "replay: %s:%d empty or invalid escape\n", path, lineNum);
+                loaded = false;
+                break;
+            }
+            replayEntry_t *prevEntry = (s_entryCnt > 0) ? &s_entries[s_entryCnt - 1] : NULL;
+            if (entry->type == replayEntry_tx && prevEntry != NULL && prevEntry->type == replayEntry_tx && 
+                prevEntry->data[prevEntry->dataSz - 1] != '\r')
+            {
+                if (prevEntry->dataSz + dataSz > replay__entryDataSz)
+                {
+                    fprintf(stderr, "replay: %s:%d continued line exceeds %d chars\n", path, lineNum, replay__entryDataSz);
+                    loaded = false;
+                    break;
+                }
+                prevEntry->data = realloc(prevEntry->data, prevEntry->dataSz + dataSz);
+                memcpy(prevEntry->data + prevEntry->dataSz, data, dataSz);
+                prevEntry->dataSz += dataSz;
+                continue;                                                   // continuation of previous TX line
+            }
+            entry->dataSz = dataSz;
+            entry->data = malloc(dataSz);
+            memcpy(entry->data, data, dataSz);
+        }
+        else
+        {
+            fprintf(stderr, "replay: %s:%d unknown line type '%c'\n", path, lineNum, line[0]);
+            loaded = false;
+            break;
+        }
+        s_entryCnt++;
+    }
+    return loaded;
+}
+
+
+/**
+ *  @brief Convert escaped transcript text to data chars.
+ *  @return Count of chars in dest, -1 on invalid escape or overflow.
+ */
+static int S__unescape(const char *src, char *dest, uint16_t destSz)
+{
+    uint16_t destCnt = 0;
+
+    while (*src)
+    {
+        if (destCnt == destSz)
+            return -1;
+
+        if (*src != '\\')
+        {
+            dest[destCnt++] = *src++;
+            continue;
+        }
+        src++;
+        switch (*src)
+        {
+            case 'r':  dest[destCnt++] = '\r'; break;
+            case 'n':  dest[destCnt++] = '\n'; break;
+            case 't':  dest[destCnt++] = '\t'; break;
+            case '\\': dest[destCnt++] = '\\'; break;
+            case 'x':
+            {
+                char hex[3] = { src[1], src[2], '\0' };
+                char *endPtr;
+                long value = strtol(hex, &endPtr, 16);
+                if (endPtr != hex + 2)
+                    return -1;
+                dest[destCnt++] = (char)value;
+                src += 2;
+                break;
+            }
+            default:
+                return -1;
+        }
+        src++;
+    }
+    return destCnt;
+}
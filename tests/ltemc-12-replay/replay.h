@@ -0,0 +1,190 @@
+/******************************************************************************
+ *  \file replay.h
+ *  \license MIT License
+ *
+ *  Copyright (c) 2020 LooUQ Incorporated.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software. THE SOFTWARE IS PROVIDED
+ * "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ * LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ ******************************************************************************
+ * Test 12: Host (off-target) BGx transcript replay, shared declarations.
+ *
+ * The replay platform implements the LTEmC platform hooks (SPI, GPIO, timing)
+ * over an emulated SC16IS7xx bridge, with a scripted BGx transcript on the
+ * far side of the bridge UART. Time is virtual: it advances with SPI bus time,
+ * UART byte time and pDelay()/pYield(), so a replay is deterministic.
+ *****************************************************************************/
+
+#ifndef __LTEMC_REPLAY_H__
+#define __LTEMC_REPLAY_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+enum replay__constants
+{
+    replay__entriesMax = 512,                   // transcript entries (lines)
+    replay__entryDataSz = 1600,                 // max chars in a transcript entry after unescape (1500 byte send + command)
+    replay__txStreamSz = 2048,                  // host TX chars received by modem, not yet matched to transcript
+
+    replay__fifoSz = 64,                        // SC16IS7xx FIFO size (RX/TX)
+    replay__xtalFrequency = 7372800,            // SC16IS7xx crystal, baud = xtal / (16 * divisor)
+    replay__defaultDivisor = 4,                 // 115200 baud
+
+    replay__spiBitNS = 250,                     // 4MHz SPI clock
+    replay__spiSelectNS = 1000,                 // chip select setup/hold per SPI transaction
+    replay__yieldNS = 10000,                    // virtual time consumed by pYield()
+    replay__millisNS = 1000,                    // virtual time consumed by pMillis() (progress for polling loops)
+    replay__delayStepNS = 20000,                // pDelay() service interval
+    replay__rxTimeoutChars = 4                  // RX time-out IRQ after 4 idle char times with chars in FIFO
+};
+
+
+/**
+ *  @brief Transcript entry types, the type is the transcript line prefix character.
+ */
+typedef enum replayEntryType_tag
+{
+    replayEntry_tx = '>',                       // host to BGx, chars expected from host
+    replayEntry_rx = '<',                       // BGx to host, chars delivered at UART byte rate
+    replayEntry_delay = '~'                     // BGx think time (milliseconds) before the next entry
+} replayEntryType_t;
+
+
+/**
+ *  @brief Transcript entry, one transcript line.
+ */
+typedef struct replayEntry_tag
+{
+    replayEntryType_t type;
+    uint16_t lineNum;                           // transcript file line, for diagnostics
+    uint16_t dataSz;                            // chars in data (tx/rx)
+    uint32_t delayMS;                           // delay entry milliseconds
+    char *data;                                 // unescaped chars (tx/rx)
+} replayEntry_t;
+
+
+/**
+ *  @brief Replay counters, reset by replay_resetStats().
+ */
+typedef struct replayStats_tag
+{
+    uint64_t virtualNS;                         // virtual time elapsed
+    uint64_t spiBusyNS;                         // virtual time SPI bus was active
+    uint32_t spiWordXfers;                      // register read/write transactions
+    uint32_t spiBufferXfers;                    // FIFO block transactions
+    uint32_t spiBufferBytes;                    // chars moved by FIFO block transactions
+    uint32_t isrCnt;                            // IRQ (falling edge) dispatches
+    uint32_t isrSpiWordXfers;                   // register transactions issued from the ISR
+    uint32_t isrSpiWordMax;                     // most register transactions in a single ISR dispatch
+    uint32_t rxChars;                           // chars delivered by BGx into RX FIFO
+    uint32_t txChars;                           // chars sent by host through TX FIFO
+    uint32_t rxOverruns;                        // chars lost to a full RX FIFO (no flow control)
+    uint32_t fifoFaults;                        // FIFO reads beyond RXLVL or writes beyond TXLVL (driver fault)
+    uint32_t txMismatches;                      // host TX chars differing from transcript
+} replayStats_t;
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/* Transcript (replay-transcript.c)
+ * --------------------------------------------------------------------------------------------- */
+
+/**
+ *  @brief Load and parse a transcript file.
+ *  @param path [in] Transcript file path.
+ *  @return True if the transcript was loaded, false on file or syntax error (reported to stderr).
+ */
+bool replay_load(const char *path);
+
+/**
+ *  @brief Load and parse a transcript held in a string (same syntax as a transcript file).
+ *  @param text [in] Transcript lines.
+ *  @return True if the transcript was loaded, false on syntax error (reported to stderr).
+ */
+bool replay_loadText(const char *text);
+
+/**
+ *  @brief Get the count of transcript entries loaded.
+ */
+uint16_t replay_getEntryCnt();
+
+/**
+ *  @brief Get a transcript entry.
+ *  @param indx [in] Entry index.
+ *  @return Pointer to entry, NULL if indx out of range.
+ */
+const replayEntry_t *replay_getEntry(uint16_t indx);
+
+
+/* Bridge and player (replay-bridge.c)
+ * --------------------------------------------------------------------------------------------- */
+
+/**
+ *  @brief Set BGx auto-responder, while on (no transcript playing) each command line from host is answered with OK.
+ *  @details Used to bring LTEmC through ltem_start() without recording the start sequence in every transcript.
+ */
+void replay_setAutoOk(bool autoOk);
+
+/**
+ *  @brief Start transcript playback from the first entry.
+ */
+void replay_start();
+
+/**
+ *  @brief Test for transcript playback complete (all entries consumed and RX delivered).
+ */
+bool replay_isComplete();
+
+/**
+ *  @brief Test for transcript playback failed (host TX did not match transcript).
+ */
+bool replay_isFailed();
+
+/**
+ *  @brief Get replay counters.
+ */
+const replayStats_t *replay_getStats();
+
+/**
+ *  @brief Clear replay counters.
+ */
+void replay_resetStats();
+
+
+/* LTEmC driver (replay-driver.c)
+ * --------------------------------------------------------------------------------------------- */
+
+/**
+ *  @brief Invoke the AT commands of the loaded transcript in order (playback must be started), then wait for trailing RX.
+ *  @details Data mode payloads following a BGx prompt are sent by atcmd_stdTxDataHndlr, URCs are serviced by ltem_eventMgr().
+ *  @param failedCnt [out] Incremented for each command that did not complete with resultCode__success.
+ *  @return Count of commands invoked.
+ */
+uint16_t replay_invokeTranscript(uint16_t *failedCnt);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* !__LTEMC_REPLAY_H__ */